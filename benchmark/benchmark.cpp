@@ -1,92 +1,233 @@
 #include <benchmark/benchmark.h>
 #include "BinaryArithmetic.h"
 #include "FactorialArithmetic.h"
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <new>
 #include <random>
 #include <string>
 
 using bint = numsystem::BinaryArithmetic;
 using fint = numsystem::FactorialArithmetic;
 
-static std::string generate_large_number_string(size_t num_digits) {
-    if (num_digits == 0) return "0";
-    std::string s(num_digits, ' ');
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_int_distribution<> digit_dist(0, 9);
+// Счётчики выделений памяти: глобальные operator new/delete заменены на malloc/free со счётом
+namespace {
+    std::atomic<uint64_t> allocation_count{ 0 };
+    std::atomic<uint64_t> allocation_bytes{ 0 };
+}
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size != 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
 
-    for (size_t i = 0; i < num_digits; ++i) {
-        s[i] = (i == 0 && num_digits > 1) ? '1' + digit_dist(gen) % 9 : '0' + digit_dist(gen);
+namespace {
+    // Зерно генератора: NUMSYS_BENCHMARK_SEED или постоянное значение, чтобы прогоны были сравнимы
+    uint64_t base_seed() {
+        static const uint64_t seed = [] {
+            const char* env = std::getenv("NUMSYS_BENCHMARK_SEED");
+            return env != nullptr ? std::strtoull(env, nullptr, 10) : 0x5EEDULL;
+        }();
+        return seed;
+    }
+    // Зерно сохраняется в контексте JSON, чтобы сравнение с базовым прогоном могло его проверить
+    const bool seed_context = (benchmark::AddCustomContext("numsys_seed", std::to_string(base_seed())), true);
+
+    // Операнд зависит только от зерна, числа цифр и номера операнда, а не от порядка запуска
+    std::string generate_large_number_string(size_t num_digits, uint64_t stream) {
+        if (num_digits == 0) return "0";
+        std::mt19937_64 gen(base_seed() ^ (num_digits * 0x9E3779B97F4A7C15ULL) ^ (stream << 48));
+        std::uniform_int_distribution<int> digit_dist(0, 9);
+        std::string s(num_digits, '0');
+        for (size_t i = 0; i < num_digits; ++i) {
+            s[i] = static_cast<char>('0' + digit_dist(gen));
+        }
+        if (num_digits > 1 && s[0] == '0') s[0] = '1';
+        return s;
+    }
+    template <typename T>
+    T operand(size_t num_digits, uint64_t stream) {
+        return T(generate_large_number_string(num_digits, stream));
+    }
+    // Делитель: однозначный операнд может оказаться нулём, тогда берётся 1
+    template <typename T>
+    T divisor(size_t num_digits, uint64_t stream) {
+        const T b = operand<T>(num_digits, stream);
+        return b == T(0) ? T(1) : b;
+    }
+
+    // Выделения памяти внутри цикла замера: число и байты на одну итерацию
+    class AllocationScope {
+    public:
+        explicit AllocationScope(benchmark::State& state) : _state(state),
+            _count(allocation_count.load(std::memory_order_relaxed)), _bytes(allocation_bytes.load(std::memory_order_relaxed)) {}
+        ~AllocationScope() {
+            const double count = static_cast<double>(allocation_count.load(std::memory_order_relaxed) - _count);
+            const double bytes = static_cast<double>(allocation_bytes.load(std::memory_order_relaxed) - _bytes);
+            _state.counters["allocs_per_op"] = benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+            _state.counters["bytes_per_op"] = benchmark::Counter(bytes, benchmark::Counter::kAvgIterations);
+        }
+    private:
+        benchmark::State& _state;
+        uint64_t _count;
+        uint64_t _bytes;
+    };
+
+    // Цикл замера со счётчиками выделений и сложностью по числу цифр
+    template <typename Body>
+    void measure(benchmark::State& state, Body&& body) {
+        {
+            AllocationScope scope(state);
+            for (auto _ : state) body();
+        }
+        state.SetComplexityN(state.range(0));
     }
-    return s;
 }
 
-//   : Add, Sub, Mul, Div, Mod   
+// Бинарные операции над операндами одинаковой длины
 template <typename T>
 static void BM_Add(benchmark::State& state) {
-    const size_t n = state.range(0);
-    T a(generate_large_number_string(n));
-    T b(generate_large_number_string(n));
-    for (auto _ : state) benchmark::DoNotOptimize(a + b);
-    state.SetComplexityN(n);
+    const T a = operand<T>(state.range(0), 0), b = operand<T>(state.range(0), 1);
+    measure(state, [&] { benchmark::DoNotOptimize(a + b); });
 }
 
 template <typename T>
 static void BM_Sub(benchmark::State& state) {
-    const size_t n = state.range(0);
-    T a(generate_large_number_string(n));
-    T b(generate_large_number_string(n));
-    for (auto _ : state) benchmark::DoNotOptimize(a - b);
-    state.SetComplexityN(n);
+    const T a = operand<T>(state.range(0), 0), b = operand<T>(state.range(0), 1);
+    measure(state, [&] { benchmark::DoNotOptimize(a - b); });
 }
 
 template <typename T>
 static void BM_Mul(benchmark::State& state) {
-    const size_t n = state.range(0);
-    T a(generate_large_number_string(n));
-    T b(generate_large_number_string(n));
-    for (auto _ : state) benchmark::DoNotOptimize(a * b);
-    state.SetComplexityN(n);
+    const T a = operand<T>(state.range(0), 0), b = operand<T>(state.range(0), 1);
+    measure(state, [&] { benchmark::DoNotOptimize(a * b); });
 }
 
 template <typename T>
 static void BM_Div(benchmark::State& state) {
-    const size_t n = state.range(0);
-    T a(generate_large_number_string(n));
-    T b(generate_large_number_string(n));
-    if (b == T(0)) b = T("1");
-    for (auto _ : state) benchmark::DoNotOptimize(a / b);
-    state.SetComplexityN(n);
+    const T a = operand<T>(state.range(0), 0), b = divisor<T>(state.range(0), 1);
+    measure(state, [&] { benchmark::DoNotOptimize(a / b); });
 }
 
 template <typename T>
 static void BM_Mod(benchmark::State& state) {
-    const size_t n = state.range(0);
-    T a(generate_large_number_string(n));
-    T b(generate_large_number_string(n));
-    if (b == T(0)) b = T("1");
-    for (auto _ : state) benchmark::DoNotOptimize(a % b);
-    state.SetComplexityN(n);
+    const T a = operand<T>(state.range(0), 0), b = divisor<T>(state.range(0), 1);
+    measure(state, [&] { benchmark::DoNotOptimize(a % b); });
 }
 
 template <typename T>
 static void BM_Comparison(benchmark::State& state) {
-    const size_t n = state.range(0);
-    T a(generate_large_number_string(n));
-    T b(generate_large_number_string(n));
-    for (auto _ : state) {
+    const T a = operand<T>(state.range(0), 0), b = operand<T>(state.range(0), 1);
+    measure(state, [&] {
         benchmark::DoNotOptimize(a < b);
         benchmark::DoNotOptimize(a == b);
         benchmark::DoNotOptimize(a > b);
-    }
-    state.SetComplexityN(n);
+    });
+}
+
+// Операнды разной длины: второй в UNBALANCED раз короче первого
+constexpr size_t UNBALANCED = 8;
+
+template <typename T>
+static void BM_MulUnbalanced(benchmark::State& state) {
+    const T a = operand<T>(state.range(0), 0), b = operand<T>(std::max<size_t>(state.range(0) / UNBALANCED, 1), 1);
+    measure(state, [&] { benchmark::DoNotOptimize(a * b); });
+}
+
+template <typename T>
+static void BM_DivUnbalanced(benchmark::State& state) {
+    const T a = operand<T>(state.range(0), 0), b = divisor<T>(std::max<size_t>(state.range(0) / UNBALANCED, 1), 1);
+    measure(state, [&] { benchmark::DoNotOptimize(a / b); });
+}
+
+// Операции с машинным целым справа
+constexpr int64_t SCALAR = 1000000007;
+
+template <typename T>
+static void BM_AddScalar(benchmark::State& state) {
+    const T a = operand<T>(state.range(0), 0);
+    measure(state, [&] { benchmark::DoNotOptimize(a + SCALAR); });
+}
+
+template <typename T>
+static void BM_MulScalar(benchmark::State& state) {
+    const T a = operand<T>(state.range(0), 0);
+    measure(state, [&] { benchmark::DoNotOptimize(a * SCALAR); });
+}
+
+template <typename T>
+static void BM_DivScalar(benchmark::State& state) {
+    const T a = operand<T>(state.range(0), 0);
+    measure(state, [&] { benchmark::DoNotOptimize(a / SCALAR); });
+}
+
+template <typename T>
+static void BM_ModScalar(benchmark::State& state) {
+    const T a = operand<T>(state.range(0), 0);
+    measure(state, [&] { benchmark::DoNotOptimize(a % SCALAR); });
+}
+
+template <typename T>
+static void BM_Increment(benchmark::State& state) {
+    T a = operand<T>(state.range(0), 0);
+    measure(state, [&] { benchmark::DoNotOptimize(++a); });
+}
+
+// Преобразования: разбор строки, вывод в строку, построение из машинного целого
+template <typename T>
+static void BM_Parse(benchmark::State& state) {
+    const std::string s = generate_large_number_string(state.range(0), 0);
+    measure(state, [&] { benchmark::DoNotOptimize(T(s)); });
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * s.size()));
+}
+
+template <typename T>
+static void BM_ToString(benchmark::State& state) {
+    const T a = operand<T>(state.range(0), 0);
+    measure(state, [&] { benchmark::DoNotOptimize(to_string(a)); });
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * state.range(0)));
+}
+
+template <typename T>
+static void BM_FromInt(benchmark::State& state) {
+    int64_t value = -static_cast<int64_t>(base_seed() % 1000000007);
+    measure(state, [&] { benchmark::DoNotOptimize(T(value)); ++value; });
+}
+
+// Степень и корень; у Pow основание 3 и показатель, дающий результат из range(0) цифр
+template <typename T>
+static void BM_Pow(benchmark::State& state) {
+    const T base(3);
+    const unsigned exp = static_cast<unsigned>(std::max(1.0, static_cast<double>(state.range(0)) / std::log10(3.0)));
+    measure(state, [&] { benchmark::DoNotOptimize(pow(base, exp)); });
+}
+
+template <typename T>
+static void BM_Sqrt(benchmark::State& state) {
+    const T a = operand<T>(state.range(0), 0);
+    measure(state, [&] { benchmark::DoNotOptimize(sqrt(a)); });
 }
 
 
 #define REGISTER_OP(Type, Func, NameStr, Min, Max) \
     BENCHMARK_TEMPLATE(Func, Type)->Name(NameStr)->RangeMultiplier(2)->Range(Min, Max)->MinTime(0.01)->Complexity()
+// Большие размеры: шаг x10, чтобы диапазон до 10^6 цифр проходился за разумное время
+#define REGISTER_OP_LARGE(Type, Func, NameStr, Min, Max) \
+    BENCHMARK_TEMPLATE(Func, Type)->Name(NameStr)->RangeMultiplier(10)->Range(Min, Max)->Iterations(1)->Complexity()
+#define REGISTER_FROM_INT(Type, NameStr) \
+    BENCHMARK_TEMPLATE(BM_FromInt, Type)->Name(NameStr)->Arg(19)->MinTime(0.01)
 
 constexpr int MIN_RANGE_BENCHMARK = 10;
 constexpr int MAX_RANGE_BENCHMARK = 500;
+constexpr int MIN_RANGE_LARGE = 1000;
+constexpr int MAX_RANGE_BINARY_LARGE = 1000000;
+constexpr int MAX_RANGE_BINARY_SQRT_LARGE = 100000;
+constexpr int MAX_RANGE_FACTORIAL_LARGE = 10000;
 
 // Binary arithmetic
 REGISTER_OP(bint, BM_Add, "Binary-Add", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
@@ -95,6 +236,18 @@ REGISTER_OP(bint, BM_Mul, "Binary-Mul", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK
 REGISTER_OP(bint, BM_Div, "Binary-Div", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
 REGISTER_OP(bint, BM_Mod, "Binary-Mod", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
 REGISTER_OP(bint, BM_Comparison, "Binary-Comparison", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_MulUnbalanced, "Binary-MulUnbalanced", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_DivUnbalanced, "Binary-DivUnbalanced", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_AddScalar, "Binary-AddScalar", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_MulScalar, "Binary-MulScalar", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_DivScalar, "Binary-DivScalar", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_ModScalar, "Binary-ModScalar", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_Increment, "Binary-Increment", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_Parse, "Binary-Parse", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_ToString, "Binary-ToString", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_Pow, "Binary-Pow", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(bint, BM_Sqrt, "Binary-Sqrt", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_FROM_INT(bint, "Binary-FromInt");
 
 // Factorial arithmetic
 REGISTER_OP(fint, BM_Add, "Factorial-Add", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
@@ -103,5 +256,26 @@ REGISTER_OP(fint, BM_Mul, "Factorial-Mul", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHM
 REGISTER_OP(fint, BM_Div, "Factorial-Div", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
 REGISTER_OP(fint, BM_Mod, "Factorial-Mod", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
 REGISTER_OP(fint, BM_Comparison, "Factorial-Comparison", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_MulUnbalanced, "Factorial-MulUnbalanced", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_DivUnbalanced, "Factorial-DivUnbalanced", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_AddScalar, "Factorial-AddScalar", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_MulScalar, "Factorial-MulScalar", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_DivScalar, "Factorial-DivScalar", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_ModScalar, "Factorial-ModScalar", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_Increment, "Factorial-Increment", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_Parse, "Factorial-Parse", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_ToString, "Factorial-ToString", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_Pow, "Factorial-Pow", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_OP(fint, BM_Sqrt, "Factorial-Sqrt", MIN_RANGE_BENCHMARK, MAX_RANGE_BENCHMARK);
+REGISTER_FROM_INT(fint, "Factorial-FromInt");
 
-
+// Большие числа (отбираются фильтром --benchmark_filter=Large)
+REGISTER_OP_LARGE(bint, BM_Mul, "Binary-LargeMul", MIN_RANGE_LARGE, MAX_RANGE_BINARY_LARGE);
+REGISTER_OP_LARGE(bint, BM_Div, "Binary-LargeDiv", MIN_RANGE_LARGE, MAX_RANGE_BINARY_LARGE);
+REGISTER_OP_LARGE(bint, BM_MulUnbalanced, "Binary-LargeMulUnbalanced", MIN_RANGE_LARGE, MAX_RANGE_BINARY_LARGE);
+REGISTER_OP_LARGE(bint, BM_Parse, "Binary-LargeParse", MIN_RANGE_LARGE, MAX_RANGE_BINARY_LARGE);
+REGISTER_OP_LARGE(bint, BM_ToString, "Binary-LargeToString", MIN_RANGE_LARGE, MAX_RANGE_BINARY_LARGE);
+REGISTER_OP_LARGE(bint, BM_Sqrt, "Binary-LargeSqrt", MIN_RANGE_LARGE, MAX_RANGE_BINARY_SQRT_LARGE);
+REGISTER_OP_LARGE(fint, BM_Mul, "Factorial-LargeMul", MIN_RANGE_LARGE, MAX_RANGE_FACTORIAL_LARGE);
+REGISTER_OP_LARGE(fint, BM_Parse, "Factorial-LargeParse", MIN_RANGE_LARGE, MAX_RANGE_FACTORIAL_LARGE);
+REGISTER_OP_LARGE(fint, BM_ToString, "Factorial-LargeToString", MIN_RANGE_LARGE, MAX_RANGE_FACTORIAL_LARGE);
@@ -3,16 +3,46 @@
 
 namespace numsystem {
 
-    class BinaryArithmetic : public IntegralBase<BinaryArithmetic> {
+    template<typename Limb>
+    class BasicBinaryArithmetic;
+
+    template<typename Limb>
+    std::string to_string(const BasicBinaryArithmetic<Limb>& other);
+
+    template<typename Limb>
+    BasicBinaryArithmetic<Limb> gcd(const BasicBinaryArithmetic<Limb>& a, const BasicBinaryArithmetic<Limb>& b);
+
+    template<typename Limb>
+    class BasicModContext;
+
+    class BinaryArithmeticBatch;
+
+    template<size_t Bits>
+    class FixedBinary;
+
+    namespace impl {
+        struct SerializationAccess;
+    }
+
+    // Limb — тип слова хранилища: uint8_t, uint16_t, uint32_t или uint64_t.
+    // Реализация инстанцируется в BinaryArithmetic.cpp только для этих типов.
+    // Потоки: константный доступ к одному значению (копирование, сравнение, арифметика,
+    // to_string) безопасен из любого числа потоков; изменение значения одновременно с любым
+    // другим доступом к нему — гонка. Копии независимы, в том числе после share().
+    template<typename Limb>
+    class BasicBinaryArithmetic : public IntegralBase<BasicBinaryArithmetic<Limb>> {
+        static_assert(std::is_unsigned_v<Limb> && !std::is_same_v<Limb, bool>, "Limb must be an unsigned integral type");
     public:
+        using limb_type = Limb;
+
         // --- Конструкторы ---
-        constexpr BinaryArithmetic() : _storage() {}
-        BinaryArithmetic(const char* value) : BinaryArithmetic(std::string_view(value)) {}
-        BinaryArithmetic(std::string_view value);
+        BasicBinaryArithmetic() : _storage() {}
+        BasicBinaryArithmetic(const char* value) : BasicBinaryArithmetic(std::string_view(value)) {}
+        BasicBinaryArithmetic(std::string_view value);
 
         // --- Неявный конструктор из целого (для операций +int и т.д.) ---
         template<typename _Ty, typename = std::enable_if_t<std::is_integral<_Ty>::value && !std::is_same_v<_Ty, bool>>>
-        constexpr BinaryArithmetic(_Ty value) noexcept {
+        constexpr BasicBinaryArithmetic(_Ty value) noexcept {
             sign((value < 0));
             if (value == 0) {
                 // Явно гарантируем, что sign = false для нуля:
@@ -23,12 +53,20 @@ namespace numsystem {
 
             _storage.clear();
             using UnsignedTy = std::make_unsigned_t<_Ty>;
-            UnsignedTy abs_value = static_cast<UnsignedTy>(_storage.sign() ? -value : value);
+            // Модуль считаем в беззнаковом типе, чтобы не переполнить min() знакового
+            UnsignedTy abs_value = _storage.sign()
+                ? static_cast<UnsignedTy>(UnsignedTy(0) - static_cast<UnsignedTy>(value))
+                : static_cast<UnsignedTy>(value);
 
             while (abs_value != 0) {
                 value_type raw_word = static_cast<value_type>(abs_value & _storage.MAX_VALUE);
                 _storage.push_back(raw_word);
-                abs_value >>= _storage.VALUE_COUNT_BIT;
+                if constexpr (std::numeric_limits<UnsignedTy>::digits > impl::Storage<value_type>::VALUE_COUNT_BIT) {
+                    abs_value >>= _storage.VALUE_COUNT_BIT;
+                }
+                else {
+                    abs_value = 0;
+                }
             }
 
             // Убираем любые ведущие нули (и, если все слова были нулями,
@@ -47,8 +85,7 @@ namespace numsystem {
             // Максимальное количество бит в _Ty
             // Проверка, что число не занимает больше бит, чем _Ty
             const size_t max_bits = sizeof(_Ty) * 8;
-            size_t total_bits = _storage.size() * _storage.VALUE_COUNT_BIT;
-            if (total_bits > max_bits) {
+            if (bit_length() > max_bits) {
                 throw std::overflow_error("Value exceeds the bit width of the target integral type");
             }
 
@@ -65,38 +102,181 @@ namespace numsystem {
                 return static_cast<_Ty>(result);
             }
             else {
-                using Signed64 = std::make_signed_t<decltype(result)>;
-                Signed64 signed_val = static_cast<Signed64>(result);
-                if (_storage.sign()) signed_val = -signed_val;
-                return static_cast<_Ty>(signed_val);
+                // Отрицание в беззнаковом типе, чтобы не переполнить min()
+                if (_storage.sign()) result = uint64_t(0) - result;
+                return static_cast<_Ty>(static_cast<std::make_signed_t<uint64_t>>(result));
             }
         }
 
         template<typename _Ty, typename = std::enable_if_t<std::is_integral<_Ty>::value>>
-        BinaryArithmetic& operator=(_Ty value) {
-            *this = BinaryArithmetic(value);
+        BasicBinaryArithmetic& operator=(_Ty value) {
+            *this = BasicBinaryArithmetic(value);
+            return *this;
+        }
+
+        /**
+         * \~english
+         * @brief Number with magnitude `limbs` (least significant first, leading zero words allowed) and the given sign.
+         *
+         * The words are copied in one pass with no decimal conversion; with 64-bit limbs this is the
+         * layout of GMP's `mpz_limbs_read` on 64-bit targets.
+         * \~russian
+         * @brief Число с модулем `limbs` (младшее слово первым, ведущие нулевые слова допустимы) и заданным знаком.
+         *
+         * Слова копируются за один проход без десятичного преобразования; для 64-битных слов это
+         * раскладка `mpz_limbs_read` из GMP на 64-битных платформах.
+         */
+        [[nodiscard]] static BasicBinaryArithmetic from_limbs(ConstSpan<limb_type> limbs, bool negative = false);
+        /// \~english @brief The magnitude words in place, least significant first, without leading zero words (empty for zero).
+        /// \~russian @brief Слова модуля на месте, младшее первым, без ведущих нулевых слов (пусто для нуля).
+        [[nodiscard]] ConstSpan<limb_type> limbs() const noexcept {
+            // Хранилище нормализовано: ноль — единственное нулевое слово
+            return { _storage.data().data(), (_storage.empty() || _storage.back() == 0) ? 0 : _storage.size() };
+        }
+
+        /**
+         * \~english
+         * @brief Makes copies of this value O(1): the limbs move to an immutable block with an atomic reference count.
+         *
+         * Every copy (this value included) copies the limbs on its first modification; reading never does,
+         * so a shared constant may be copied and read from many threads without locks. Values that fit
+         * the inline buffer stay as they are.
+         * \~russian
+         * @brief Делает копирование этого значения O(1): слова переносятся в неизменяемый блок с атомарным счётчиком ссылок.
+         *
+         * Любая копия (и само значение) копирует слова при первом изменении; чтение этого не делает,
+         * поэтому общую константу можно копировать и читать из многих потоков без блокировок. Значения,
+         * помещающиеся во встроенный буфер, остаются как есть.
+         */
+        BasicBinaryArithmetic& share() {
+            _storage.share();
             return *this;
         }
+        /// \~english @brief Checks whether the limbs live in a shared block (see `share()`).
+        /// \~russian @brief Проверяет, лежат ли слова в общем блоке (см. `share()`).
+        [[nodiscard]] bool is_shared() const noexcept { return _storage.shared(); }
 
-        [[nodiscard]] int compare(const BinaryArithmetic& other) const noexcept;
-        [[nodiscard]] BinaryArithmetic add(const BinaryArithmetic& other) const;
-        [[nodiscard]] BinaryArithmetic divide(const BinaryArithmetic& other) const;
-        [[nodiscard]] BinaryArithmetic modulo(const BinaryArithmetic& other) const;
-        [[nodiscard]] BinaryArithmetic subtract(const BinaryArithmetic& other) const;
-        [[nodiscard]] BinaryArithmetic multiply(const BinaryArithmetic& other) const;
+        [[nodiscard]] int compare(const BasicBinaryArithmetic& other) const noexcept;
+        [[nodiscard]] BasicBinaryArithmetic add(const BasicBinaryArithmetic& other) const;
+        [[nodiscard]] BasicBinaryArithmetic divide(const BasicBinaryArithmetic& other) const;
+        [[nodiscard]] BasicBinaryArithmetic modulo(const BasicBinaryArithmetic& other) const;
+        [[nodiscard]] BasicBinaryArithmetic subtract(const BasicBinaryArithmetic& other) const;
+        [[nodiscard]] BasicBinaryArithmetic multiply(const BasicBinaryArithmetic& other) const;
+        // Частное и остаток за один проход деления (алгоритм D Кнута)
+        [[nodiscard]] std::pair<BasicBinaryArithmetic, BasicBinaryArithmetic> divmod(const BasicBinaryArithmetic& other) const;
+        // Операции на месте со знаком: переиспользуют память текущего хранилища
+        void add_assign(const BasicBinaryArithmetic& other);
+        void subtract_assign(const BasicBinaryArithmetic& other);
+        void multiply_assign(const BasicBinaryArithmetic& other);
+        // *this = lhs * rhs прямо в текущее хранилище (его ёмкость переиспользуется); *this может совпадать с операндом
+        void multiply_into(const BasicBinaryArithmetic& lhs, const BasicBinaryArithmetic& rhs);
+        // Сдвиги на месте: влево — умножение на 2^bits, вправо — деление на 2^bits с округлением вниз
+        // (как арифметический сдвиг: -5 >> 1 == -3)
+        void shift_left_assign(size_t bits);
+        void shift_right_assign(size_t bits);
 
+        // Смешанная арифметика с 64-битным скаляром без временного числа.
+        // negative — знак скаляра (модуль передаётся в value / divisor)
+        void add_small(uint64_t value, bool negative = false);
+        void mul_small(uint64_t value, bool negative = false);
+        // *this /= ±divisor с усечением к нулю, возвращает модуль остатка
+        uint64_t divmod_small(uint64_t divisor, bool negative = false);
+        // Модуль остатка |*this| % divisor
+        [[nodiscard]] uint64_t mod_small(uint64_t divisor) const;
+
+        // Побитовые операции в семантике бесконечного дополнительного кода: -1 — все единицы,
+        // ~x == -x - 1, x & -x — младший единичный бит
+        void bit_and_assign(const BasicBinaryArithmetic& other);
+        void bit_or_assign(const BasicBinaryArithmetic& other);
+        void bit_xor_assign(const BasicBinaryArithmetic& other);
+
+        // Число значащих бит модуля (0 для нуля)
+        [[nodiscard]] size_t bit_length() const noexcept;
+        // Число единичных бит модуля
+        [[nodiscard]] size_t popcount() const noexcept;
+        // Число младших нулевых бит (одинаково для x и -x, 0 для нуля)
+        [[nodiscard]] size_t countr_zero() const noexcept;
+        // Бит с номером index в дополнительном коде (у отрицательных старшие биты — единицы)
+        [[nodiscard]] bool test_bit(size_t index) const noexcept;
+
+        BasicBinaryArithmetic& operator&=(const BasicBinaryArithmetic& other) { bit_and_assign(other); return *this; }
+        BasicBinaryArithmetic& operator|=(const BasicBinaryArithmetic& other) { bit_or_assign(other); return *this; }
+        BasicBinaryArithmetic& operator^=(const BasicBinaryArithmetic& other) { bit_xor_assign(other); return *this; }
+        [[nodiscard]] friend BasicBinaryArithmetic operator&(BasicBinaryArithmetic lhs, const BasicBinaryArithmetic& rhs) {
+            lhs.bit_and_assign(rhs);
+            return lhs;
+        }
+        [[nodiscard]] friend BasicBinaryArithmetic operator|(BasicBinaryArithmetic lhs, const BasicBinaryArithmetic& rhs) {
+            lhs.bit_or_assign(rhs);
+            return lhs;
+        }
+        [[nodiscard]] friend BasicBinaryArithmetic operator^(BasicBinaryArithmetic lhs, const BasicBinaryArithmetic& rhs) {
+            lhs.bit_xor_assign(rhs);
+            return lhs;
+        }
+        [[nodiscard]] BasicBinaryArithmetic operator~() const {
+            BasicBinaryArithmetic result(*this);
+            result.add_assign(BasicBinaryArithmetic(1));
+            result.sign(!result.sign() && !result.is_zero());
+            return result;
+        }
+
+        BasicBinaryArithmetic& operator<<=(size_t bits) { shift_left_assign(bits); return *this; }
+        BasicBinaryArithmetic& operator>>=(size_t bits) { shift_right_assign(bits); return *this; }
+        [[nodiscard]] friend BasicBinaryArithmetic operator<<(BasicBinaryArithmetic lhs, size_t bits) {
+            lhs.shift_left_assign(bits);
+            return lhs;
+        }
+        [[nodiscard]] friend BasicBinaryArithmetic operator>>(BasicBinaryArithmetic lhs, size_t bits) {
+            lhs.shift_right_assign(bits);
+            return lhs;
+        }
 
         inline void sign(bool s) noexcept { _storage.sign(s); }
         [[nodiscard]] inline bool sign() const noexcept { return _storage.sign(); }
         [[nodiscard]] inline explicit operator bool() const noexcept { return !this->is_zero(); }
-        friend std::string to_string(const BinaryArithmetic& other);
+        template<typename _Limb>
+        friend std::string to_string(const BasicBinaryArithmetic<_Limb>& other);
+        // Наибольший общий делитель модулей (бинарный алгоритм Стейна), gcd(0, 0) == 0
+        template<typename _Limb>
+        friend BasicBinaryArithmetic<_Limb> gcd(const BasicBinaryArithmetic<_Limb>& a, const BasicBinaryArithmetic<_Limb>& b);
+        // Модульная арифметика работает прямо со словами хранилища
+        template<typename _Limb>
+        friend class BasicModContext;
+        // Набор фиксированной ширины переносит слова в хранилище и обратно без промежуточных копий
+        friend class BinaryArithmeticBatch;
+        // Преобразование в тип фиксированной ширины и обратно копирует слова напрямую
+        template<size_t Bits>
+        friend class FixedBinary;
+        // Сериализация и BinaryArithmeticView копируют слова хранилища напрямую
+        friend struct impl::SerializationAccess;
     private:
-        using value_type = uint8_t;
+        using value_type = Limb;
         impl::Storage<value_type> _storage;
         bool is_zero() const noexcept;           // тут просто проверка «весь вектор == {0}»
         void trim_leading_zeros() noexcept;      // тут реальное pop_back, убирающее лишние нули
+        void add_signed(const BasicBinaryArithmetic& other, bool other_sign);  // *this += (other_sign ? -|other| : |other|)
+        void add_limbs(const value_type* rhs, size_t rhs_size, bool rhs_sign);  // то же для сырого массива слов
+        template<typename Op>
+        void bitwise_assign(const BasicBinaryArithmetic& other);
     };
 
+    // По умолчанию — 64-битные слова с 128-битными промежуточными произведениями
+    using BinaryArithmetic = BasicBinaryArithmetic<uint64_t>;
+
+    extern template class BasicBinaryArithmetic<uint8_t>;
+    extern template class BasicBinaryArithmetic<uint16_t>;
+    extern template class BasicBinaryArithmetic<uint32_t>;
+    extern template class BasicBinaryArithmetic<uint64_t>;
+
+    extern template std::string to_string(const BasicBinaryArithmetic<uint8_t>&);
+    extern template std::string to_string(const BasicBinaryArithmetic<uint16_t>&);
+    extern template std::string to_string(const BasicBinaryArithmetic<uint32_t>&);
+    extern template std::string to_string(const BasicBinaryArithmetic<uint64_t>&);
 
+    extern template BasicBinaryArithmetic<uint8_t> gcd(const BasicBinaryArithmetic<uint8_t>&, const BasicBinaryArithmetic<uint8_t>&);
+    extern template BasicBinaryArithmetic<uint16_t> gcd(const BasicBinaryArithmetic<uint16_t>&, const BasicBinaryArithmetic<uint16_t>&);
+    extern template BasicBinaryArithmetic<uint32_t> gcd(const BasicBinaryArithmetic<uint32_t>&, const BasicBinaryArithmetic<uint32_t>&);
+    extern template BasicBinaryArithmetic<uint64_t> gcd(const BasicBinaryArithmetic<uint64_t>&, const BasicBinaryArithmetic<uint64_t>&);
 
 }
\ No newline at end of file
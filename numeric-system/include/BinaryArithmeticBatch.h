@@ -0,0 +1,65 @@
+﻿#pragma once
+#include "BinaryArithmetic.h"
+
+namespace numsystem {
+    /**
+     * \~english
+     * @brief A batch of `size()` fixed-width signed integers stored as a structure of arrays.
+     *
+     * Every element has `bits()` bits (a multiple of 64) in two's complement and wraps around on
+     * overflow like a machine integer. Limb `j` of element `i` is stored at `j * size() + i`, so the
+     * kernels walk one limb of many elements at a time: the carry chains of neighbouring elements
+     * are independent and the inner loops compile to SIMD lanes instead of one carry chain per number.
+     * No element owns an allocation; the whole batch is one contiguous block.
+     * \~russian
+     * @brief Набор из `size()` знаковых целых фиксированной ширины в виде «структуры массивов».
+     *
+     * Каждый элемент занимает `bits()` бит (кратно 64) в дополнительном коде и при переполнении
+     * переходит через границу, как машинное целое. Слово `j` элемента `i` лежит по индексу `j * size() + i`,
+     * поэтому ядра обходят одно слово у многих элементов сразу: цепочки переносов соседних элементов
+     * независимы, и внутренние циклы компилируются в SIMD-полосы, а не в цепочку переносов на каждое число.
+     * Элементы не владеют памятью: весь набор — один непрерывный блок.
+     */
+    class BinaryArithmeticBatch {
+    public:
+        using value_type = uint64_t;
+
+        /// \~english @brief `count` zeros of `bits` bits each (rounded up to a multiple of 64, at least 64).
+        /// \~russian @brief `count` нулей по `bits` бит (с округлением вверх до кратного 64, не меньше 64).
+        BinaryArithmeticBatch(size_t count, size_t bits);
+
+        /// \~english @brief Number of elements.
+        /// \~russian @brief Число элементов.
+        [[nodiscard]] size_t size() const noexcept { return _count; }
+        /// \~english @brief Width of one element in bits.
+        /// \~russian @brief Ширина одного элемента в битах.
+        [[nodiscard]] size_t bits() const noexcept { return _limbs * std::numeric_limits<value_type>::digits; }
+
+        /// \~english @brief Stores `value` as element `index`. @throws std::overflow_error if it does not fit into `bits()` signed bits.
+        /// \~russian @brief Записывает `value` в элемент `index`. @throws std::overflow_error Если значение не помещается в `bits()` знаковых бит.
+        void set(size_t index, const BinaryArithmetic& value);
+        /// \~english @brief Element `index` as a dynamic number.
+        /// \~russian @brief Элемент `index` в виде динамического числа.
+        [[nodiscard]] BinaryArithmetic get(size_t index) const;
+
+        /// \~english @brief `this[i] += other[i]` modulo `2^bits()`. @throws std::invalid_argument if the shapes differ.
+        /// \~russian @brief `this[i] += other[i]` по модулю `2^bits()`. @throws std::invalid_argument Если размеры наборов различаются.
+        void add(const BinaryArithmeticBatch& other);
+        /// \~english @brief `this[i] -= other[i]` modulo `2^bits()`. @throws std::invalid_argument if the shapes differ.
+        /// \~russian @brief `this[i] -= other[i]` по модулю `2^bits()`. @throws std::invalid_argument Если размеры наборов различаются.
+        void sub(const BinaryArithmeticBatch& other);
+        /// \~english @brief `this[i] *= factor` modulo `2^bits()`.
+        /// \~russian @brief `this[i] *= factor` по модулю `2^bits()`.
+        void mul_small(uint64_t factor) noexcept;
+        /// \~english @brief Writes the sign of `this[i] - other[i]` (-1, 0 or 1) to `result[i]`. @throws std::invalid_argument if the shapes differ.
+        /// \~russian @brief Записывает знак `this[i] - other[i]` (-1, 0 или 1) в `result[i]`. @throws std::invalid_argument Если размеры наборов различаются.
+        void compare(const BinaryArithmeticBatch& other, int* result) const;
+
+    private:
+        size_t _count;
+        size_t _limbs;
+        std::vector<value_type> _data;      // _data[j * _count + i] — слово j элемента i
+
+        void check_shape(const BinaryArithmeticBatch& other) const;
+    };
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \~english
+ * @brief Enables runtime selection of CPU-specific limb kernels (`0` — always the portable loops).
+ *
+ * Set with the CMake option `NUMSYS_RUNTIME_DISPATCH=OFF` (or `-DNUMSYS_RUNTIME_DISPATCH=0`) to disable.
+ * Dispatch also needs `__builtin_is_constant_evaluated` (GCC 9, Clang 9, MSVC 19.25 and newer) so that
+ * the kernels stay usable in constant expressions; older compilers get the portable loops only.
+ * \~russian
+ * @brief Включает выбор ядер над словами под процессор во время выполнения (`0` — всегда переносимые циклы).
+ *
+ * Выключается опцией CMake `NUMSYS_RUNTIME_DISPATCH=OFF` (или `-DNUMSYS_RUNTIME_DISPATCH=0`).
+ * Выбору также нужен `__builtin_is_constant_evaluated` (GCC 9, Clang 9, MSVC 19.25 и новее), чтобы ядра
+ * оставались доступны в константных выражениях; более старые компиляторы получают только переносимые циклы.
+ */
+#ifndef NUMSYS_RUNTIME_DISPATCH
+#define NUMSYS_RUNTIME_DISPATCH 1
+#endif
+
+#if NUMSYS_RUNTIME_DISPATCH && (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+#define NUMSYS_DISPATCH_ENABLED 1
+#define NUMSYS_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#define NUMSYS_DISPATCH_ENABLED 0
+#define NUMSYS_IS_CONSTANT_EVALUATED() true
+#endif
+
+namespace numsystem {
+    /**
+     * \~english
+     * @brief Set of 64-bit limb kernels (`add_n`, `sub_n`, `mul_1`, `addmul_1`, `submul_1`) in use.
+     * \~russian
+     * @brief Набор ядер над 64-битными словами (`add_n`, `sub_n`, `mul_1`, `addmul_1`, `submul_1`).
+     */
+    enum class KernelSet : uint8_t {
+        Portable,       ///< \~english Portable loops with carries from comparisons \~russian Переносимые циклы с переносами через сравнения
+        Int128,         ///< \~english Compiler 128-bit sums and products (AArch64, other GCC and Clang targets) \~russian 128-битные суммы и произведения компилятора (AArch64, прочие цели GCC и Clang)
+        X86Bmi2,        ///< \~english Unrolled `adc` chains and `mulx` products (x86-64 with BMI2, GCC and Clang) \~russian Развёрнутые цепочки `adc` и произведения `mulx` (x86-64 с BMI2, GCC и Clang)
+        Count
+    };
+
+    /// \~english @brief Kernel set used by the arithmetic now.
+    /// \~russian @brief Набор ядер, которым сейчас пользуется арифметика.
+    [[nodiscard]] KernelSet active_kernel_set() noexcept;
+    /// \~english @brief Whether `set` was compiled in and the CPU supports it.
+    /// \~russian @brief Собран ли набор `set` и поддерживает ли его процессор.
+    [[nodiscard]] bool kernel_set_supported(KernelSet set) noexcept;
+    /**
+     * \~english
+     * @brief Switches to `set` if it is supported; returns `false` and keeps the current set otherwise.
+     *
+     * The best supported set is chosen automatically on first use, so this is only for pinning a set
+     * (for example, comparing against `Portable`). Meant to be called at startup: operations already running keep their set.
+     * \~russian
+     * @brief Переключает на набор `set`, если он поддерживается; иначе возвращает `false` и оставляет текущий.
+     *
+     * Лучший поддерживаемый набор выбирается автоматически при первом использовании, так что вызов нужен лишь
+     * для закрепления набора (например, для сравнения с `Portable`). Рассчитан на вызов при запуске: уже идущие операции остаются на своём наборе.
+     */
+    bool select_kernel_set(KernelSet set) noexcept;
+    /// \~english @brief Name of `set` for logs and telemetry (`"portable"`, `"int128"`, `"x86-bmi2"`).
+    /// \~russian @brief Имя набора `set` для журналов и телеметрии (`"portable"`, `"int128"`, `"x86-bmi2"`).
+    [[nodiscard]] const char* kernel_set_name(KernelSet set) noexcept;
+
+    namespace impl {
+        // Ядра одного набора над 64-битными словами
+        struct KernelTable {
+            KernelSet set;
+            uint64_t (*add_n)(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept;
+            uint64_t (*sub_n)(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept;
+            uint64_t (*mul_1)(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept;
+            uint64_t (*addmul_1)(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept;
+            uint64_t (*submul_1)(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept;
+        };
+
+        // Таблица активного набора; nullptr — набор ещё не выбран.
+        // Таблица Portable не содержит указателей: её ядра — шаблоны LimbOperations
+        inline std::atomic<const KernelTable*> active_kernels_slot{ nullptr };
+        // Выбирает лучший поддерживаемый набор, если раньше не был выбран другой
+        const KernelTable* select_default_kernels() noexcept;
+
+        // Таблица для вызова через указатель или nullptr, если работают переносимые циклы
+        inline const KernelTable* dispatched_kernels() noexcept {
+            const KernelTable* table = active_kernels_slot.load(std::memory_order_acquire);
+            if (table == nullptr) table = select_default_kernels();
+            return table->set == KernelSet::Portable ? nullptr : table;
+        }
+
+        // Ниже этой длины вызов через указатель дороже выигрыша: остаются встроенные циклы
+        inline constexpr size_t DISPATCH_MIN_LIMBS = 4;
+    }
+}
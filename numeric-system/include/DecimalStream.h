@@ -0,0 +1,108 @@
+#pragma once
+#include "BinaryArithmetic.h"
+#include "FactorialArithmetic.h"
+#include <iosfwd>
+#include <string_view>
+
+namespace numsystem {
+    /**
+     * \~english
+     * @brief Receiver of decimal digits produced by `write_decimal`.
+     *
+     * `write` gets the text in pieces, most significant digits first (the sign, if any, comes as its own piece);
+     * after each piece `progress` reports the number of characters written so far.
+     * \~russian
+     * @brief Приёмник десятичных цифр, которые выдаёт `write_decimal`.
+     *
+     * `write` получает текст кусками, начиная со старших цифр (знак, если есть, приходит отдельным куском);
+     * после каждого куска `progress` сообщает, сколько символов записано к этому моменту.
+     */
+    class DecimalSink {
+    public:
+        virtual ~DecimalSink() = default;
+        virtual void write(std::string_view digits) = 0;
+        virtual void progress(uint64_t written) { (void)written; }
+    };
+
+    /**
+     * \~english
+     * @brief Writes the decimal form of `value` (as `to_string` would) into `sink` without building the whole string.
+     *
+     * Digits are produced depth-first by the divide-and-conquer formatter: besides the value itself the working
+     * memory is about two binary sizes, whatever the number of digits.
+     * @return Number of characters written.
+     * \~russian
+     * @brief Записывает десятичную форму `value` (как `to_string`) в `sink`, не строя строку целиком.
+     *
+     * Цифры выдаются в глубину форматированием «разделяй и властвуй»: кроме самого значения рабочая память
+     * составляет около двух двоичных размеров независимо от числа цифр.
+     * @return Число записанных символов.
+     */
+    uint64_t write_decimal(const BinaryArithmetic& value, DecimalSink& sink);
+    uint64_t write_decimal(const BinaryArithmetic& value, std::ostream& out);
+    /// \~english @brief Same for a factorial number, through a direct conversion to binary.
+    /// \~russian @brief То же для факториального числа через прямой перевод в двоичное.
+    uint64_t write_decimal(const FactorialArithmetic& value, DecimalSink& sink);
+    uint64_t write_decimal(const FactorialArithmetic& value, std::ostream& out);
+
+    /**
+     * \~english
+     * @brief Incremental decimal parser: digits are fed in arbitrary pieces and never kept as a whole string.
+     *
+     * Digits are collected into blocks of `BLOCK_DIGITS`; each full block is converted to binary at once and
+     * equal-length neighbours are joined like a binary counter, so the pending pieces take about the binary
+     * size of the number and the total cost follows multiplication. The accepted text is the same as for the
+     * string constructor: an optional leading `-`, then digits without leading zeros.
+     * \~russian
+     * @brief Пошаговый десятичный разбор: цифры подаются кусками произвольной длины и не хранятся строкой целиком.
+     *
+     * Цифры собираются в блоки по `BLOCK_DIGITS`; каждый полный блок сразу переводится в двоичный вид, а соседние
+     * куски одинаковой длины склеиваются по принципу двоичного счётчика, поэтому накопленные куски занимают около
+     * двоичного размера числа, а общая стоимость определяется умножением. Принимается тот же текст, что и
+     * строковым конструктором: необязательный ведущий `-`, затем цифры без ведущих нулей.
+     */
+    class DecimalParser {
+    public:
+        /// \~english @brief Digits per block: `chunk_digits * 2^10`, a power cached for `set_str`.
+        /// \~russian @brief Цифр в блоке: `chunk_digits * 2^10` — степень из кэша `set_str`.
+        static constexpr size_t BLOCK_DIGITS = size_t(std::numeric_limits<uint64_t>::digits10) << 10;
+
+        DecimalParser();
+
+        /// \~english @brief Appends the next piece of text; @throws std::invalid_argument on a character that cannot continue the number.
+        /// \~russian @brief Дописывает очередной кусок текста; @throws std::invalid_argument На символе, который не может продолжать число.
+        void feed(std::string_view text);
+        /// \~english @brief Digits consumed so far (progress).
+        /// \~russian @brief Сколько цифр принято к этому моменту (прогресс).
+        [[nodiscard]] uint64_t digits() const noexcept { return _digits; }
+        /// \~english @brief Returns the number and resets the parser; @throws std::invalid_argument if no digits were fed.
+        /// \~russian @brief Возвращает число и сбрасывает разбор; @throws std::invalid_argument Если не было ни одной цифры.
+        [[nodiscard]] BinaryArithmetic finish();
+
+    private:
+        struct Piece {
+            std::vector<uint64_t> limbs;
+            size_t digits = 0;
+        };
+        void flush_block();
+
+        std::string _block;
+        std::vector<Piece> _pieces;     // от старших к младшим; длины не возрастают
+        uint64_t _digits = 0;
+        bool _negative = false;
+        bool _started = false;          // принят хотя бы один символ
+        bool _zero = false;             // первая цифра — ноль: других цифр быть не может
+    };
+
+    /**
+     * \~english
+     * @brief Reads a decimal number from `in` through `DecimalParser`, like `operator>>`: leading whitespace
+     * is skipped and reading stops before the first character that cannot continue the number.
+     * @throws std::invalid_argument if no digits are found or the text is not a valid number (the stream gets `failbit`).
+     * \~russian
+     * @brief Читает десятичное число из `in` через `DecimalParser`, как `operator>>`: ведущие пробелы
+     * пропускаются, чтение останавливается перед первым символом, который не может продолжать число.
+     * @throws std::invalid_argument Если цифр нет или текст — не корректное число (потоку ставится `failbit`).
+     */
+    [[nodiscard]] BinaryArithmetic read_decimal(std::istream& in);
+}
@@ -0,0 +1,232 @@
+﻿#pragma once
+#include "Internal.h"
+
+namespace numsystem {
+    /**
+     * \~english
+     * @brief Opt-in lazy evaluation for types built on `IntegralBase`.
+     *
+     * `expr::lazy(a) * b + c * d - e` does not compute anything: it builds a tree of
+     * references that `expr::assign(dest, expression)` evaluates straight into `dest`
+     * through the in-place `add_assign` / `subtract_assign` / `multiply_assign`, reusing
+     * the capacity of `dest`. A temporary is only needed for a right-hand subtree that
+     * is not a plain operand (the `c * d` above). Expressions may also be converted
+     * to the value type implicitly.
+     *
+     * The tree stores references to its operands, so it must be evaluated within the
+     * lifetime of those operands (normally in the same full expression).
+     * \~russian
+     * @brief Ленивые вычисления по желанию для типов на основе `IntegralBase`.
+     *
+     * `expr::lazy(a) * b + c * d - e` ничего не вычисляет: строится дерево ссылок, которое
+     * `expr::assign(dest, expression)` вычисляет прямо в `dest` через операции на месте
+     * `add_assign` / `subtract_assign` / `multiply_assign`, переиспользуя память `dest`.
+     * Временный объект нужен только для правого поддерева, которое не является простым
+     * операндом (`c * d` выше). Выражение также неявно приводится к типу значения.
+     *
+     * Дерево хранит ссылки на операнды, поэтому его нужно вычислить, пока операнды живы
+     * (обычно в том же полном выражении).
+     */
+    namespace expr {
+        template<typename Node, typename T>
+        struct Expression;
+
+        namespace detail {
+            template<typename T>
+            struct is_expression {
+                template<typename Node, typename V>
+                static std::true_type test(const Expression<Node, V>*);
+                static std::false_type test(...);
+                static constexpr bool value = decltype(test(std::declval<const T*>()))::value;
+            };
+            template<typename T>
+            constexpr bool is_expression_v = is_expression<std::decay_t<T>>::value;
+
+            template<typename T>
+            constexpr bool is_integral_base_v = std::is_base_of_v<IntegralBase<T>, T>;
+
+            // Операции над аккумулятором: acc = acc op rhs
+            struct Plus {
+                static constexpr bool commutative = true;
+                template<typename T> static void apply(T& acc, const T& rhs) { acc.add_assign(rhs); }
+            };
+            struct Minus {
+                static constexpr bool commutative = false;
+                template<typename T> static void apply(T& acc, const T& rhs) { acc.subtract_assign(rhs); }
+            };
+            struct Times {
+                static constexpr bool commutative = true;
+                template<typename T> static void apply(T& acc, const T& rhs) { acc.multiply_assign(rhs); }
+            };
+            struct Divides {
+                static constexpr bool commutative = false;
+                template<typename T> static void apply(T& acc, const T& rhs) { acc = acc.divide(rhs); }
+            };
+            struct Modulus {
+                static constexpr bool commutative = false;
+                template<typename T> static void apply(T& acc, const T& rhs) { acc = acc.modulo(rhs); }
+            };
+        }
+
+        /**
+         * \~english
+         * @brief CRTP base of all expression nodes.
+         * @tparam Node The concrete node type (`Terminal` or `BinaryNode`).
+         * @tparam T The value type the expression evaluates to.
+         * \~russian
+         * @brief CRTP-база всех узлов выражения.
+         * @tparam Node Конкретный тип узла (`Terminal` или `BinaryNode`).
+         * @tparam T Тип значения, в которое вычисляется выражение.
+         */
+        template<typename Node, typename T>
+        struct Expression {
+            [[nodiscard]] constexpr const Node& self() const noexcept { return static_cast<const Node&>(*this); }
+
+            /// \~english @brief Evaluates the expression into a new value.
+            /// \~russian @brief Вычисляет выражение в новое значение.
+            operator T() const {
+                T result;
+                self().evaluate_into(result);
+                return result;
+            }
+        };
+
+        /**
+         * \~english
+         * @brief Leaf of the expression tree: a reference to an existing value.
+         * \~russian
+         * @brief Лист дерева выражения: ссылка на существующее значение.
+         */
+        template<typename T>
+        struct Terminal : Expression<Terminal<T>, T> {
+            using value_type = T;
+            static constexpr bool is_terminal = true;
+
+            const T& value;
+
+            constexpr explicit Terminal(const T& v) noexcept : value(v) {}
+
+            void evaluate_into(T& dest) const { if (&dest != &value) dest = value; }
+            [[nodiscard]] bool refers_to(const T* object) const noexcept { return &value == object; }
+        };
+
+        /**
+         * \~english
+         * @brief Inner node of the expression tree: `lhs Op rhs`.
+         * \~russian
+         * @brief Внутренний узел дерева выражения: `lhs Op rhs`.
+         */
+        template<typename Op, typename L, typename R>
+        struct BinaryNode : Expression<BinaryNode<Op, L, R>, typename L::value_type> {
+            using value_type = typename L::value_type;
+            static constexpr bool is_terminal = false;
+
+            L lhs;
+            R rhs;
+
+            constexpr BinaryNode(const L& l, const R& r) : lhs(l), rhs(r) {}
+
+            // Левое поддерево считается прямо в dest, правое применяется к нему на месте.
+            // Для коммутативных операций с простым левым операндом порядок меняется,
+            // чтобы не заводить временный объект под правое поддерево
+            void evaluate_into(value_type& dest) const {
+                if constexpr (R::is_terminal) {
+                    lhs.evaluate_into(dest);
+                    Op::apply(dest, rhs.value);
+                }
+                else if constexpr (Op::commutative && L::is_terminal) {
+                    rhs.evaluate_into(dest);
+                    Op::apply(dest, lhs.value);
+                }
+                else {
+                    value_type right;
+                    rhs.evaluate_into(right);
+                    lhs.evaluate_into(dest);
+                    Op::apply(dest, right);
+                }
+            }
+            [[nodiscard]] bool refers_to(const value_type* object) const noexcept {
+                return lhs.refers_to(object) || rhs.refers_to(object);
+            }
+        };
+
+        /**
+         * \~english
+         * @brief Starts a lazy expression from an existing value.
+         * \~russian
+         * @brief Начинает ленивое выражение с существующего значения.
+         */
+        template<typename T, typename = std::enable_if_t<detail::is_integral_base_v<T>>>
+        [[nodiscard]] constexpr Terminal<T> lazy(const T& value) noexcept {
+            return Terminal<T>(value);
+        }
+
+        /**
+         * \~english
+         * @brief Evaluates `expression` into `dest`, reusing the storage of `dest`.
+         *
+         * If `dest` itself is an operand of the expression, the expression is evaluated
+         * into a temporary first so that operands are not overwritten mid-way.
+         * \~russian
+         * @brief Вычисляет `expression` в `dest`, переиспользуя хранилище `dest`.
+         *
+         * Если `dest` сам входит в выражение, оно сначала вычисляется во временный объект,
+         * чтобы операнды не перезаписывались по ходу вычисления.
+         */
+        template<typename T, typename Node>
+        T& assign(T& dest, const Expression<Node, T>& expression) {
+            const Node& node = expression.self();
+            if (!Node::is_terminal && node.refers_to(&dest)) {
+                T result;
+                node.evaluate_into(result);
+                dest = std::move(result);
+            }
+            else {
+                node.evaluate_into(dest);
+            }
+            return dest;
+        }
+
+        namespace detail {
+            template<typename T>
+            constexpr decltype(auto) as_node(const T& operand) noexcept {
+                if constexpr (is_expression_v<T>) return operand;
+                else return Terminal<T>(operand);
+            }
+            template<typename T>
+            using node_t = std::conditional_t<is_expression_v<T>, std::decay_t<T>, Terminal<std::decay_t<T>>>;
+
+            // Хотя бы один операнд должен быть выражением, иначе работают обычные операторы IntegralBase
+            template<typename L, typename R>
+            constexpr bool enable_v = (is_expression_v<L> || is_expression_v<R>)
+                && (is_expression_v<L> || is_integral_base_v<std::decay_t<L>>)
+                && (is_expression_v<R> || is_integral_base_v<std::decay_t<R>>);
+
+            template<typename Op, typename L, typename R>
+            constexpr BinaryNode<Op, node_t<L>, node_t<R>> make(const L& lhs, const R& rhs) {
+                return BinaryNode<Op, node_t<L>, node_t<R>>(as_node(lhs), as_node(rhs));
+            }
+        }
+
+        /// \~english @brief Lazy addition.
+        /// \~russian @brief Ленивое сложение.
+        template<typename L, typename R, typename = std::enable_if_t<detail::enable_v<L, R>>>
+        constexpr auto operator+(const L& lhs, const R& rhs) { return detail::make<detail::Plus>(lhs, rhs); }
+        /// \~english @brief Lazy subtraction.
+        /// \~russian @brief Ленивое вычитание.
+        template<typename L, typename R, typename = std::enable_if_t<detail::enable_v<L, R>>>
+        constexpr auto operator-(const L& lhs, const R& rhs) { return detail::make<detail::Minus>(lhs, rhs); }
+        /// \~english @brief Lazy multiplication.
+        /// \~russian @brief Ленивое умножение.
+        template<typename L, typename R, typename = std::enable_if_t<detail::enable_v<L, R>>>
+        constexpr auto operator*(const L& lhs, const R& rhs) { return detail::make<detail::Times>(lhs, rhs); }
+        /// \~english @brief Lazy division.
+        /// \~russian @brief Ленивое деление.
+        template<typename L, typename R, typename = std::enable_if_t<detail::enable_v<L, R>>>
+        constexpr auto operator/(const L& lhs, const R& rhs) { return detail::make<detail::Divides>(lhs, rhs); }
+        /// \~english @brief Lazy modulo.
+        /// \~russian @brief Ленивое взятие остатка.
+        template<typename L, typename R, typename = std::enable_if_t<detail::enable_v<L, R>>>
+        constexpr auto operator%(const L& lhs, const R& rhs) { return detail::make<detail::Modulus>(lhs, rhs); }
+    }
+}
@@ -33,69 +33,113 @@ namespace numsystem {
                 return N + (M * N - (pow2 - M - 2));
             }
 
-            template<typename _Ty>
-            static std::optional<uint64_t> extract(const impl::Storage<_Ty>& data, size_t index) {
-                using value_type = typename impl::Storage<_Ty>::value_type;
-                if (index > MAXINDEX-10) { 
-                    if (index > MAXINDEX) throw std::out_of_range("extract: index is out of allowed range");
+            // Индекс коэффициента, которому принадлежит абсолютный бит bit (бинарный поиск по total_bits_up_to)
+            static constexpr uint64_t index_at_bit(uint64_t bit) {
+                // total_bits_up_to(k) >= k - 1, поэтому ответ не больше bit + 1
+                uint64_t lo = 1, hi = std::min<uint64_t>(bit + 1, MAXINDEX);
+                while (lo < hi) {
+                    uint64_t mid = lo + (hi - lo + 1) / 2;
+                    if (total_bits_up_to(mid) <= bit) lo = mid;
+                    else hi = mid - 1;
                 }
-                uint64_t poswd = total_bits_up_to(index);   // позиция
-                uint64_t sizewd = count_bits(index);        // размер
-                if (sizewd == 0) return 0;                  // Обработка нулевой длины
+                return lo;
+            }
 
-                // Общая длина хранилища в битах
-                // Проверка выхода за границы
-                uint64_t VALUE_COUNT_BIT = std::numeric_limits<value_type>::digits;
-                size_t count_bits_in_storage = data.size() * std::numeric_limits<value_type>::digits;
-                if (poswd >= count_bits_in_storage) {
-                    return std::nullopt; // Начало чтения за границами данных
-                }
-                if (poswd + sizewd > count_bits_in_storage) {
-                    return std::nullopt; // Конец чтения за границами данных
+            // Читает width бит, начиная с абсолютного бита pos (границы проверяет вызывающий)
+            template<typename _Ty>
+            static uint64_t read_bits(const impl::Storage<_Ty>& data, uint64_t pos, uint64_t width) noexcept {
+                constexpr uint64_t VALUE_COUNT_BIT = std::numeric_limits<_Ty>::digits;
+                if (width == 0) return 0;
+                const uint64_t mask = (width < 64) ? (1ULL << width) - 1 : ~0ULL;
+
+                if constexpr (VALUE_COUNT_BIT == 64) {
+                    // Коэффициент занимает не больше двух слов: читаем их целиком
+                    const uint64_t word_idx = pos / VALUE_COUNT_BIT;
+                    const uint64_t bit_offset_in_word = pos % VALUE_COUNT_BIT;
+                    uint64_t result = data[word_idx] >> bit_offset_in_word;
+                    if (bit_offset_in_word != 0 && bit_offset_in_word + width > VALUE_COUNT_BIT) {
+                        result |= static_cast<uint64_t>(data[word_idx + 1]) << (VALUE_COUNT_BIT - bit_offset_in_word);
+                    }
+                    return result & mask;
                 }
-                      
-                uint64_t result = 0;								// Результат (значение коэффициента)
-                uint64_t bits_processed = 0;						// Сколько бит уже прочитано для этого коэффициента
-                uint64_t current_bit_in_storage = poswd;	        // Абсолютный индекс текущего читаемого бита в _storage
+                else {
+                    uint64_t result = 0;                // Результат (значение коэффициента)
+                    uint64_t bits_processed = 0;        // Сколько бит уже прочитано для этого коэффициента
 
-                // Читаем биты, пока не наберем bit_length
-                while (bits_processed < sizewd) {
-                    // Определяем, в каком слове и по какому смещению находится текущий бит
-                    uint64_t word_idx = current_bit_in_storage / VALUE_COUNT_BIT;
-                    uint64_t bit_offset_in_word = current_bit_in_storage % VALUE_COUNT_BIT;
+                    // Читаем по кускам, которые помещаются в текущее слово
+                    while (bits_processed < width) {
+                        uint64_t word_idx = pos / VALUE_COUNT_BIT;
+                        uint64_t bit_offset_in_word = pos % VALUE_COUNT_BIT;
+                        uint64_t bits_to_read_in_step = std::min(width - bits_processed, VALUE_COUNT_BIT - bit_offset_in_word);
 
-                    // Сколько бит мы можем прочитать из текущего слова, начиная с текущего смещения?
-                    uint64_t bits_available_in_word = VALUE_COUNT_BIT - bit_offset_in_word;
+                        uint64_t chunk = static_cast<uint64_t>(data[word_idx]) >> bit_offset_in_word;
+                        chunk &= (1ULL << bits_to_read_in_step) - 1;
+                        result |= chunk << bits_processed;
 
-                    // Сколько бит нужно прочитать на этом шаге (минимум из оставшейся длины коэффициента и доступных бит в слове)
-                    uint64_t bits_to_read_in_step = std::min(sizewd - bits_processed, bits_available_in_word);
+                        bits_processed += bits_to_read_in_step;
+                        pos += bits_to_read_in_step;
+                    }
+                    return result;
+                }
+            }
 
-                    // Читаем текущее слово как uint64_t для удобства побитовых операций
-                    uint64_t word_64 = data[word_idx];
+            // Записывает младшие width бит value, начиная с абсолютного бита pos (хранилище уже достаточного размера)
+            template<typename _Ty>
+            static void write_bits(impl::Storage<_Ty>& data, uint64_t pos, uint64_t width, uint64_t value) noexcept {
+                constexpr uint64_t VALUE_COUNT_BIT = std::numeric_limits<_Ty>::digits;
+                if (width == 0) return;
+                const uint64_t mask = (width < 64) ? (1ULL << width) - 1 : ~0ULL;
+                value &= mask;
+
+                if constexpr (VALUE_COUNT_BIT == 64) {
+                    const uint64_t word_idx = pos / VALUE_COUNT_BIT;
+                    const uint64_t bit_offset_in_word = pos % VALUE_COUNT_BIT;
+                    data[word_idx] = (data[word_idx] & ~(mask << bit_offset_in_word)) | (value << bit_offset_in_word);
+                    if (bit_offset_in_word != 0 && bit_offset_in_word + width > VALUE_COUNT_BIT) {
+                        const uint64_t spill = VALUE_COUNT_BIT - bit_offset_in_word;
+                        data[word_idx + 1] = (data[word_idx + 1] & ~(mask >> spill)) | (value >> spill);
+                    }
+                }
+                else {
+                    uint64_t bits_processed = 0;        // Сколько бит из value уже обработано
 
-                    // Извлекаем нужный кусок бит из слова. Сдвигаем вправо, чтобы нужные биты оказались в младших позициях.
-                    uint64_t chunk = word_64 >> bit_offset_in_word;
+                    while (bits_processed < width) {
+                        uint64_t word_idx = pos / VALUE_COUNT_BIT;
+                        uint64_t bit_offset_in_word = pos % VALUE_COUNT_BIT;
+                        uint64_t bits_to_write_in_step = std::min(width - bits_processed, VALUE_COUNT_BIT - bit_offset_in_word);
 
-                    // Маскируем, чтобы оставить только нужное количество бит для этого шага
-                    // Если читаем ровно до конца uint64_t или VALUE_COUNT_BIT, маска не нужна (или ~0ULL)
-                    if (bits_to_read_in_step < 64) { // Маска 1ULL << N - 1 безопасна, пока N < 64
-                        chunk &= (1ULL << bits_to_read_in_step) - 1;
+                        // Маска очищает записываемые биты в слове, кусок value сдвигается на то же смещение
+                        uint64_t chunk_mask = ((1ULL << bits_to_write_in_step) - 1) << bit_offset_in_word;
+                        uint64_t chunk_from_value = ((value >> bits_processed) << bit_offset_in_word) & chunk_mask;
+
+                        uint64_t word_64 = data[word_idx];
+                        word_64 = (word_64 & ~chunk_mask) | chunk_from_value;
+                        data[word_idx] = static_cast<_Ty>(word_64);
+
+                        bits_processed += bits_to_write_in_step;
+                        pos += bits_to_write_in_step;
                     }
+                }
+            }
 
-                    // Добавляем извлеченный кусок к результату. Сдвигаем его влево на количество уже прочитанных бит.
-                    result |= chunk << bits_processed;
+            template<typename _Ty>
+            static std::optional<uint64_t> extract(const impl::Storage<_Ty>& data, size_t index) {
+                if (index > MAXINDEX) throw std::out_of_range("extract: index is out of allowed range");
+                NUMSYS_COUNT_OPERATION(FactorExtract, data.size());
+                uint64_t poswd = total_bits_up_to(index);   // позиция
+                uint64_t sizewd = count_bits(index);        // размер
+                if (sizewd == 0) return 0;                  // Обработка нулевой длины
 
-                    // Обновляем счетчики и позицию
-                    bits_processed += bits_to_read_in_step;
-                    current_bit_in_storage += bits_to_read_in_step;
+                // Проверка выхода за границы хранилища
+                size_t count_bits_in_storage = data.size() * std::numeric_limits<_Ty>::digits;
+                if (poswd + sizewd > count_bits_in_storage) {
+                    return std::nullopt;
                 }
-                return result;
+                return read_bits(data, poswd, sizewd);
             }
 
             template<typename _Ty>
             static void put(impl::Storage<_Ty>& data, size_t index, uint64_t value) {
-                using value_type = typename impl::Storage<_Ty>::value_type;
-                using RawType = std::remove_cv_t<std::remove_reference_t<decltype(data)>>;
                 if (index > MAXINDEX) { throw std::out_of_range("put: index is out of allowed range"); }
                 uint64_t poswd = total_bits_up_to(index);   // позиция
                 uint64_t sizewd = count_bits(index);        // размер
@@ -103,66 +147,154 @@ namespace numsystem {
                 if (index < value) { throw std::logic_error("value exceeds base (index) in factorial number system: value must be <= index"); }  // В факториальной системе по основнанию не может находится число больше самого основания            
                 if (data.value() < index) data.value(index);
 
-                uint64_t VALUE_COUNT_BIT = std::numeric_limits<value_type>::digits;
-                size_t count_bits_in_storage = data.size() * std::numeric_limits<value_type>::digits;
-       
                 // Проверка, что хранилище имеет достаточный размер
+                constexpr uint64_t VALUE_COUNT_BIT = std::numeric_limits<_Ty>::digits;
                 uint64_t total_words_needed = (poswd + sizewd + VALUE_COUNT_BIT - 1) / VALUE_COUNT_BIT;
                 if (total_words_needed > data.size()) data.resize(total_words_needed, 0);
 
-                uint64_t bits_processed = 0;				// Сколько бит из value уже обработано
-                uint64_t current_bit_in_storage = poswd;	// Абсолютный индекс текущего записываемого бита в _storage
+                write_bits(data, poswd, sizewd, value);
+            }
+        };
 
-                
-                // Записываем биты из value, пока не запишем bit_length
-                while (bits_processed < sizewd) {
-                    // Определяем, в каком слове и по какому смещению находится текущая позиция записи
-                    uint64_t word_idx = current_bit_in_storage / VALUE_COUNT_BIT;
-                    uint64_t bit_offset_in_word = current_bit_in_storage % VALUE_COUNT_BIT;
+        // Положение коэффициента в упакованном хранилище: индекс, смещение в битах и ширина.
+        // Соседние коэффициенты лежат подряд, поэтому шаг вперёд/назад стоит O(1)
+        // вместо total_bits_up_to() и count_bits() на каждом индексе
+        struct FactorPosition {
+            uint64_t index = 0;
+            uint64_t offset = 0;
+            uint64_t width = 0;
+
+            constexpr FactorPosition() noexcept = default;
+            constexpr explicit FactorPosition(uint64_t idx)
+                : index(idx), offset(FactorAccess::total_bits_up_to(idx)), width(FactorAccess::count_bits(idx)) {}
+
+            // Ширина растёт на бит, когда индекс становится степенью двойки
+            constexpr void next() noexcept {
+                offset += width;
+                ++index;
+                if ((index & (index - 1)) == 0) ++width;
+            }
+            // Требует index > 0
+            constexpr void prev() noexcept {
+                if ((index & (index - 1)) == 0) --width;
+                --index;
+                offset -= width;
+            }
+        };
 
-                    // Сколько бит мы можем записать в текущее слово, начиная с текущего смещения?
-                    uint64_t bits_available_in_word = VALUE_COUNT_BIT - bit_offset_in_word;
+        // Курсор чтения коэффициентов; за пределами хранилища коэффициенты равны 0
+        template<typename _Ty>
+        class FactorCursor {
+        public:
+            explicit FactorCursor(const impl::Storage<_Ty>& data, uint64_t index = 0) : _data(&data), _pos(index) {}
 
-                    // Сколько бит нужно записать на этом шаге (минимум из оставшейся длины коэффициента и доступных бит в слове)
-                    uint64_t bits_to_write_in_step = std::min(sizewd - bits_processed, bits_available_in_word);
+            [[nodiscard]] uint64_t index() const noexcept { return _pos.index; }
+            // Коэффициент целиком лежит в хранилище
+            [[nodiscard]] bool valid() const noexcept {
+                return _pos.offset + _pos.width <= _data->size() * static_cast<uint64_t>(std::numeric_limits<_Ty>::digits);
+            }
+            [[nodiscard]] uint64_t operator*() const noexcept {
+                return valid() ? FactorAccess::read_bits(*_data, _pos.offset, _pos.width) : 0;
+            }
+            FactorCursor& operator++() noexcept { _pos.next(); return *this; }
+            FactorCursor& operator--() noexcept { _pos.prev(); return *this; }
 
-                    // Извлекаем нужный кусок бит из значения value. Сдвигаем вправо, чтобы нужные биты оказались в младших позициях.
-                    uint64_t chunk_from_value = value >> bits_processed;
-                    // Маскируем, чтобы оставить только нужное количество бит для этого шага
-                    if (bits_to_write_in_step < 64) { // Маска безопасна, пока N < 64
-                        chunk_from_value &= (1ULL << bits_to_write_in_step) - 1;
-                    }
+        private:
+            const impl::Storage<_Ty>* _data;
+            FactorPosition _pos;
+        };
+
+        // Последовательная запись коэффициентов: push() пишет текущий коэффициент и переходит к следующему
+        template<typename _Ty>
+        class FactorWriter {
+        public:
+            explicit FactorWriter(impl::Storage<_Ty>& data, uint64_t index = 0) : _data(&data), _pos(index) {}
+
+            [[nodiscard]] uint64_t index() const noexcept { return _pos.index; }
+            void push(uint64_t value) {
+                constexpr uint64_t VALUE_COUNT_BIT = std::numeric_limits<_Ty>::digits;
+                if (_pos.index < value) { throw std::logic_error("value exceeds base (index) in factorial number system: value must be <= index"); }
+                if (_pos.width != 0) {
+                    uint64_t total_words_needed = (_pos.offset + _pos.width + VALUE_COUNT_BIT - 1) / VALUE_COUNT_BIT;
+                    if (total_words_needed > _data->size()) _data->resize(total_words_needed, 0);
+                    FactorAccess::write_bits(*_data, _pos.offset, _pos.width, value);
+                    if (_data->value() < _pos.index) _data->value(_pos.index);
+                }
+                _pos.next();
+            }
+
+        private:
+            impl::Storage<_Ty>* _data;
+            FactorPosition _pos;
+        };
+    }
 
-                    // Создаем маску для очистки соответствующих бит в целевом слове.
-                    // Маска должна иметь 1 там, куда мы будем записывать, и 0 в остальных местах.
-                    uint64_t mask_val_64 = (bits_to_write_in_step == VALUE_COUNT_BIT) ? ~0ULL : (1ULL << bits_to_write_in_step) - 1;
-                    uint64_t mask_shifted_64 = mask_val_64 << bit_offset_in_word; // Сдвигаем маску на нужное смещение
+    /**
+     * \~english
+     * @brief Read-only view of the coefficients `d_0, d_1, ..., d_top` of a factorial number, unpacked on the fly.
+     *
+     * The coefficients are read straight from the packed storage of the number: nothing is copied or
+     * allocated. `d_0` is always 0, `d_k <= k`; the view is empty for zero. It is valid until the
+     * number changes or is destroyed.
+     * \~russian
+     * @brief Представление коэффициентов `d_0, d_1, ..., d_top` факториального числа только для чтения с распаковкой на лету.
+     *
+     * Коэффициенты читаются прямо из упакованного хранилища числа: ничего не копируется и не
+     * выделяется. `d_0` всегда 0, `d_k <= k`; для нуля представление пусто. Действительно, пока
+     * число не изменено и не уничтожено.
+     */
+    class CoefficientView {
+    public:
+        // Однопроходный итератор: шаг к соседнему коэффициенту стоит O(1)
+        class iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = uint64_t;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = uint64_t;
+
+            iterator(const impl::Storage<uint64_t>& data, uint64_t index) : _cursor(data, index) {}
+            [[nodiscard]] uint64_t operator*() const noexcept { return *_cursor; }
+            iterator& operator++() noexcept { ++_cursor; return *this; }
+            iterator operator++(int) noexcept { iterator old = *this; ++_cursor; return old; }
+            friend bool operator==(const iterator& a, const iterator& b) noexcept { return a._cursor.index() == b._cursor.index(); }
+            friend bool operator!=(const iterator& a, const iterator& b) noexcept { return !(a == b); }
+        private:
+            internal::FactorCursor<uint64_t> _cursor;
+        };
 
-                    // Читаем текущее слово как uint64_t, модифицируем и записываем обратно
-                    uint64_t word_64 = data[word_idx];
+        CoefficientView(const impl::Storage<uint64_t>& data, size_t size) noexcept : _data(&data), _size(size) {}
 
-                    // Очищаем биты в целевом слове, используя инвертированную маску
-                    word_64 &= ~mask_shifted_64;
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+        [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+        // Коэффициент при k! (0 за пределами числа)
+        [[nodiscard]] uint64_t operator[](size_t k) const { return internal::FactorAccess::extract(*_data, k).value_or(0); }
+        [[nodiscard]] iterator begin() const { return iterator(*_data, 0); }
+        [[nodiscard]] iterator end() const { return iterator(*_data, _size); }
+    private:
+        const impl::Storage<uint64_t>* _data;
+        size_t _size;
+    };
 
-                    // Устанавливаем новые биты, сдвигая кусок значения на нужное смещение
-                    word_64 |= static_cast<uint64_t>(chunk_from_value) << bit_offset_in_word; // static_cast на случай, если chunk_from_value был только int
+    template<typename Limb>
+    class BasicBinaryArithmetic;
+    using BinaryArithmetic = BasicBinaryArithmetic<uint64_t>;
 
-                    // Записываем модифицированное слово обратно в хранилище
-                    // Приведение к value_type автоматически отбросит старшие биты, если VALUE_COUNT_BIT < 64
-                    data[word_idx] = static_cast<value_type>(word_64);
+    template<size_t MaxIndex>
+    class FixedFactorial;
 
-                    // Обновляем счетчики и позицию
-                    bits_processed += bits_to_write_in_step;
-                    current_bit_in_storage += bits_to_write_in_step;
-                }
-            }    
-        };
+    namespace impl {
+        struct SerializationAccess;
+        struct PermutationAccess;
     }
 
+    // Потоки: те же правила, что у BasicBinaryArithmetic — константный доступ из многих потоков
+    // безопасен, изменение одновременно с другим доступом — гонка, копии независимы
     class FactorialArithmetic : public IntegralBase<FactorialArithmetic> {
     public:
         // --- Конструкторы ---
-        constexpr FactorialArithmetic() : _storage() {}
+        FactorialArithmetic() : _storage() {}
         FactorialArithmetic(const char* value) : FactorialArithmetic(std::string_view(value)) {}
         FactorialArithmetic(std::string_view value);
 
@@ -176,19 +308,15 @@ namespace numsystem {
             }
 
 
-            using FA = internal::FactorAccess;
+            // Отрицание в беззнаковом типе, чтобы не переполнить min()
             using UnsignedTy = std::make_unsigned_t<_Ty>;
-            UnsignedTy abs_value = static_cast<UnsignedTy>(sign() ? -value : value);
-
-            uint64_t divisor = 1;
-            size_t idx = 1;
+            UnsignedTy abs_value = sign() ? UnsignedTy(0) - static_cast<UnsignedTy>(value) : static_cast<UnsignedTy>(value);
 
-            while (abs_value > 0) {
-                divisor *= idx;
-                uint64_t remainder = abs_value % idx;
-                FA::put(_storage, idx - 1, remainder);  // записывает коэфицент
-                abs_value /= idx;
-                ++idx;
+            // Коэффициент d_k — остаток от деления на основание k + 1
+            internal::FactorWriter writer(_storage);
+            for (uint64_t radix = 1; abs_value > 0; ++radix) {
+                writer.push(static_cast<uint64_t>(abs_value % radix));  // записывает коэфицент
+                abs_value /= radix;
             }
 
             trim_leading_zeros();
@@ -199,7 +327,6 @@ namespace numsystem {
         constexpr explicit operator _Ty() const {
             if (is_zero()) return _Ty(0);
 
-            using FA = internal::FactorAccess;
             using UnsignedTy = std::make_unsigned_t<_Ty>;
             UnsignedTy result = 0;
             UnsignedTy factorial = 1;
@@ -207,11 +334,9 @@ namespace numsystem {
             // Максимум 21 позиция (0..20)
             constexpr size_t max_index = 21;
 
-            for (size_t idx = 0; idx < max_index; ++idx) {
-                auto digit_opt = FA::extract(_storage, idx); // читает коэфицент 
-                if (!digit_opt.has_value()) break;
-
-                UnsignedTy digit = static_cast<UnsignedTy>(digit_opt.value());
+            for (internal::FactorCursor cursor(_storage); cursor.index() < max_index && cursor.valid(); ++cursor) {
+                const size_t idx = cursor.index();
+                UnsignedTy digit = static_cast<UnsignedTy>(*cursor);    // читает коэфицент
 
                 // Проверяем не выйдет ли за пределы типа
                 if (digit > 0 && result > std::numeric_limits<UnsignedTy>::max() - digit * factorial) {
@@ -233,8 +358,8 @@ namespace numsystem {
                 return static_cast<_Ty>(result);
             }
             else {
-                auto signed_val = static_cast<std::make_signed_t<UnsignedTy>>(result);
-                return sign() ? static_cast<_Ty>(-signed_val) : static_cast<_Ty>(signed_val);
+                if (sign()) result = UnsignedTy(0) - result;
+                return static_cast<_Ty>(static_cast<std::make_signed_t<UnsignedTy>>(result));
             }
         }
         
@@ -244,23 +369,100 @@ namespace numsystem {
             return *this;
         }
 
+        /**
+         * \~english
+         * @brief Number `sum(coefficients[k] * k!)` with the given sign, packed in one pass with no radix conversion.
+         *
+         * `coefficients[0]` is the coefficient at `0!` and must be 0; trailing zero coefficients are allowed.
+         * @throws std::invalid_argument if `coefficients[0] != 0` or `coefficients[k] > k` for some `k`.
+         * \~russian
+         * @brief Число `sum(coefficients[k] * k!)` с заданным знаком, упакованное за один проход без перевода между системами.
+         *
+         * `coefficients[0]` — коэффициент при `0!`, он должен быть равен 0; старшие нулевые коэффициенты допустимы.
+         * @throws std::invalid_argument Если `coefficients[0] != 0` или `coefficients[k] > k` для некоторого `k`.
+         */
+        [[nodiscard]] static FactorialArithmetic from_coefficients(ConstSpan<uint64_t> coefficients, bool negative = false);
+        /**
+         * \~english
+         * @brief Converts to binary directly: Horner evaluation with word-sized steps, and from
+         * `ConversionThresholds::FACTORIAL_DC` limbs a split by products of radices `m! / s!`.
+         * \~russian
+         * @brief Переводит в двоичную запись напрямую: схема Горнера с шагами размером в слово, а начиная
+         * с `ConversionThresholds::FACTORIAL_DC` слов — деление по произведениям оснований `m! / s!`.
+         */
+        [[nodiscard]] BinaryArithmetic to_binary() const;
+        /// \~english @brief Converts from binary directly by small divisions, splitting long numbers by products of radices.
+        /// \~russian @brief Переводит из двоичной записи напрямую малыми делениями, длинные числа делятся по произведениям оснований.
+        [[nodiscard]] static FactorialArithmetic from_binary(const BinaryArithmetic& value);
+        /// \~english @brief The coefficients `d_0..d_top` read in place from the packed storage (empty for zero).
+        /// \~russian @brief Коэффициенты `d_0..d_top`, читаемые на месте из упакованного хранилища (пусто для нуля).
+        [[nodiscard]] CoefficientView coefficients() const noexcept {
+            return CoefficientView(_storage, is_zero() ? 0 : static_cast<size_t>(_storage.value()) + 1);
+        }
+
+        /**
+         * \~english
+         * @brief Makes copies of this value O(1): the packed coefficients move to an immutable block with an atomic
+         * reference count, copied by each copy on its first modification (see `BinaryArithmetic::share()`).
+         * \~russian
+         * @brief Делает копирование этого значения O(1): упакованные коэффициенты переносятся в неизменяемый блок
+         * с атомарным счётчиком ссылок, который каждая копия копирует при первом изменении (см. `BinaryArithmetic::share()`).
+         */
+        FactorialArithmetic& share() {
+            _storage.share();
+            return *this;
+        }
+        /// \~english @brief Checks whether the coefficients live in a shared block (see `share()`).
+        /// \~russian @brief Проверяет, лежат ли коэффициенты в общем блоке (см. `share()`).
+        [[nodiscard]] bool is_shared() const noexcept { return _storage.shared(); }
+
         [[nodiscard]] int compare(const FactorialArithmetic& other) const noexcept;
         [[nodiscard]] FactorialArithmetic add(const FactorialArithmetic& other) const;
         [[nodiscard]] FactorialArithmetic divide(const FactorialArithmetic& other) const;
         [[nodiscard]] FactorialArithmetic modulo(const FactorialArithmetic& other) const;
         [[nodiscard]] FactorialArithmetic subtract(const FactorialArithmetic& other) const;
         [[nodiscard]] FactorialArithmetic multiply(const FactorialArithmetic& other) const;
+        // Частное и остаток за одно деление
+        [[nodiscard]] std::pair<FactorialArithmetic, FactorialArithmetic> divmod(const FactorialArithmetic& other) const;
+        // Операции на месте со знаком: сложение и вычитание пишут коэффициенты в текущее хранилище
+        void add_assign(const FactorialArithmetic& other);
+        void subtract_assign(const FactorialArithmetic& other);
+        void multiply_assign(const FactorialArithmetic& other);
+        // Смешанная арифметика с 64-битным скаляром за один проход по коэффициентам, переносы локальны.
+        // negative — знак скаляра (модуль передаётся в value / divisor)
+        void add_small(uint64_t value, bool negative = false);
+        void mul_small(uint64_t value, bool negative = false);
+        // *this /= ±divisor с усечением к нулю, возвращает модуль остатка
+        uint64_t divmod_small(uint64_t divisor, bool negative = false);
+        // Модуль остатка |*this| % divisor
+        [[nodiscard]] uint64_t mod_small(uint64_t divisor) const;
+        // Число бит в двоичной записи |*this| (0 для нуля)
+        [[nodiscard]] size_t bit_length() const;
+        // Коэффициент при index! (0 за пределами числа), читается прямо из упакованного хранилища;
+        // @throws std::out_of_range для index > FactorAccess::MAXINDEX
+        [[nodiscard]] uint64_t coefficient(uint64_t index) const {
+            return internal::FactorAccess::extract(_storage, index).value_or(0);
+        }
 
         inline void sign(bool s) noexcept { _storage.sign(s); }
         [[nodiscard]] inline bool sign() const noexcept { return _storage.sign(); }
         [[nodiscard]] inline explicit operator bool() const noexcept { return !this->is_zero(); }
 
         friend std::string to_string(const FactorialArithmetic& other);
+        // Преобразование в тип фиксированной ширины и обратно читает и пишет коэффициенты напрямую
+        template<size_t MaxIndex>
+        friend class FixedFactorial;
+        // Сериализация копирует упакованные слова коэффициентов напрямую
+        friend struct impl::SerializationAccess;
+        // Номера перестановок пишутся и читаются как коды Лемера прямо в хранилище
+        friend struct impl::PermutationAccess;
     private:
-        using value_type = uint8_t;
+        // 64-битные слова: любой коэффициент читается и пишется максимум двумя словами
+        using value_type = uint64_t;
         impl::Storage<value_type> _storage;
         bool is_zero() const noexcept;           // тут просто проверка «весь вектор == {0}»
         void trim_leading_zeros() noexcept;      // тут реальное pop_back, убирающее лишние нули
+        void add_signed(const FactorialArithmetic& other, bool other_sign);  // *this += (other_sign ? -|other| : |other|)
     };
 
 
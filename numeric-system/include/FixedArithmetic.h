@@ -0,0 +1,867 @@
+﻿#pragma once
+#include "BinaryArithmetic.h"
+#include "FactorialArithmetic.h"
+#include <array>
+
+namespace numsystem {
+    namespace impl {
+        /**
+         * \~english
+         * @brief `constexpr` kernels on fixed-size arrays of 64-bit limbs (least significant limb first).
+         *
+         * The sizes are template parameters, so every loop has a trip count known at compile time
+         * and the compiler unrolls the carry chains of small widths completely. Nothing allocates.
+         * \~russian
+         * @brief `constexpr`-ядра над массивами фиксированного размера из 64-битных слов (младшее слово первым).
+         *
+         * Размеры — параметры шаблона, поэтому число итераций каждого цикла известно при компиляции,
+         * и для небольших ширин компилятор полностью разворачивает цепочки переносов. Память не выделяется.
+         */
+        struct FixedOperations {
+            using Limb = uint64_t;
+            template<size_t N>
+            using Limbs = std::array<Limb, N>;
+            static constexpr unsigned LIMB_BITS = 64;
+
+            // Число старших нулевых бит ненулевого слова (двоичный поиск, годится для constexpr)
+            static constexpr unsigned count_leading_zeros(Limb x) noexcept {
+                unsigned count = 0;
+                for (unsigned width = LIMB_BITS / 2; width > 0; width /= 2) {
+                    if ((x >> (LIMB_BITS - width)) == 0) { count += width; x <<= width; }
+                }
+                return count;
+            }
+            // high:low / divisor при high < divisor
+            static constexpr Limb divide(Limb high, Limb low, Limb divisor, Limb& remainder) noexcept {
+#if defined(__SIZEOF_INT128__)
+                const uint128_t dividend = (static_cast<uint128_t>(high) << 64) | low;
+                remainder = static_cast<Limb>(dividend % divisor);
+                return static_cast<Limb>(dividend / divisor);
+#else
+                return OverflowAwareOps::divide_halves(high, low, divisor, remainder);
+#endif
+            }
+
+            template<size_t N>
+            static constexpr size_t normalized_size(const Limbs<N>& a) noexcept {
+                size_t n = N;
+                while (n > 0 && a[n - 1] == 0) --n;
+                return n;
+            }
+            template<size_t N>
+            static constexpr bool is_zero(const Limbs<N>& a) noexcept { return normalized_size(a) == 0; }
+            template<size_t N>
+            static constexpr size_t bit_length(const Limbs<N>& a) noexcept {
+                const size_t n = normalized_size(a);
+                return n == 0 ? 0 : n * LIMB_BITS - count_leading_zeros(a[n - 1]);
+            }
+            // Беззнаковое сравнение: -1, 0 или 1
+            template<size_t N>
+            static constexpr int compare(const Limbs<N>& a, const Limbs<N>& b) noexcept {
+                for (size_t i = N; i-- > 0;) {
+                    if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+                }
+                return 0;
+            }
+
+            // a += b, возвращает перенос
+            template<size_t N>
+            static constexpr Limb add(Limbs<N>& a, const Limbs<N>& b) noexcept {
+                Limb carry = 0;
+                for (size_t i = 0; i < N; ++i) a[i] = OverflowAwareOps::sum(a[i], b[i], carry);
+                return carry;
+            }
+            // a -= b, возвращает заём
+            template<size_t N>
+            static constexpr Limb sub(Limbs<N>& a, const Limbs<N>& b) noexcept {
+                Limb borrow = 0;
+                for (size_t i = 0; i < N; ++i) a[i] = OverflowAwareOps::subtract(a[i], b[i], borrow);
+                return borrow;
+            }
+            template<size_t N>
+            static constexpr Limb add_1(Limbs<N>& a, Limb value) noexcept {
+                for (size_t i = 0; i < N && value != 0; ++i) {
+                    a[i] += value;
+                    value = a[i] < value ? 1 : 0;
+                }
+                return value;
+            }
+            template<size_t N>
+            static constexpr Limb sub_1(Limbs<N>& a, Limb value) noexcept {
+                for (size_t i = 0; i < N && value != 0; ++i) {
+                    const Limb before = a[i];
+                    a[i] -= value;
+                    value = before < value ? 1 : 0;
+                }
+                return value;
+            }
+            // a = -a по модулю 2^(64 * N)
+            template<size_t N>
+            static constexpr void negate(Limbs<N>& a) noexcept {
+                Limb carry = 1;
+                for (size_t i = 0; i < N; ++i) {
+                    a[i] = ~a[i] + carry;
+                    carry = (carry != 0 && a[i] == 0) ? 1 : 0;
+                }
+            }
+            // a *= value, возвращает старшее слово
+            template<size_t N>
+            static constexpr Limb mul_1(Limbs<N>& a, Limb value) noexcept {
+                Limb carry = 0;
+                for (size_t i = 0; i < N; ++i) {
+                    Limb high = 0;
+                    Limb low = OverflowAwareOps::multiply(a[i], value, high);
+                    low += carry;
+                    carry = high + (low < carry ? 1 : 0);
+                    a[i] = low;
+                }
+                return carry;
+            }
+            // Младшие R слов произведения a * b (школьное умножение)
+            template<size_t R, size_t N, size_t M>
+            static constexpr Limbs<R> mul(const Limbs<N>& a, const Limbs<M>& b) noexcept {
+                Limbs<R> r{};
+                for (size_t i = 0; i < N && i < R; ++i) {
+                    if (a[i] == 0) continue;
+                    Limb carry = 0;
+                    for (size_t j = 0; j < M && i + j < R; ++j) {
+                        Limb high = 0;
+                        Limb low = OverflowAwareOps::multiply(a[i], b[j], high);
+                        low += carry;
+                        high += low < carry ? 1 : 0;
+                        r[i + j] += low;
+                        high += r[i + j] < low ? 1 : 0;
+                        carry = high;
+                    }
+                    if (i + M < R) r[i + M] = carry;
+                }
+                return r;
+            }
+            // a /= divisor, возвращает остаток; divisor != 0
+            template<size_t N>
+            static constexpr Limb divrem_1(Limbs<N>& a, Limb divisor) noexcept {
+                Limb remainder = 0;
+                for (size_t i = N; i-- > 0;) a[i] = divide(remainder, a[i], divisor, remainder);
+                return remainder;
+            }
+            // a = число из цифр digits в системе radix (2..16); при separators апостроф (разделитель C++14) пропускается.
+            // Цифры копятся в слове, пока radix^k помещается в него. Возвращает false, если число не поместилось в N слов
+            template<size_t N>
+            static constexpr bool set_str(Limbs<N>& a, std::string_view digits, unsigned radix, bool separators = false) {
+                a = Limbs<N>{};
+                bool fits = true;
+                Limb chunk = 0, scale = 1;
+                const auto flush = [&] {
+                    const bool no_carry = mul_1(a, scale) == 0;
+                    fits = fits && no_carry && add_1(a, chunk) == 0;
+                    chunk = 0;
+                    scale = 1;
+                };
+                for (char c : digits) {
+                    if (separators && c == '\'') continue;
+                    const unsigned digit = (c >= '0' && c <= '9') ? unsigned(c - '0')
+                        : (c >= 'a' && c <= 'f') ? unsigned(c - 'a' + 10)
+                        : (c >= 'A' && c <= 'F') ? unsigned(c - 'A' + 10) : 16u;
+                    if (digit >= radix) throw std::invalid_argument("Invalid digit in number");
+                    if (scale > ~Limb(0) / radix) flush();
+                    chunk = chunk * radix + digit;
+                    scale *= radix;
+                }
+                flush();
+                return fits;
+            }
+            // q = a / b, r = a % b (алгоритм D Кнута); b != 0
+            template<size_t N>
+            static constexpr void divrem(Limbs<N>& q, Limbs<N>& r, const Limbs<N>& a, const Limbs<N>& b) noexcept {
+                const size_t n = normalized_size(b);
+                const size_t m = normalized_size(a);
+                q = Limbs<N>{};
+                r = Limbs<N>{};
+                if (m < n) {
+                    r = a;
+                    return;
+                }
+                if (n == 1) {
+                    q = a;
+                    r[0] = divrem_1(q, b[0]);
+                    return;
+                }
+
+                // D1: нормализация — старший бит делителя должен быть установлен
+                const unsigned shift = count_leading_zeros(b[n - 1]);
+                Limbs<N + 1> un{};
+                Limbs<N> vn{};
+                for (size_t i = 0; i < n; ++i) {
+                    vn[i] = (b[i] << shift) | ((shift != 0 && i > 0) ? b[i - 1] >> (LIMB_BITS - shift) : 0);
+                }
+                for (size_t i = 0; i < m; ++i) {
+                    un[i] = (a[i] << shift) | ((shift != 0 && i > 0) ? a[i - 1] >> (LIMB_BITS - shift) : 0);
+                }
+                un[m] = shift != 0 ? a[m - 1] >> (LIMB_BITS - shift) : 0;
+
+                const Limb v1 = vn[n - 1];
+                const Limb v2 = vn[n - 2];
+                for (size_t j = m - n + 1; j-- > 0;) {
+                    // D3: оценка цифры частного по трём старшим словам остатка и двум — делителя
+                    Limb qhat = 0, rhat = 0;
+                    bool rhat_overflow = false;
+                    if (un[j + n] >= v1) {
+                        qhat = ~Limb(0);
+                        rhat = un[j + n - 1] + v1;
+                        rhat_overflow = rhat < v1;
+                    }
+                    else {
+                        qhat = divide(un[j + n], un[j + n - 1], v1, rhat);
+                    }
+                    while (!rhat_overflow) {
+                        Limb high = 0;
+                        const Limb low = OverflowAwareOps::multiply(qhat, v2, high);
+                        if (high < rhat || (high == rhat && low <= un[j + n - 2])) break;
+                        --qhat;
+                        rhat += v1;
+                        rhat_overflow = rhat < v1;
+                    }
+
+                    // D4: вычитание qhat * v; D6: при отрицательном результате — обратное сложение
+                    Limb borrow = 0;
+                    for (size_t i = 0; i < n; ++i) {
+                        Limb high = 0;
+                        Limb low = OverflowAwareOps::multiply(qhat, vn[i], high);
+                        low += borrow;
+                        high += low < borrow ? 1 : 0;
+                        const Limb before = un[j + i];
+                        un[j + i] = before - low;
+                        borrow = high + (before < low ? 1 : 0);
+                    }
+                    const Limb top = un[j + n];
+                    un[j + n] = top - borrow;
+                    if (top < borrow) {
+                        --qhat;
+                        Limb carry = 0;
+                        for (size_t i = 0; i < n; ++i) un[j + i] = OverflowAwareOps::sum(un[j + i], vn[i], carry);
+                        un[j + n] += carry;
+                    }
+                    q[j] = qhat;
+                }
+
+                // D8: денормализация остатка
+                for (size_t i = 0; i < n; ++i) {
+                    r[i] = (un[i] >> shift) | (shift != 0 ? un[i + 1] << (LIMB_BITS - shift) : 0);
+                }
+            }
+        };
+    }
+
+    /**
+     * \~english
+     * @brief Signed fixed-width integer of `Bits` bits in two's complement, stored inline in a `std::array`.
+     *
+     * Behaves like a built-in integer of that width: results wrap around modulo `2^Bits`, there is
+     * no heap storage, trimming or separate sign. All arithmetic, comparison and the integral
+     * conversions are `constexpr`; the operators, `abs`, `pow` and the roots come from `IntegralBase`.
+     * Division truncates toward zero like `BinaryArithmetic`.
+     * @tparam Bits Width in bits, a positive multiple of 64.
+     * \~russian
+     * @brief Знаковое целое фиксированной ширины `Bits` бит в дополнительном коде, хранится прямо в `std::array`.
+     *
+     * Ведёт себя как встроенное целое такой ширины: результаты берутся по модулю `2^Bits`, нет кучи,
+     * обрезки нулей и отдельного знака. Вся арифметика, сравнение и преобразования в целые — `constexpr`;
+     * операторы, `abs`, `pow` и корни берутся из `IntegralBase`. Деление с усечением к нулю, как у `BinaryArithmetic`.
+     * @tparam Bits Ширина в битах, положительное кратное 64.
+     */
+    template<size_t Bits>
+    class FixedBinary : public IntegralBase<FixedBinary<Bits>> {
+        static_assert(Bits > 0 && Bits % 64 == 0, "Bits must be a positive multiple of 64");
+        using FO = impl::FixedOperations;
+    public:
+        using limb_type = uint64_t;
+        static constexpr size_t LIMBS = Bits / 64;
+        using limbs_type = std::array<limb_type, LIMBS>;
+
+        // --- Конструкторы ---
+        constexpr FixedBinary() noexcept : _limbs{} {}
+
+        // --- Неявный конструктор из целого: знаковое расширение до Bits бит ---
+        template<typename _Ty, typename = std::enable_if_t<std::is_integral<_Ty>::value && !std::is_same_v<_Ty, bool>>>
+        constexpr FixedBinary(_Ty value) noexcept : _limbs{} {
+            const bool negative = value < 0;
+            _limbs[0] = static_cast<limb_type>(static_cast<std::make_unsigned_t<_Ty>>(value));
+            if (negative) {
+                // Старшие биты младшего слова уже единицы после преобразования в беззнаковый тип
+                if constexpr (sizeof(_Ty) < sizeof(limb_type)) {
+                    _limbs[0] |= ~limb_type(0) << std::numeric_limits<std::make_unsigned_t<_Ty>>::digits;
+                }
+                for (size_t i = 1; i < LIMBS; ++i) _limbs[i] = ~limb_type(0);
+            }
+        }
+
+        /// \~english @brief Value from its two's complement words, least significant first.
+        /// \~russian @brief Значение по словам дополнительного кода, младшее первым.
+        constexpr explicit FixedBinary(const limbs_type& limbs) noexcept : _limbs(limbs) {}
+
+        /**
+         * \~english
+         * @brief Parses a decimal string with the same rules as `BinaryArithmetic`; usable in constant expressions.
+         * @throws std::invalid_argument if the string is not a decimal integer.
+         * @throws std::overflow_error if the value is outside `[min(), max()]`.
+         * \~russian
+         * @brief Разбирает десятичную строку по тем же правилам, что и `BinaryArithmetic`; годится для константных выражений.
+         * @throws std::invalid_argument Если строка — не десятичное целое.
+         * @throws std::overflow_error Если значение вне `[min(), max()]`.
+         */
+        constexpr FixedBinary(std::string_view value) : _limbs{} {
+            if (!impl::BigNumberOperations::is_integral_valid_string(value)) {
+                throw std::invalid_argument("Invalid input string for FixedBinary");
+            }
+            const bool negative = value.front() == '-';
+            if (negative) value.remove_prefix(1);
+            if (!FO::set_str(_limbs, value, 10)) throw std::overflow_error("Value exceeds the bit width of FixedBinary");
+            if (negative) FO::negate(_limbs);
+            if (sign() != negative && !FO::is_zero(_limbs)) throw std::overflow_error("Value exceeds the bit width of FixedBinary");
+        }
+        constexpr FixedBinary(const char* value) : FixedBinary(std::string_view(value)) {}
+
+        /// \~english @brief Sign-extending conversion from a narrower width.
+        /// \~russian @brief Преобразование из меньшей ширины со знаковым расширением.
+        template<size_t OtherBits, typename std::enable_if_t<(OtherBits < Bits), int> = 0>
+        constexpr FixedBinary(const FixedBinary<OtherBits>& other) noexcept : _limbs{} { assign_words(other); }
+        /// \~english @brief Conversion from a wider width that keeps the low `Bits` bits, like between built-in integers.
+        /// \~russian @brief Преобразование из большей ширины с сохранением младших `Bits` бит, как между встроенными целыми.
+        template<size_t OtherBits, typename std::enable_if_t<(OtherBits > Bits), int> = 0>
+        constexpr explicit FixedBinary(const FixedBinary<OtherBits>& other) noexcept : _limbs{} { assign_words(other); }
+
+        /// \~english @brief Exact conversion from the dynamic type. @throws std::overflow_error if `value` is outside `[min(), max()]`.
+        /// \~russian @brief Точное преобразование из динамического типа. @throws std::overflow_error Если `value` вне `[min(), max()]`.
+        explicit FixedBinary(const BinaryArithmetic& value) : _limbs{} {
+            // Хранилище без ведущих нулей: больше LIMBS слов — заведомо не помещается
+            const auto& data = value._storage.data();
+            if (data.size() > LIMBS) throw std::overflow_error("Value exceeds the bit width of FixedBinary");
+            for (size_t i = 0; i < data.size(); ++i) _limbs[i] = data[i];
+            if (value.sign()) FO::negate(_limbs);
+            // Знак после приведения должен совпасть со знаком исходного числа
+            if (sign() != value.sign() && !FO::is_zero(_limbs)) throw std::overflow_error("Value exceeds the bit width of FixedBinary");
+        }
+
+        /// \~english @brief Exact conversion to the dynamic type (implicit: no value is lost).
+        /// \~russian @brief Точное преобразование в динамический тип (неявное: значение не теряется).
+        operator BinaryArithmetic() const {
+            BinaryArithmetic result;
+            const limbs_type magnitude = this->magnitude();
+            auto& data = result._storage.data();
+            data.assign(magnitude.begin(), magnitude.end());
+            result.trim_leading_zeros();
+            if (!FO::is_zero(magnitude)) result.sign(sign());
+            return result;
+        }
+
+        /// \~english @brief The low bits of the value, like a conversion between built-in integers.
+        /// \~russian @brief Младшие биты значения, как при преобразовании между встроенными целыми.
+        template<typename _Ty, typename = std::enable_if_t<std::is_integral<_Ty>::value && !std::is_same_v<_Ty, bool>>>
+        [[nodiscard]] constexpr explicit operator _Ty() const noexcept {
+            return static_cast<_Ty>(_limbs[0]);
+        }
+
+        /// \~english @brief The largest value, `2^(Bits - 1) - 1`.
+        /// \~russian @brief Наибольшее значение, `2^(Bits - 1) - 1`.
+        [[nodiscard]] static constexpr FixedBinary max() noexcept {
+            FixedBinary result;
+            for (limb_type& limb : result._limbs) limb = ~limb_type(0);
+            result._limbs[LIMBS - 1] >>= 1;
+            return result;
+        }
+        /// \~english @brief The smallest value, `-2^(Bits - 1)`.
+        /// \~russian @brief Наименьшее значение, `-2^(Bits - 1)`.
+        [[nodiscard]] static constexpr FixedBinary min() noexcept {
+            FixedBinary result;
+            result._limbs[LIMBS - 1] = limb_type(1) << 63;
+            return result;
+        }
+
+        /// \~english @brief Two's complement words, least significant first.
+        /// \~russian @brief Слова дополнительного кода, младшее первым.
+        [[nodiscard]] constexpr const limbs_type& limbs() const noexcept { return _limbs; }
+
+        [[nodiscard]] constexpr int compare(const FixedBinary& other) const noexcept {
+            // Старшее слово сравнивается со знаком, остальные — без
+            const auto top = static_cast<int64_t>(_limbs[LIMBS - 1]);
+            const auto other_top = static_cast<int64_t>(other._limbs[LIMBS - 1]);
+            if (top != other_top) return top < other_top ? -1 : 1;
+            for (size_t i = LIMBS - 1; i-- > 0;) {
+                if (_limbs[i] != other._limbs[i]) return _limbs[i] < other._limbs[i] ? -1 : 1;
+            }
+            return 0;
+        }
+        [[nodiscard]] constexpr FixedBinary add(const FixedBinary& other) const noexcept {
+            FixedBinary result(*this);
+            result.add_assign(other);
+            return result;
+        }
+        [[nodiscard]] constexpr FixedBinary subtract(const FixedBinary& other) const noexcept {
+            FixedBinary result(*this);
+            result.subtract_assign(other);
+            return result;
+        }
+        // Младшие Bits бит произведения одинаковы для знаковых и беззнаковых сомножителей
+        [[nodiscard]] constexpr FixedBinary multiply(const FixedBinary& other) const noexcept {
+            FixedBinary result;
+            result._limbs = FO::mul<LIMBS>(_limbs, other._limbs);
+            return result;
+        }
+        [[nodiscard]] constexpr FixedBinary divide(const FixedBinary& other) const { return divmod(other).first; }
+        [[nodiscard]] constexpr FixedBinary modulo(const FixedBinary& other) const { return divmod(other).second; }
+        // Частное с усечением к нулю и остаток со знаком делимого; min() / -1 == min()
+        [[nodiscard]] constexpr std::pair<FixedBinary, FixedBinary> divmod(const FixedBinary& other) const {
+            if (FO::is_zero(other._limbs)) throw std::overflow_error("Division by zero");
+            FixedBinary quotient, remainder;
+            FO::divrem(quotient._limbs, remainder._limbs, magnitude(), other.magnitude());
+            if (sign() != other.sign()) FO::negate(quotient._limbs);
+            if (sign()) FO::negate(remainder._limbs);
+            return { quotient, remainder };
+        }
+        constexpr void add_assign(const FixedBinary& other) noexcept { FO::add(_limbs, other._limbs); }
+        constexpr void subtract_assign(const FixedBinary& other) noexcept { FO::sub(_limbs, other._limbs); }
+        constexpr void multiply_assign(const FixedBinary& other) noexcept { *this = multiply(other); }
+
+        // Смешанная арифметика с 64-битным скаляром; negative — знак скаляра
+        constexpr void add_small(uint64_t value, bool negative = false) noexcept {
+            if (negative) FO::sub_1(_limbs, value);
+            else          FO::add_1(_limbs, value);
+        }
+        constexpr void mul_small(uint64_t value, bool negative = false) noexcept {
+            FO::mul_1(_limbs, value);
+            if (negative) FO::negate(_limbs);
+        }
+        // *this /= ±divisor с усечением к нулю, возвращает модуль остатка
+        constexpr uint64_t divmod_small(uint64_t divisor, bool negative = false) {
+            if (divisor == 0) throw std::overflow_error("Division by zero");
+            const bool result_negative = sign() != negative;
+            limbs_type value = magnitude();
+            const uint64_t remainder = FO::divrem_1(value, divisor);
+            _limbs = value;
+            if (result_negative) FO::negate(_limbs);
+            return remainder;
+        }
+        // Модуль остатка |*this| % divisor
+        [[nodiscard]] constexpr uint64_t mod_small(uint64_t divisor) const {
+            if (divisor == 0) throw std::overflow_error("Division by zero");
+            limbs_type value = magnitude();
+            return FO::divrem_1(value, divisor);
+        }
+        // Число бит в |*this| (0 для нуля, Bits для min())
+        [[nodiscard]] constexpr size_t bit_length() const noexcept { return FO::bit_length(magnitude()); }
+
+        // Установка знака меняет знак значения на противоположный, если он отличается (min() остаётся min())
+        constexpr void sign(bool s) noexcept {
+            if (s != sign()) FO::negate(_limbs);
+        }
+        [[nodiscard]] constexpr bool sign() const noexcept { return (_limbs[LIMBS - 1] >> 63) != 0; }
+        [[nodiscard]] constexpr explicit operator bool() const noexcept { return !FO::is_zero(_limbs); }
+
+        friend std::string to_string(const FixedBinary& other) { return to_string(static_cast<BinaryArithmetic>(other)); }
+    private:
+        limbs_type _limbs;      // дополнительный код, младшее слово первым
+
+        template<size_t OtherBits>
+        constexpr void assign_words(const FixedBinary<OtherBits>& other) noexcept {
+            const limb_type fill = other.sign() ? ~limb_type(0) : 0;
+            for (size_t i = 0; i < LIMBS; ++i) _limbs[i] = i < FixedBinary<OtherBits>::LIMBS ? other.limbs()[i] : fill;
+        }
+        // |*this| как беззнаковое число (для min() — 2^(Bits - 1))
+        [[nodiscard]] constexpr limbs_type magnitude() const noexcept {
+            limbs_type result = _limbs;
+            if (sign()) FO::negate(result);
+            return result;
+        }
+    };
+
+    namespace impl {
+        // Верхняя граница числа бит в n!: сумма длин множителей 2..n
+        constexpr size_t factorial_bits(size_t n) noexcept {
+            size_t bits = 1;
+            for (size_t k = 2; k <= n; ++k) bits += static_cast<size_t>(internal::FactorAccess::count_bits(k));
+            return bits;
+        }
+    }
+
+    /**
+     * \~english
+     * @brief Signed factorial number with the coefficients of `1!` .. `MaxIndex!` stored inline.
+     *
+     * Coefficient `k` lies in `[0, k]`, so the magnitude is below `(MaxIndex + 1)!` and results
+     * wrap around modulo `(MaxIndex + 1)!`, keeping their sign. Addition, subtraction and the scalar
+     * operations work on the coefficients directly with local carries; full multiplication and
+     * division go through a fixed-size binary magnitude. Everything is `constexpr` and nothing allocates.
+     * @tparam MaxIndex Index of the highest coefficient.
+     * \~russian
+     * @brief Знаковое факториальное число с коэффициентами при `1!` .. `MaxIndex!`, хранящимися прямо в объекте.
+     *
+     * Коэффициент `k` лежит в `[0, k]`, поэтому модуль меньше `(MaxIndex + 1)!`, а результаты берутся
+     * по модулю `(MaxIndex + 1)!` с сохранением знака. Сложение, вычитание и скалярные операции работают
+     * прямо с коэффициентами и локальными переносами; полное умножение и деление идут через двоичный
+     * модуль фиксированного размера. Всё `constexpr`, память не выделяется.
+     * @tparam MaxIndex Номер старшего коэффициента.
+     */
+    template<size_t MaxIndex>
+    class FixedFactorial : public IntegralBase<FixedFactorial<MaxIndex>> {
+        static_assert(MaxIndex >= 1 && MaxIndex <= 0xFFFFFFFFULL, "MaxIndex must be in [1, 2^32 - 1]");
+        using FO = impl::FixedOperations;
+    public:
+        // Самый узкий тип, вмещающий коэффициент MaxIndex
+        using digit_type = std::conditional_t<(MaxIndex <= 0xFF), uint8_t,
+            std::conditional_t<(MaxIndex <= 0xFFFF), uint16_t, uint32_t>>;
+        static constexpr size_t MAX_INDEX = MaxIndex;
+
+        // --- Конструкторы ---
+        constexpr FixedFactorial() noexcept : _digits{}, _negative(false) {}
+
+        // --- Неявный конструктор из целого (для операций +int и т.д.) ---
+        template<typename _Ty, typename = std::enable_if_t<std::is_integral<_Ty>::value && !std::is_same_v<_Ty, bool>>>
+        constexpr FixedFactorial(_Ty value) noexcept : _digits{}, _negative(false) {
+            const auto [magnitude, negative] = impl::scalar_parts(value);
+            assign_magnitude(std::array<uint64_t, 1>{ magnitude });
+            _negative = negative && !is_zero();
+        }
+
+        /**
+         * \~english
+         * @brief Parses a decimal string with the same rules as `FactorialArithmetic`; usable in constant expressions.
+         * @throws std::invalid_argument if the string is not a decimal integer.
+         * @throws std::overflow_error if the magnitude is not below `(MaxIndex + 1)!`.
+         * \~russian
+         * @brief Разбирает десятичную строку по тем же правилам, что и `FactorialArithmetic`; годится для константных выражений.
+         * @throws std::invalid_argument Если строка — не десятичное целое.
+         * @throws std::overflow_error Если модуль не меньше `(MaxIndex + 1)!`.
+         */
+        constexpr FixedFactorial(std::string_view value) : _digits{}, _negative(false) {
+            if (!impl::BigNumberOperations::is_integral_valid_string(value)) {
+                throw std::invalid_argument("Invalid input string for FixedFactorial");
+            }
+            const bool negative = value.front() == '-';
+            if (negative) value.remove_prefix(1);
+            Magnitude magnitude{};
+            if (!FO::set_str(magnitude, value, 10) || !assign_magnitude(magnitude)) {
+                throw std::overflow_error("Value exceeds the range of FixedFactorial");
+            }
+            _negative = negative && !is_zero();
+        }
+        constexpr FixedFactorial(const char* value) : FixedFactorial(std::string_view(value)) {}
+
+        /// \~english @brief Conversion from fewer coefficients (exact).
+        /// \~russian @brief Преобразование из меньшего числа коэффициентов (точное).
+        template<size_t OtherIndex, typename std::enable_if_t<(OtherIndex < MaxIndex), int> = 0>
+        constexpr FixedFactorial(const FixedFactorial<OtherIndex>& other) noexcept : _digits{}, _negative(false) { assign_digits(other); }
+        /// \~english @brief Conversion from more coefficients: drops those above `MaxIndex`, i.e. reduces the magnitude modulo `(MaxIndex + 1)!`.
+        /// \~russian @brief Преобразование из большего числа коэффициентов: отбрасывает старше `MaxIndex`, то есть берёт модуль по модулю `(MaxIndex + 1)!`.
+        template<size_t OtherIndex, typename std::enable_if_t<(OtherIndex > MaxIndex), int> = 0>
+        constexpr explicit FixedFactorial(const FixedFactorial<OtherIndex>& other) noexcept : _digits{}, _negative(false) { assign_digits(other); }
+        /// \~english @brief Conversion from a fixed binary number; the magnitude is reduced modulo `(MaxIndex + 1)!`.
+        /// \~russian @brief Преобразование из двоичного числа фиксированной ширины; модуль берётся по модулю `(MaxIndex + 1)!`.
+        template<size_t Bits>
+        constexpr explicit FixedFactorial(const FixedBinary<Bits>& value) noexcept : _digits{}, _negative(false) {
+            auto magnitude = value.limbs();
+            if (value.sign()) FO::negate(magnitude);
+            assign_magnitude(magnitude);
+            _negative = value.sign() && !is_zero();
+        }
+
+        /// \~english @brief Exact conversion from the dynamic type. @throws std::overflow_error if a coefficient above `MaxIndex` is nonzero.
+        /// \~russian @brief Точное преобразование из динамического типа. @throws std::overflow_error Если ненулевой коэффициент старше `MaxIndex`.
+        explicit FixedFactorial(const FactorialArithmetic& value) : _digits{}, _negative(false) {
+            for (internal::FactorCursor cursor(value._storage, 1); cursor.valid(); ++cursor) {
+                const uint64_t digit = *cursor;
+                if (cursor.index() > MaxIndex) {
+                    if (digit != 0) throw std::overflow_error("Value exceeds the range of FixedFactorial");
+                    continue;
+                }
+                _digits[cursor.index() - 1] = static_cast<digit_type>(digit);
+            }
+            _negative = value.sign() && !is_zero();
+        }
+
+        /// \~english @brief Exact conversion to the dynamic type (implicit: no value is lost).
+        /// \~russian @brief Точное преобразование в динамический тип (неявное: значение не теряется).
+        operator FactorialArithmetic() const {
+            FactorialArithmetic result;
+            size_t top = MaxIndex;
+            while (top > 0 && _digits[top - 1] == 0) --top;
+            internal::FactorWriter writer(result._storage);
+            for (size_t k = 0; k <= top; ++k) writer.push(k == 0 ? 0 : _digits[k - 1]);
+            result.trim_leading_zeros();
+            if (top != 0) result.sign(_negative);
+            return result;
+        }
+
+        /// \~english @brief The low bits of the value, like a conversion between built-in integers.
+        /// \~russian @brief Младшие биты значения, как при преобразовании между встроенными целыми.
+        template<typename _Ty, typename = std::enable_if_t<std::is_integral<_Ty>::value && !std::is_same_v<_Ty, bool>>>
+        [[nodiscard]] constexpr explicit operator _Ty() const noexcept {
+            uint64_t low = magnitude()[0];
+            if (_negative) low = uint64_t(0) - low;
+            return static_cast<_Ty>(low);
+        }
+
+        /// \~english @brief Coefficient at `index!` (0 for index 0 and above `MaxIndex`).
+        /// \~russian @brief Коэффициент при `index!` (0 для индекса 0 и старше `MaxIndex`).
+        [[nodiscard]] constexpr uint64_t digit(size_t index) const noexcept {
+            return (index == 0 || index > MaxIndex) ? 0 : _digits[index - 1];
+        }
+
+        [[nodiscard]] constexpr int compare(const FixedFactorial& other) const noexcept {
+            if (_negative != other._negative) return _negative ? -1 : 1;
+            const int order = compare_magnitude(other);
+            return _negative ? -order : order;
+        }
+        [[nodiscard]] constexpr FixedFactorial add(const FixedFactorial& other) const noexcept {
+            FixedFactorial result(*this);
+            result.add_signed(other, other._negative);
+            return result;
+        }
+        [[nodiscard]] constexpr FixedFactorial subtract(const FixedFactorial& other) const noexcept {
+            FixedFactorial result(*this);
+            result.add_signed(other, !other._negative);
+            return result;
+        }
+        // Полное произведение модулей двойной ширины, затем приведение по модулю (MaxIndex + 1)!
+        [[nodiscard]] constexpr FixedFactorial multiply(const FixedFactorial& other) const noexcept {
+            FixedFactorial result;
+            result.assign_magnitude(FO::mul<2 * MAGNITUDE_LIMBS>(magnitude(), other.magnitude()));
+            result._negative = (_negative != other._negative) && !result.is_zero();
+            return result;
+        }
+        [[nodiscard]] constexpr FixedFactorial divide(const FixedFactorial& other) const { return divmod(other).first; }
+        [[nodiscard]] constexpr FixedFactorial modulo(const FixedFactorial& other) const { return divmod(other).second; }
+        // Частное с усечением к нулю и остаток со знаком делимого
+        [[nodiscard]] constexpr std::pair<FixedFactorial, FixedFactorial> divmod(const FixedFactorial& other) const {
+            if (other.is_zero()) throw std::overflow_error("Division by zero");
+            Magnitude quotient{}, remainder{};
+            FO::divrem(quotient, remainder, magnitude(), other.magnitude());
+            FixedFactorial q, r;
+            q.assign_magnitude(quotient);
+            r.assign_magnitude(remainder);
+            q._negative = (_negative != other._negative) && !q.is_zero();
+            r._negative = _negative && !r.is_zero();
+            return { q, r };
+        }
+        constexpr void add_assign(const FixedFactorial& other) noexcept { add_signed(other, other._negative); }
+        constexpr void subtract_assign(const FixedFactorial& other) noexcept { add_signed(other, !other._negative); }
+        constexpr void multiply_assign(const FixedFactorial& other) noexcept { *this = multiply(other); }
+
+        // Смешанная арифметика с 64-битным скаляром; negative — знак скаляра
+        constexpr void add_small(uint64_t value, bool negative = false) noexcept {
+            add_signed(FixedFactorial(value), negative);
+        }
+        // Перенос на каждом шаге не превосходит value, поэтому d_k * value + перенос помещается в два слова
+        constexpr void mul_small(uint64_t value, bool negative = false) noexcept {
+            uint64_t carry = 0;
+            for (size_t k = 1; k <= MaxIndex; ++k) {
+                uint64_t high = 0;
+                uint64_t low = impl::OverflowAwareOps::multiply<uint64_t>(_digits[k - 1], value, high);
+                low += carry;
+                high += low < carry ? 1 : 0;
+                uint64_t digit = 0;
+                carry = FO::divide(high, low, k + 1, digit);
+                _digits[k - 1] = static_cast<digit_type>(digit);
+            }
+            _negative = (_negative != negative) && !is_zero();
+        }
+        // *this /= ±divisor с усечением к нулю, возвращает модуль остатка
+        constexpr uint64_t divmod_small(uint64_t divisor, bool negative = false) {
+            if (divisor == 0) throw std::overflow_error("Division by zero");
+            const uint64_t remainder = divide_digits(divisor, true);
+            _negative = (_negative != negative) && !is_zero();
+            return remainder;
+        }
+        // Модуль остатка |*this| % divisor
+        [[nodiscard]] constexpr uint64_t mod_small(uint64_t divisor) const {
+            if (divisor == 0) throw std::overflow_error("Division by zero");
+            FixedFactorial copy(*this);
+            return copy.divide_digits(divisor, false);
+        }
+        // Число бит в двоичной записи |*this| (0 для нуля)
+        [[nodiscard]] constexpr size_t bit_length() const noexcept { return FO::bit_length(magnitude()); }
+
+        constexpr void sign(bool s) noexcept { _negative = s && !is_zero(); }
+        [[nodiscard]] constexpr bool sign() const noexcept { return _negative; }
+        [[nodiscard]] constexpr explicit operator bool() const noexcept { return !is_zero(); }
+
+        friend std::string to_string(const FixedFactorial& other) { return to_string(static_cast<FactorialArithmetic>(other)); }
+    private:
+        // Двоичный модуль: вмещает любое значение меньше (MaxIndex + 1)!
+        static constexpr size_t MAGNITUDE_LIMBS = (impl::factorial_bits(MaxIndex + 1) + 63) / 64;
+        using Magnitude = std::array<uint64_t, MAGNITUDE_LIMBS>;
+
+        std::array<digit_type, MaxIndex> _digits;  // _digits[k - 1] — коэффициент при k!
+        bool _negative;
+
+        [[nodiscard]] constexpr bool is_zero() const noexcept {
+            for (digit_type d : _digits) {
+                if (d != 0) return false;
+            }
+            return true;
+        }
+        [[nodiscard]] constexpr int compare_magnitude(const FixedFactorial& other) const noexcept {
+            for (size_t k = MaxIndex; k-- > 0;) {
+                if (_digits[k] != other._digits[k]) return _digits[k] < other._digits[k] ? -1 : 1;
+            }
+            return 0;
+        }
+        // *this += (other_sign ? -|other| : |other|); перенос за MaxIndex отбрасывается
+        constexpr void add_signed(const FixedFactorial& other, bool other_sign) noexcept {
+            if (_negative == other_sign) {
+                uint64_t carry = 0;
+                for (size_t k = 1; k <= MaxIndex; ++k) {
+                    uint64_t digit = _digits[k - 1] + uint64_t(other._digits[k - 1]) + carry;
+                    carry = digit > k ? 1 : 0;
+                    _digits[k - 1] = static_cast<digit_type>(carry != 0 ? digit - (k + 1) : digit);
+                }
+            }
+            else {
+                // Из большего модуля вычитается меньший, знак — у большего
+                const bool swap = compare_magnitude(other) < 0;
+                const FixedFactorial& minuend = swap ? other : *this;
+                const FixedFactorial& subtrahend = swap ? *this : other;
+                std::array<digit_type, MaxIndex> result{};
+                uint64_t borrow = 0;
+                for (size_t k = 1; k <= MaxIndex; ++k) {
+                    const uint64_t take = subtrahend._digits[k - 1] + borrow;
+                    borrow = minuend._digits[k - 1] < take ? 1 : 0;
+                    result[k - 1] = static_cast<digit_type>(minuend._digits[k - 1] + borrow * (k + 1) - take);
+                }
+                _digits = result;
+                if (swap) _negative = other_sign;
+            }
+            if (is_zero()) _negative = false;
+        }
+        // Деление коэффициентов на divisor сверху вниз; остаток каждого шага переходит в единицы k!
+        constexpr uint64_t divide_digits(uint64_t divisor, bool store) noexcept {
+            uint64_t remainder = 0;
+            for (size_t k = MaxIndex; k >= 1; --k) {
+                uint64_t high = 0;
+                uint64_t low = impl::OverflowAwareOps::multiply<uint64_t>(remainder, k + 1, high);
+                low += _digits[k - 1];
+                high += low < _digits[k - 1] ? 1 : 0;
+                const uint64_t digit = FO::divide(high, low, divisor, remainder);
+                if (store) _digits[k - 1] = static_cast<digit_type>(digit);
+            }
+            return remainder;
+        }
+        // Двоичный модуль по схеме Горнера v = v * (k + 1) + d_k от старшего коэффициента;
+        // шаги объединяются в группы, пока произведение множителей помещается в слово
+        [[nodiscard]] constexpr Magnitude magnitude() const noexcept {
+            Magnitude result{};
+            size_t k = MaxIndex;
+            while (k >= 1) {
+                uint64_t factor = 1, digits = 0;
+                while (k >= 1 && factor <= ~uint64_t(0) / (k + 1)) {
+                    factor *= k + 1;
+                    digits = digits * (k + 1) + _digits[k - 1];
+                    --k;
+                }
+                FO::mul_1(result, factor);
+                FO::add_1(result, digits);
+            }
+            return result;
+        }
+        template<size_t OtherIndex>
+        constexpr void assign_digits(const FixedFactorial<OtherIndex>& other) noexcept {
+            for (size_t k = 1; k <= MaxIndex && k <= OtherIndex; ++k) _digits[k - 1] = static_cast<digit_type>(other.digit(k));
+            _negative = other.sign() && !is_zero();
+        }
+        // Коэффициенты value по модулю (MaxIndex + 1)!; основания k + 1 объединяются в группы по слову.
+        // Возвращает false, если value >= (MaxIndex + 1)! и старшая часть отброшена
+        template<size_t N>
+        constexpr bool assign_magnitude(std::array<uint64_t, N> value) noexcept {
+            size_t k = 1;
+            while (k <= MaxIndex) {
+                if (FO::is_zero(value)) {
+                    for (; k <= MaxIndex; ++k) _digits[k - 1] = 0;
+                    return true;
+                }
+                const size_t first = k;
+                uint64_t factor = 1;
+                while (k <= MaxIndex && factor <= ~uint64_t(0) / (k + 1)) factor *= ++k;
+                uint64_t chunk = FO::divrem_1(value, factor);
+                for (size_t i = first; i < k; ++i) {
+                    _digits[i - 1] = static_cast<digit_type>(chunk % (i + 1));
+                    chunk /= i + 1;
+                }
+            }
+            return FO::is_zero(value);
+        }
+    };
+
+    namespace impl {
+        /**
+         * \~english
+         * @brief Digits of an integer literal passed to a literal operator template, parsed at compile time.
+         *
+         * Accepts every form of a C++ integer literal: decimal, `0x` hexadecimal, `0b` binary,
+         * octal with a leading `0`, and `'` digit separators.
+         * \~russian
+         * @brief Цифры целочисленного литерала, переданные шаблону литерального оператора, разобранные при компиляции.
+         *
+         * Принимает все формы целочисленного литерала C++: десятичную, шестнадцатеричную с `0x`,
+         * двоичную с `0b`, восьмеричную с ведущим `0` и разделители разрядов `'`.
+         */
+        template<char... Chars>
+        struct IntegerLiteral {
+            static constexpr char TEXT[] = { Chars... };
+            static constexpr std::string_view LITERAL{ TEXT, sizeof...(Chars) };
+            static constexpr bool PREFIXED = LITERAL.size() > 2 && LITERAL[0] == '0'
+                && (LITERAL[1] == 'x' || LITERAL[1] == 'X' || LITERAL[1] == 'b' || LITERAL[1] == 'B');
+            static constexpr unsigned RADIX = PREFIXED ? ((LITERAL[1] == 'x' || LITERAL[1] == 'X') ? 16 : 2)
+                : (LITERAL.size() > 1 && LITERAL[0] == '0') ? 8 : 10;
+            static constexpr std::string_view DIGITS = LITERAL.substr(PREFIXED ? 2 : (RADIX == 8 ? 1 : 0));
+            // Не больше 4 бит на цифру
+            static constexpr size_t BOUND_LIMBS = DIGITS.size() * 4 / 64 + 1;
+
+            static constexpr std::array<uint64_t, BOUND_LIMBS> parse() {
+                std::array<uint64_t, BOUND_LIMBS> value{};
+                FixedOperations::set_str(value, DIGITS, RADIX, true);
+                return value;
+            }
+            static constexpr std::array<uint64_t, BOUND_LIMBS> MAGNITUDE = parse();
+            // Ширина на бит больше модуля — под знак, с округлением до слова
+            static constexpr size_t BITS = (FixedOperations::bit_length(MAGNITUDE) / 64 + 1) * 64;
+
+            // Наименьший MaxIndex, для которого модуль меньше (MaxIndex + 1)!
+            static constexpr size_t factorial_index() {
+                std::array<uint64_t, BOUND_LIMBS> value = MAGNITUDE;
+                size_t index = 1;
+                FixedOperations::divrem_1(value, 2);
+                while (!FixedOperations::is_zero(value)) FixedOperations::divrem_1(value, ++index + 1);
+                return index;
+            }
+        };
+    }
+
+    /**
+     * \~english
+     * @brief User-defined literals that build fixed-width numbers at compile time: `using namespace numsystem::literals;`.
+     *
+     * `123456789012345678901234567890_bi` is a `FixedBinary` just wide enough for the value, `720_fi` a
+     * `FixedFactorial` with just enough coefficients. Both convert implicitly to wider fixed types and to
+     * `BinaryArithmetic` / `FactorialArithmetic` by copying their digits, so no string is parsed at run time.
+     * \~russian
+     * @brief Пользовательские литералы, строящие числа фиксированной ширины при компиляции: `using namespace numsystem::literals;`.
+     *
+     * `123456789012345678901234567890_bi` — `FixedBinary` минимальной достаточной ширины, `720_fi` —
+     * `FixedFactorial` с минимальным достаточным числом коэффициентов. Оба неявно преобразуются в более широкие
+     * фиксированные типы и в `BinaryArithmetic` / `FactorialArithmetic` копированием разрядов, без разбора строк во время выполнения.
+     */
+    namespace literals {
+        template<char... Chars>
+        constexpr auto operator""_bi() noexcept {
+            using Literal = impl::IntegerLiteral<Chars...>;
+            using Result = FixedBinary<Literal::BITS>;
+            typename Result::limbs_type limbs{};
+            for (size_t i = 0; i < Result::LIMBS && i < Literal::BOUND_LIMBS; ++i) limbs[i] = Literal::MAGNITUDE[i];
+            return Result(limbs);
+        }
+        template<char... Chars>
+        constexpr auto operator""_fi() noexcept {
+            using Literal = impl::IntegerLiteral<Chars...>;
+            return FixedFactorial<Literal::factorial_index()>(operator""_bi<Chars...>());
+        }
+    }
+}
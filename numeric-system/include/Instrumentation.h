@@ -0,0 +1,212 @@
+﻿#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \~english
+ * @brief Enables the instrumentation counters and tracing hooks inside the kernels (`0` — disabled).
+ *
+ * Set with the CMake option `NUMSYS_INSTRUMENTATION=ON` (or `-DNUMSYS_INSTRUMENTATION=1`). When disabled
+ * the hooks expand to nothing: the kernels are compiled exactly as without them, and the snapshot is all zeros.
+ * \~russian
+ * @brief Включает счётчики и точки трассировки внутри ядер (`0` — выключено).
+ *
+ * Задаётся опцией CMake `NUMSYS_INSTRUMENTATION=ON` (или `-DNUMSYS_INSTRUMENTATION=1`). В выключенном
+ * состоянии точки измерения раскрываются в пустоту: ядра компилируются так же, как без них, а снимок состоит из нулей.
+ */
+#ifndef NUMSYS_INSTRUMENTATION
+#define NUMSYS_INSTRUMENTATION 0
+#endif
+
+namespace numsystem {
+    /**
+     * \~english
+     * @brief Kind of an instrumented operation.
+     * \~russian
+     * @brief Вид измеряемой операции.
+     */
+    enum class Operation : uint8_t {
+        Add,                ///< \~english `+=`, `+` \~russian `+=`, `+`
+        Subtract,           ///< \~english `-=`, `-` \~russian `-=`, `-`
+        Multiply,           ///< \~english `*` \~russian `*`
+        Divide,             ///< \~english `/`, `%`, `divmod` \~russian `/`, `%`, `divmod`
+        Parse,              ///< \~english Construction from a decimal string (size in characters) \~russian Построение из десятичной строки (размер в символах)
+        Format,             ///< \~english `to_string` \~russian `to_string`
+        Trim,               ///< \~english `trim_leading_zeros` \~russian `trim_leading_zeros`
+        FactorExtract,      ///< \~english Reading one factorial coefficient by index \~russian Чтение одного факториального коэффициента по индексу
+        FactorialToBinary,  ///< \~english Factorial coefficients -> binary limbs \~russian Факториальные коэффициенты -> двоичные слова
+        BinaryToFactorial,  ///< \~english Binary limbs -> factorial coefficients \~russian Двоичные слова -> факториальные коэффициенты
+        Count
+    };
+
+    /**
+     * \~english
+     * @brief Algorithm tier selected by a kernel.
+     * \~russian
+     * @brief Вариант алгоритма, выбранный ядром.
+     */
+    enum class Algorithm : uint8_t {
+        MulBasecase,        ///< \~english Schoolbook multiplication \~russian Умножение «столбиком»
+        MulUnbalanced,      ///< \~english Splitting of an unbalanced product into balanced pieces \~russian Разбиение несбалансированного произведения на сбалансированные части
+        MulKaratsuba,       ///< \~english Karatsuba \~russian Карацуба
+        MulToom3,           ///< \~english Toom-3 \~russian Тоом-3
+        MulNtt,             ///< \~english Three-prime NTT \~russian NTT по трём простым
+        DivSingleLimb,      ///< \~english Division by a one-limb divisor \~russian Деление на однословный делитель
+        DivKnuth,           ///< \~english Knuth's algorithm D \~russian Алгоритм D Кнута
+        FormatBasecase,     ///< \~english Decimal output by repeated division \~russian Десятичный вывод последовательным делением
+        FormatDivideConquer,///< \~english Decimal output split by powers of ten \~russian Десятичный вывод с делением по степеням десяти
+        ParseBasecase,      ///< \~english Decimal input chunk by chunk \~russian Десятичный разбор по кускам
+        ParseDivideConquer, ///< \~english Decimal input split by powers of ten \~russian Десятичный разбор с делением по степеням десяти
+        Count
+    };
+
+    /// \~english @brief Number of operand size buckets: bucket `b` holds sizes of `[2^(b-1), 2^b)` limbs, the last one everything above.
+    /// \~russian @brief Число корзин по размеру операнда: корзина `b` — размеры `[2^(b-1), 2^b)` слов, последняя — всё, что больше.
+    inline constexpr size_t SIZE_BUCKETS = 32;
+    inline constexpr size_t OPERATION_KINDS = static_cast<size_t>(Operation::Count);
+    inline constexpr size_t ALGORITHM_KINDS = static_cast<size_t>(Algorithm::Count);
+
+    /**
+     * \~english
+     * @brief Copy of all instrumentation counters taken at one moment.
+     * \~russian
+     * @brief Копия всех счётчиков, снятая в один момент.
+     */
+    struct InstrumentationSnapshot {
+        /// \~english @brief `operations[kind][bucket]` — operations by kind and operand size bucket (in storage limbs).
+        /// \~russian @brief `operations[kind][bucket]` — операции по виду и корзине размера операнда (в словах хранилища).
+        std::array<std::array<uint64_t, SIZE_BUCKETS>, OPERATION_KINDS> operations{};
+        /// \~english @brief How many times each algorithm tier was selected (recursive steps included).
+        /// \~russian @brief Сколько раз выбран каждый вариант алгоритма (с учётом рекурсивных шагов).
+        std::array<uint64_t, ALGORITHM_KINDS> algorithms{};
+        /// \~english @brief Heap blocks taken by number storages when they outgrow their capacity.
+        /// \~russian @brief Блоки в куче, взятые хранилищами чисел при выходе за ёмкость.
+        uint64_t reallocations = 0;
+        /// \~english @brief Total size of those blocks in bytes.
+        /// \~russian @brief Суммарный размер этих блоков в байтах.
+        uint64_t bytes_allocated = 0;
+
+        /// \~english @brief Operations of `kind` over all size buckets.
+        /// \~russian @brief Операции вида `kind` по всем корзинам размера.
+        [[nodiscard]] uint64_t total(Operation kind) const noexcept {
+            uint64_t sum = 0;
+            for (uint64_t count : operations[static_cast<size_t>(kind)]) sum += count;
+            return sum;
+        }
+        [[nodiscard]] uint64_t count(Algorithm tier) const noexcept { return algorithms[static_cast<size_t>(tier)]; }
+    };
+
+    /**
+     * \~english
+     * @brief Callback invoked when a traced operation finishes: its kind, operand size in limbs and duration.
+     *
+     * Called on the thread that ran the operation, so it must be thread-safe and cheap; `context` is the
+     * pointer passed to `set_trace_hook`.
+     * \~russian
+     * @brief Функция, вызываемая по завершении трассируемой операции: вид, размер операнда в словах и длительность.
+     *
+     * Вызывается в потоке, выполнившем операцию, поэтому должна быть потокобезопасной и быстрой; `context` — указатель,
+     * переданный в `set_trace_hook`.
+     */
+    using TraceHook = void (*)(void* context, Operation operation, size_t limbs, std::chrono::nanoseconds duration);
+
+    /// \~english @brief Whether the library was built with `NUMSYS_INSTRUMENTATION`.
+    /// \~russian @brief Собрана ли библиотека с `NUMSYS_INSTRUMENTATION`.
+    [[nodiscard]] constexpr bool instrumentation_enabled() noexcept { return NUMSYS_INSTRUMENTATION != 0; }
+
+    /// \~english @brief Current values of all counters (zeros when instrumentation is disabled).
+    /// \~russian @brief Текущие значения всех счётчиков (нули, если измерение выключено).
+    [[nodiscard]] InstrumentationSnapshot instrumentation_snapshot() noexcept;
+    /// \~english @brief Resets all counters to zero.
+    /// \~russian @brief Обнуляет все счётчики.
+    void reset_instrumentation() noexcept;
+    /**
+     * \~english
+     * @brief Installs `hook` (`nullptr` removes it) for the timed operations: arithmetic, parsing, formatting and radix conversion.
+     *
+     * Meant to be set once at startup: an operation already running when the hook changes may report to either one.
+     * Has no effect when instrumentation is disabled.
+     * \~russian
+     * @brief Устанавливает `hook` (`nullptr` — снимает) для замеряемых операций: арифметики, разбора, вывода и перевода между системами.
+     *
+     * Рассчитано на установку один раз при запуске: операция, выполняющаяся в момент замены, может сообщить любому из них.
+     * В выключенном состоянии ничего не делает.
+     */
+    void set_trace_hook(TraceHook hook, void* context = nullptr) noexcept;
+
+    namespace impl {
+        // Счётчики общие для всех потоков; приращения relaxed, снимок не атомарен как целое
+        struct InstrumentationCounters {
+            std::array<std::array<std::atomic<uint64_t>, SIZE_BUCKETS>, OPERATION_KINDS> operations{};
+            std::array<std::atomic<uint64_t>, ALGORITHM_KINDS> algorithms{};
+            std::atomic<uint64_t> reallocations{ 0 };
+            std::atomic<uint64_t> bytes_allocated{ 0 };
+            std::atomic<TraceHook> hook{ nullptr };
+            std::atomic<void*> context{ nullptr };
+        };
+        inline InstrumentationCounters& instrumentation_counters() noexcept {
+            static InstrumentationCounters counters;
+            return counters;
+        }
+
+        // Номер корзины — число значащих бит размера
+        constexpr size_t size_bucket(size_t limbs) noexcept {
+            size_t bucket = 0;
+            while (limbs != 0 && bucket + 1 < SIZE_BUCKETS) {
+                limbs >>= 1;
+                ++bucket;
+            }
+            return bucket;
+        }
+
+        inline void count_operation(Operation kind, size_t limbs) noexcept {
+            instrumentation_counters().operations[static_cast<size_t>(kind)][size_bucket(limbs)].fetch_add(1, std::memory_order_relaxed);
+        }
+        inline void count_algorithm(Algorithm tier) noexcept {
+            instrumentation_counters().algorithms[static_cast<size_t>(tier)].fetch_add(1, std::memory_order_relaxed);
+        }
+        inline void count_allocation(size_t bytes) noexcept {
+            InstrumentationCounters& counters = instrumentation_counters();
+            counters.reallocations.fetch_add(1, std::memory_order_relaxed);
+            counters.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+        }
+
+        // Считает операцию и, если установлен hook, замеряет её длительность до конца области видимости
+        class ScopedTrace {
+        public:
+            ScopedTrace(Operation kind, size_t limbs) noexcept : _kind(kind), _limbs(limbs) {
+                count_operation(kind, limbs);
+                _hook = instrumentation_counters().hook.load(std::memory_order_acquire);
+                if (_hook != nullptr) _start = std::chrono::steady_clock::now();
+            }
+            ~ScopedTrace() {
+                if (_hook == nullptr) return;
+                const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start);
+                _hook(instrumentation_counters().context.load(std::memory_order_relaxed), _kind, _limbs, duration);
+            }
+            ScopedTrace(const ScopedTrace&) = delete;
+            ScopedTrace& operator=(const ScopedTrace&) = delete;
+        private:
+            Operation _kind;
+            size_t _limbs;
+            TraceHook _hook = nullptr;
+            std::chrono::steady_clock::time_point _start{};
+        };
+    }
+}
+
+// Точки измерения в ядрах; при NUMSYS_INSTRUMENTATION == 0 раскрываются в пустоту
+#if NUMSYS_INSTRUMENTATION
+#define NUMSYS_COUNT_OPERATION(kind, limbs) ::numsystem::impl::count_operation(::numsystem::Operation::kind, (limbs))
+#define NUMSYS_TRACE_OPERATION(kind, limbs) const ::numsystem::impl::ScopedTrace numsys_trace_scope_(::numsystem::Operation::kind, (limbs))
+#define NUMSYS_COUNT_ALGORITHM(tier) ::numsystem::impl::count_algorithm(::numsystem::Algorithm::tier)
+#define NUMSYS_COUNT_ALLOCATION(bytes) ::numsystem::impl::count_allocation(bytes)
+#else
+#define NUMSYS_COUNT_OPERATION(kind, limbs) ((void)0)
+#define NUMSYS_TRACE_OPERATION(kind, limbs) ((void)0)
+#define NUMSYS_COUNT_ALGORITHM(tier) ((void)0)
+#define NUMSYS_COUNT_ALLOCATION(bytes) ((void)0)
+#endif
@@ -8,9 +8,44 @@
 #include <stdexcept>
 #include <algorithm>
 #include <optional>
+#include <utility>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include "Instrumentation.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * \~english
+ * @brief Number of bytes `impl::Storage` keeps inline before spilling to the heap.
+ *
+ * The default (32 bytes = 256 bits) covers the typical values without any allocation.
+ * Can be overridden at build time (e.g. `-DNUMSYS_STORAGE_INLINE_BYTES=16`); `0` disables the inline buffer.
+ * \~russian
+ * @brief Количество байт, которое `impl::Storage` хранит внутри объекта до перехода в кучу.
+ *
+ * Значение по умолчанию (32 байта = 256 бит) покрывает типичные значения без выделения памяти.
+ * Может быть переопределено при сборке (например, `-DNUMSYS_STORAGE_INLINE_BYTES=16`); `0` отключает встроенный буфер.
+ */
+#ifndef NUMSYS_STORAGE_INLINE_BYTES
+#define NUMSYS_STORAGE_INLINE_BYTES 32
+#endif
 
 namespace numsystem {
     namespace impl {
+#if defined(__SIZEOF_INT128__)
+        /// \~english @brief Compiler 128-bit unsigned type; `__extension__` keeps `-Wpedantic` quiet.
+        /// \~russian @brief 128-битный беззнаковый тип компилятора; `__extension__` избавляет от предупреждений `-Wpedantic`.
+        __extension__ typedef unsigned __int128 uint128_t;
+#endif
+
         /**
          * \~english
          * @brief Structure to store sign and a 63-bit value.
@@ -108,22 +143,345 @@ namespace numsystem {
 
         /**
          * \~english
-         * @brief A template class for storing large numbers using a `std::vector` of integral types.
+         * @brief The memory resource new numbers on this thread allocate from; `nullptr` means the default resource.
+         *
+         * Set through `numsystem::ScopedMemoryResource`, not directly.
+         * \~russian
+         * @brief Ресурс памяти, из которого выделяют память новые числа в этом потоке; `nullptr` — ресурс по умолчанию.
+         *
+         * Устанавливается через `numsystem::ScopedMemoryResource`, а не напрямую.
+         */
+        inline std::pmr::memory_resource*& current_resource_slot() noexcept {
+            static thread_local std::pmr::memory_resource* resource = nullptr;
+            return resource;
+        }
+        /**
+         * \~english
+         * @brief Returns the memory resource temporaries on this thread should allocate from.
+         * \~russian
+         * @brief Возвращает ресурс памяти, из которого в этом потоке выделяются временные буферы.
+         */
+        inline std::pmr::memory_resource* current_resource() noexcept {
+            std::pmr::memory_resource* resource = current_resource_slot();
+            return resource != nullptr ? resource : std::pmr::get_default_resource();
+        }
+
+        /**
+         * \~english
+         * @brief A vector of trivially copyable elements with `N` elements stored inline.
+         * @tparam T The element type.
+         * @tparam N The inline capacity; the buffer moves to the heap only when it grows beyond it.
+         *
+         * Offers the subset of the `std::vector` interface used by the storage and the limb
+         * kernels: contiguous `data()`, `resize()`, `push_back()`, iterators, etc. New elements
+         * are value-initialized unless a value is given. Once on the heap the buffer stays there
+         * (like `std::vector`, shrinking does not release memory).
+         *
+         * Heap memory comes from a `std::pmr::memory_resource` fixed at construction: the one
+         * current on the thread (see `numsystem::ScopedMemoryResource`) unless given explicitly.
+         * As with `std::pmr` containers, a copy takes the current resource, and a move steals the
+         * heap block only when both buffers use the same resource (otherwise it copies).
+         *
+         * `share()` switches a heap buffer to an immutable block with an atomic reference count
+         * (taken from `std::pmr::new_delete_resource()`, so any thread may drop the last reference).
+         * Copies and moves of a shared buffer take another reference in O(1); the first non-const access
+         * through any of them copies the elements into a private buffer (copy-on-write). Shrinking,
+         * `pop_back()` and `clear()` need no copy. Reading never writes the block, so copies on different
+         * threads may read and detach concurrently without locks.
+         * \~russian
+         * @brief Вектор тривиально копируемых элементов, первые `N` из которых хранятся внутри объекта.
+         * @tparam T Тип элемента.
+         * @tparam N Встроенная ёмкость; буфер переходит в кучу только когда вырастает больше неё.
+         *
+         * Предоставляет ту часть интерфейса `std::vector`, которой пользуются хранилище и операции над
+         * словами: непрерывный `data()`, `resize()`, `push_back()`, итераторы и т. д. Новые элементы
+         * инициализируются нулём, если значение не задано. Попав в кучу, буфер там и остаётся
+         * (как и у `std::vector`, уменьшение размера память не освобождает).
+         *
+         * Память в куче берётся из `std::pmr::memory_resource`, выбранного при создании: текущего
+         * для потока (см. `numsystem::ScopedMemoryResource`), если не указан явно. Как и у контейнеров
+         * `std::pmr`, копия получает текущий ресурс, а перемещение забирает блок из кучи только при
+         * совпадении ресурсов (иначе копирует).
+         *
+         * `share()` переводит буфер из кучи в неизменяемый блок с атомарным счётчиком ссылок
+         * (из `std::pmr::new_delete_resource()`, поэтому последнюю ссылку может отпустить любой поток).
+         * Копии и перемещения общего буфера берут ещё одну ссылку за O(1); первый неконстантный доступ
+         * через любую из них копирует элементы в собственный буфер (копирование при записи). Уменьшению
+         * размера, `pop_back()` и `clear()` копия не нужна. Чтение блок не меняет, поэтому копии в разных
+         * потоках могут читать его и отделяться одновременно без блокировок.
+         */
+        template <typename T, size_t N>
+        class SmallBuffer {
+            static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable");
+        public:
+            using value_type = T;
+            using size_type = size_t;
+            using iterator = T*;
+            using const_iterator = const T*;
+            using reverse_iterator = std::reverse_iterator<iterator>;
+            using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+            /// \~english @brief Number of elements stored inline.
+            /// \~russian @brief Количество элементов, хранимых внутри объекта.
+            static constexpr size_t INLINE_CAPACITY = N;
+        private:
+            // Заголовок общего блока; элементы идут сразу за ним
+            struct SharedHeader {
+                std::atomic<size_t> refs;
+                size_t capacity;
+            };
+            static constexpr size_t HEADER_SIZE = (sizeof(SharedHeader) + alignof(T) - 1) / alignof(T) * alignof(T);
+            // capacity_ общего буфера: писать в блок нельзя. Настоящая ёмкость такой быть не может, в том числе при N == 0
+            static constexpr size_t SHARED = std::numeric_limits<size_t>::max();
+
+            T* data_;
+            size_t size_;
+            size_t capacity_;
+            std::pmr::memory_resource* resource_;   // nullptr — ресурс по умолчанию на момент выделения
+            T inline_[N > 0 ? N : 1];
+
+            [[nodiscard]] bool is_inline() const noexcept { return data_ == inline_; }
+            [[nodiscard]] SharedHeader* header() const noexcept {
+                return reinterpret_cast<SharedHeader*>(reinterpret_cast<std::byte*>(data_) - HEADER_SIZE);
+            }
+            void release() noexcept {
+                if (capacity_ == SHARED) {
+                    SharedHeader* block = header();
+                    if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        const size_t bytes = HEADER_SIZE + block->capacity * sizeof(T);
+                        block->~SharedHeader();
+                        std::pmr::new_delete_resource()->deallocate(block, bytes, alignof(SharedHeader));
+                    }
+                }
+                else if (!is_inline()) get_resource()->deallocate(data_, capacity_ * sizeof(T), alignof(T));
+            }
+            // Берёт ещё одну ссылку на общий блок other
+            void adopt(const SmallBuffer& other) noexcept {
+                other.header()->refs.fetch_add(1, std::memory_order_relaxed);
+                release();
+                data_ = other.data_;
+                size_ = other.size_;
+                capacity_ = SHARED;
+            }
+            // Перед записью: общий блок копируется в собственный буфер
+            void detach() {
+                if (capacity_ == SHARED) grow(size_ > N ? size_ : N);
+            }
+            // Переносит содержимое в буфер ёмкостью не меньше capacity
+            void grow(size_t capacity) {
+                if (capacity_ != SHARED) capacity = std::max(capacity, capacity_ * 2);
+                if (capacity <= N && capacity_ == SHARED) {
+                    // Отделение небольшого общего буфера: хватает встроенного места
+                    std::copy(data_, data_ + size_, inline_);
+                    release();
+                    data_ = inline_;
+                    capacity_ = N;
+                    return;
+                }
+                T* fresh = static_cast<T*>(get_resource()->allocate(capacity * sizeof(T), alignof(T)));
+                NUMSYS_COUNT_ALLOCATION(capacity * sizeof(T));
+                std::copy(data_, data_ + size_, fresh);
+                release();
+                data_ = fresh;
+                capacity_ = capacity;
+            }
+        public:
+            SmallBuffer() noexcept : SmallBuffer(current_resource_slot()) {}
+            /// \~english @brief Creates an empty buffer that allocates from `resource` (`nullptr` — the default resource).
+            /// \~russian @brief Создаёт пустой буфер, выделяющий память из `resource` (`nullptr` — ресурс по умолчанию).
+            explicit SmallBuffer(std::pmr::memory_resource* resource) noexcept
+                : data_(inline_), size_(0), capacity_(N), resource_(resource) {}
+            explicit SmallBuffer(size_t count, T val = T()) : SmallBuffer() { resize(count, val); }
+            SmallBuffer(std::initializer_list<T> init) : SmallBuffer() { assign(init.begin(), init.end()); }
+            SmallBuffer(const SmallBuffer& other) : SmallBuffer() {
+                if (other.shared()) adopt(other);
+                else assign(other.begin(), other.end());
+            }
+            SmallBuffer(SmallBuffer&& other) noexcept : SmallBuffer(other.resource_) { *this = std::move(other); }
+            ~SmallBuffer() { release(); }
+
+            SmallBuffer& operator=(const SmallBuffer& other) {
+                if (this == &other) return *this;
+                if (other.shared()) adopt(other);
+                else assign(other.begin(), other.end());
+                return *this;
+            }
+            SmallBuffer& operator=(SmallBuffer&& other) noexcept {
+                if (this == &other) return *this;
+                if (other.shared()) {
+                    // Общий блок не привязан к ресурсу: ссылка просто переходит
+                    release();
+                    data_ = other.data_;
+                    size_ = other.size_;
+                    capacity_ = SHARED;
+                    other.data_ = other.inline_;
+                    other.capacity_ = N;
+                }
+                else if (other.is_inline() || get_resource() != other.get_resource()) {
+                    // Чужой буфер внутри объекта или из другого ресурса: копируем, свою память оставляем себе
+                    assign(other.begin(), other.end());
+                }
+                else {
+                    release();
+                    data_ = other.data_;
+                    size_ = other.size_;
+                    capacity_ = other.capacity_;
+                    other.data_ = other.inline_;
+                    other.capacity_ = N;
+                }
+                other.size_ = 0;
+                return *this;
+            }
+
+            /// \~english @brief Replaces the contents with the range `[first, last)`.
+            /// \~russian @brief Заменяет содержимое диапазоном `[first, last)`.
+            template <typename It, typename = std::enable_if_t<!std::is_integral_v<It>>>
+            void assign(It first, It last) {
+                const size_t count = static_cast<size_t>(std::distance(first, last));
+                if (capacity_ == SHARED) clear();
+                if (count > capacity_) {
+                    size_ = 0;
+                    grow(count);
+                }
+                std::copy(first, last, data_);
+                size_ = count;
+            }
+            /// \~english @brief Replaces the contents with `count` copies of `val`.
+            /// \~russian @brief Заменяет содержимое `count` копиями `val`.
+            void assign(size_t count, T val) {
+                size_ = 0;
+                resize(count, val);
+            }
+
+            [[nodiscard]] T* data() { detach(); return data_; }
+            [[nodiscard]] const T* data() const noexcept { return data_; }
+            [[nodiscard]] size_t size() const noexcept { return size_; }
+            [[nodiscard]] size_t capacity() const noexcept { return capacity_ == SHARED ? size_ : capacity_; }
+            [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+            /// \~english @brief Checks whether the elements live in a reference-counted block (see `share()`).
+            /// \~russian @brief Проверяет, лежат ли элементы в блоке со счётчиком ссылок (см. `share()`).
+            [[nodiscard]] bool shared() const noexcept { return capacity_ == SHARED; }
+            /**
+             * \~english
+             * @brief Moves the elements into an immutable reference-counted block, unless they fit inline
+             * (an inline copy is already cheap) or are shared already.
+             * \~russian
+             * @brief Переносит элементы в неизменяемый блок со счётчиком ссылок, если они не помещаются
+             * во встроенный буфер (его копия и так дешёвая) и ещё не общие.
+             */
+            void share() {
+                if (capacity_ == SHARED || size_ <= N) return;
+                const size_t bytes = HEADER_SIZE + size_ * sizeof(T);
+                void* memory = std::pmr::new_delete_resource()->allocate(bytes, alignof(SharedHeader));
+                NUMSYS_COUNT_ALLOCATION(bytes);
+                SharedHeader* block = new (memory) SharedHeader{ { 1 }, size_ };
+                T* fresh = reinterpret_cast<T*>(reinterpret_cast<std::byte*>(block) + HEADER_SIZE);
+                std::copy(data_, data_ + size_, fresh);
+                release();
+                data_ = fresh;
+                capacity_ = SHARED;
+            }
+            /// \~english @brief Checks whether the elements currently live on the heap.
+            /// \~russian @brief Проверяет, находятся ли элементы сейчас в куче.
+            [[nodiscard]] bool on_heap() const noexcept { return !is_inline(); }
+            /// \~english @brief Returns the memory resource heap blocks are taken from.
+            /// \~russian @brief Возвращает ресурс памяти, из которого берутся блоки в куче.
+            [[nodiscard]] std::pmr::memory_resource* get_resource() const noexcept {
+                return resource_ != nullptr ? resource_ : std::pmr::get_default_resource();
+            }
+
+            [[nodiscard]] T& operator[](size_t index) { detach(); return data_[index]; }
+            [[nodiscard]] const T& operator[](size_t index) const noexcept { return data_[index]; }
+            [[nodiscard]] T& front() { detach(); return data_[0]; }
+            [[nodiscard]] const T& front() const noexcept { return data_[0]; }
+            [[nodiscard]] T& back() { detach(); return data_[size_ - 1]; }
+            [[nodiscard]] const T& back() const noexcept { return data_[size_ - 1]; }
+
+            void reserve(size_t capacity) { if (capacity > this->capacity()) grow(capacity); }
+            void resize(size_t new_size, T val = T()) {
+                if (new_size > capacity()) grow(new_size);
+                if (new_size > size_) std::fill(data_ + size_, data_ + new_size, val);
+                size_ = new_size;
+            }
+            void clear() noexcept {
+                if (capacity_ == SHARED) {
+                    release();
+                    data_ = inline_;
+                    capacity_ = N;
+                }
+                size_ = 0;
+            }
+            void push_back(T val) {
+                if (size_ >= capacity()) grow(size_ + 1);
+                data_[size_++] = val;
+            }
+            void pop_back() noexcept { --size_; }
+            /// \~english @brief Removes the elements in `[first, last)`.
+            /// \~russian @brief Удаляет элементы в диапазоне `[first, last)`.
+            iterator erase(const_iterator first, const_iterator last) {
+                const ptrdiff_t from = first - data_;
+                const ptrdiff_t to = last - data_;
+                detach();
+                T* dest = data_ + from;
+                T* tail = std::copy(data_ + to, data_ + size_, dest);
+                size_ = static_cast<size_t>(tail - data_);
+                return dest;
+            }
+
+            [[nodiscard]] iterator begin() { detach(); return data_; }
+            [[nodiscard]] iterator end() { detach(); return data_ + size_; }
+            [[nodiscard]] const_iterator begin() const noexcept { return data_; }
+            [[nodiscard]] const_iterator end() const noexcept { return data_ + size_; }
+            [[nodiscard]] reverse_iterator rbegin() { return reverse_iterator(end()); }
+            [[nodiscard]] reverse_iterator rend() { return reverse_iterator(begin()); }
+            [[nodiscard]] const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+            [[nodiscard]] const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+            friend void swap(SmallBuffer& a, SmallBuffer& b) noexcept {
+                if (!a.is_inline() && !b.is_inline() && a.get_resource() == b.get_resource()) {
+                    std::swap(a.data_, b.data_);
+                    std::swap(a.size_, b.size_);
+                    std::swap(a.capacity_, b.capacity_);
+                    return;
+                }
+                SmallBuffer tmp(std::move(a));
+                a = std::move(b);
+                b = std::move(tmp);
+            }
+            friend bool operator==(const SmallBuffer& a, const SmallBuffer& b) noexcept {
+                return a.size_ == b.size_ && std::equal(a.begin(), a.end(), b.begin());
+            }
+            friend bool operator!=(const SmallBuffer& a, const SmallBuffer& b) noexcept { return !(a == b); }
+        };
+
+        /**
+         * \~english
+         * @brief Default inline capacity of `Storage<T>` in elements, derived from `NUMSYS_STORAGE_INLINE_BYTES`.
+         * \~russian
+         * @brief Встроенная ёмкость `Storage<T>` по умолчанию (в элементах), вычисляется из `NUMSYS_STORAGE_INLINE_BYTES`.
+         */
+        template <typename T>
+        constexpr size_t default_inline_capacity = NUMSYS_STORAGE_INLINE_BYTES / sizeof(T);
+
+        /**
+         * \~english
+         * @brief A template class for storing large numbers using a small-buffer vector of integral types.
          * @tparam T The integral type used for storing digits (e.g., `uint32_t`, `uint64_t`).
+         * @tparam InlineCapacity Number of digits kept inside the object before the storage spills to the heap.
          *
-         * This class manages the underlying data storage (`std::vector<value_type>`)
+         * This class manages the underlying data storage (`SmallBuffer<value_type, InlineCapacity>`)
          * and the sign of the large number. It provides common vector-like operations
          * and accessors for the number's state (value and sign).
          *
          * \~russian
-         * @brief Шаблонный класс для хранения больших чисел с использованием `std::vector` из целых типов.
+         * @brief Шаблонный класс для хранения больших чисел в векторе целых типов со встроенным буфером.
          * @tparam T Целочисленный тип, используемый для хранения разрядов (например, `uint32_t`, `uint64_t`).
+         * @tparam InlineCapacity Количество разрядов, хранимых внутри объекта до перехода хранилища в кучу.
          *
-         * Этот класс управляет базовым хранилищем данных (`std::vector<value_type>`)
+         * Этот класс управляет базовым хранилищем данных (`SmallBuffer<value_type, InlineCapacity>`)
          * и знаком большого числа. Он предоставляет общие операции, похожие на `std::vector`,
          * и методы доступа к состоянию числа (значению и знаку).
          */
-        template <typename T>
+        template <typename T, size_t InlineCapacity = default_inline_capacity<T>>
         class Storage {
             static_assert(std::is_integral_v<T>, "T must be an integral type");
         public:
@@ -142,13 +500,16 @@ namespace numsystem {
             /// \~english @brief Number of bits in `value_type`.
             /// \~russian @brief Количество бит в `value_type`.
             static constexpr int VALUE_COUNT_BIT = std::numeric_limits<value_type>::digits;
+            /// \~english @brief The container holding the digits.
+            /// \~russian @brief Контейнер, хранящий разряды.
+            using buffer_type = SmallBuffer<value_type, InlineCapacity>;
         private:
             /// \~english @brief Stores the sign and an auxiliary value (e.g., for base conversion hints).
             /// \~russian @brief Хранит знак и вспомогательное значение (например, для подсказок при преобразовании оснований).
             StateInfo state_;
-            /// \~english @brief The underlying vector storing the digits of the large number.
-            /// \~russian @brief Базовый вектор, хранящий разряды большого числа.
-            std::vector<value_type> data_;
+            /// \~english @brief The underlying buffer storing the digits of the large number.
+            /// \~russian @brief Базовый буфер, хранящий разряды большого числа.
+            buffer_type data_;
         public:
             /**
              * \~english
@@ -156,26 +517,35 @@ namespace numsystem {
              * \~russian
              * @brief Конструктор по умолчанию. Инициализирует пустое хранилище с положительным знаком.
              */
-            constexpr Storage() : state_({}), data_(0) {};
+            Storage() noexcept : state_({}), data_() {};
+            /**
+             * \~english
+             * @brief Creates an empty storage whose digits are allocated from `resource`.
+             * @param resource The memory resource; `nullptr` selects the default resource.
+             * \~russian
+             * @brief Создаёт пустое хранилище, разряды которого выделяются из `resource`.
+             * @param resource Ресурс памяти; `nullptr` — ресурс по умолчанию.
+             */
+            explicit Storage(std::pmr::memory_resource* resource) noexcept : state_({}), data_(resource) {};
 
             /**
              * \~english
-             * @brief Provides non-const access to the underlying data vector.
-             * @return A reference to the mutable `std::vector<value_type>`.
+             * @brief Provides non-const access to the underlying data buffer.
+             * @return A reference to the mutable `buffer_type`.
              * \~russian
-             * @brief Предоставляет неконстантный доступ к базовому вектору данных.
-             * @return Ссылка на изменяемый `std::vector<value_type>`.
+             * @brief Предоставляет неконстантный доступ к базовому буферу данных.
+             * @return Ссылка на изменяемый `buffer_type`.
              */
-            std::vector<value_type>& data() { return data_; }
+            buffer_type& data() { return data_; }
             /**
              * \~english
-             * @brief Provides const access to the underlying data vector.
-             * @return A const reference to the `std::vector<value_type>`.
+             * @brief Provides const access to the underlying data buffer.
+             * @return A const reference to the `buffer_type`.
              * \~russian
-             * @brief Предоставляет константный доступ к базовому вектору данных.
-             * @return Константная ссылка на `std::vector<value_type>`.
+             * @brief Предоставляет константный доступ к базовому буферу данных.
+             * @return Константная ссылка на `buffer_type`.
              */
-            const std::vector<value_type>& data() const { return data_; }
+            const buffer_type& data() const { return data_; }
 
             // State access
             /**
@@ -324,13 +694,26 @@ namespace numsystem {
              */
             void resize(size_t new_size, value_type val = 0) { data_.resize(new_size, val); }
 
+            /**
+             * \~english
+             * @brief Switches the digits to a shared reference-counted block (see `SmallBuffer::share()`):
+             * copies become O(1) and the first write through any copy detaches it.
+             * \~russian
+             * @brief Переводит разряды в общий блок со счётчиком ссылок (см. `SmallBuffer::share()`):
+             * копирование становится O(1), а первая запись через любую копию отделяет её.
+             */
+            void share() { data_.share(); }
+            /// \~english @brief Checks whether the digits live in a shared block.
+            /// \~russian @brief Проверяет, лежат ли разряды в общем блоке.
+            [[nodiscard]] bool shared() const noexcept { return data_.shared(); }
+
             // Iterators
             /// \~english @brief Returns an iterator to the beginning.
             /// \~russian @brief Возвращает итератор на начало.
-            [[nodiscard]] auto begin() noexcept { return data_.begin(); }
+            [[nodiscard]] auto begin() { return data_.begin(); }
             /// \~english @brief Returns an iterator to the end.
             /// \~russian @brief Возвращает итератор на конец.
-            [[nodiscard]] auto end() noexcept { return data_.end(); }
+            [[nodiscard]] auto end() { return data_.end(); }
             /// \~english @brief Returns a const iterator to the beginning.
             /// \~russian @brief Возвращает константный итератор на начало.
             [[nodiscard]] auto begin() const noexcept { return data_.begin(); }
@@ -340,10 +723,10 @@ namespace numsystem {
 
             /// \~english @brief Returns a reverse iterator to the beginning.
             /// \~russian @brief Возвращает обратный итератор на начало.
-            [[nodiscard]] auto rbegin() noexcept { return data_.rbegin(); }
+            [[nodiscard]] auto rbegin() { return data_.rbegin(); }
             /// \~english @brief Returns a reverse iterator to the end.
             /// \~russian @brief Возвращает обратный итератор на конец.
-            [[nodiscard]] auto rend() noexcept { return data_.rend(); }
+            [[nodiscard]] auto rend() { return data_.rend(); }
             /// \~english @brief Returns a reverse iterator to the beginning.
             /// \~russian @brief Возвращает обратный итератор на начало.
             [[nodiscard]] auto rbegin() const noexcept { return data_.rbegin(); }
@@ -408,9 +791,180 @@ namespace numsystem {
             template<typename _Ty, typename = std::enable_if_t<std::is_unsigned<_Ty>::value>>
             static constexpr _Ty subtract(_Ty ai, _Ty bi, _Ty& borrow) noexcept {
                 _Ty result = ai - bi - borrow;
-                borrow = (ai < bi + borrow) ? 1 : 0;
+                // bi + borrow может переполниться при bi == max, поэтому сравниваем по частям
+                borrow = (ai < bi || (borrow && ai == bi)) ? 1 : 0;
                 return result;
             }
+
+            /**
+             * \~english
+             * @brief Computes the full double-width product of two unsigned integers.
+             *
+             * Types narrower than 64 bits are widened to the next native type. For `uint64_t`
+             * the product is taken from `unsigned __int128` or `_umul128` when the compiler
+             * provides them, otherwise it is assembled from 32-bit halves.
+             *
+             * @tparam _Ty The unsigned integral type.
+             * @param ai The first operand.
+             * @param bi The second operand.
+             * @param high A reference that receives the high half of the product.
+             * @return The low half of the product.
+             * \~russian
+             * @brief Вычисляет полное произведение двойной ширины двух беззнаковых целых чисел.
+             *
+             * Типы уже 64 бит расширяются до следующего встроенного типа. Для `uint64_t`
+             * произведение берётся из `unsigned __int128` или `_umul128`, если компилятор
+             * их предоставляет, иначе собирается из 32-битных половин.
+             *
+             * @tparam _Ty Беззнаковый целочисленный тип.
+             * @param ai Первый операнд.
+             * @param bi Второй операнд.
+             * @param high Ссылка, в которую записывается старшая половина произведения.
+             * @return Младшая половина произведения.
+             */
+            template<typename _Ty, typename = std::enable_if_t<std::is_unsigned<_Ty>::value>>
+            static constexpr _Ty multiply(_Ty ai, _Ty bi, _Ty& high) noexcept {
+                constexpr int BITS = std::numeric_limits<_Ty>::digits;
+                if constexpr (BITS <= 16) {
+                    uint32_t product = static_cast<uint32_t>(ai) * static_cast<uint32_t>(bi);
+                    high = static_cast<_Ty>(product >> BITS);
+                    return static_cast<_Ty>(product);
+                }
+                else if constexpr (BITS <= 32) {
+                    uint64_t product = static_cast<uint64_t>(ai) * static_cast<uint64_t>(bi);
+                    high = static_cast<_Ty>(product >> BITS);
+                    return static_cast<_Ty>(product);
+                }
+                else {
+#if defined(__SIZEOF_INT128__)
+                    uint128_t product = static_cast<uint128_t>(ai) * bi;
+                    high = static_cast<_Ty>(product >> 64);
+                    return static_cast<_Ty>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+                    unsigned __int64 hi = 0;
+                    _Ty low = static_cast<_Ty>(_umul128(ai, bi, &hi));
+                    high = static_cast<_Ty>(hi);
+                    return low;
+#else
+                    const uint64_t a_lo = static_cast<uint32_t>(ai), a_hi = static_cast<uint64_t>(ai) >> 32;
+                    const uint64_t b_lo = static_cast<uint32_t>(bi), b_hi = static_cast<uint64_t>(bi) >> 32;
+
+                    const uint64_t lo_lo = a_lo * b_lo;
+                    const uint64_t hi_lo = a_hi * b_lo;
+                    const uint64_t lo_hi = a_lo * b_hi;
+                    const uint64_t hi_hi = a_hi * b_hi;
+
+                    const uint64_t middle = (lo_lo >> 32) + static_cast<uint32_t>(hi_lo) + lo_hi;
+                    high = static_cast<_Ty>(hi_hi + (hi_lo >> 32) + (middle >> 32));
+                    return static_cast<_Ty>((middle << 32) | static_cast<uint32_t>(lo_lo));
+#endif
+                }
+            }
+
+            /**
+             * \~english
+             * @brief Divides a double-width value `high:low` by a single-width divisor.
+             *
+             * The caller must guarantee `high < divisor`, so that the quotient fits into `_Ty`.
+             * For `uint64_t` the hardware 128/64 division is used where available
+             * (`divq`, `_udiv128`), otherwise a normalized two-step estimate on 32-bit halves.
+             *
+             * @tparam _Ty The unsigned integral type.
+             * @param high The high half of the dividend. Must be less than `divisor`.
+             * @param low The low half of the dividend.
+             * @param divisor The divisor. Must not be zero.
+             * @param remainder A reference that receives the remainder.
+             * @return The quotient.
+             * \~russian
+             * @brief Делит значение двойной ширины `high:low` на делитель одинарной ширины.
+             *
+             * Вызывающий обязан гарантировать `high < divisor`, чтобы частное помещалось в `_Ty`.
+             * Для `uint64_t` используется аппаратное деление 128/64 (`divq`, `_udiv128`),
+             * иначе — нормализованная двухшаговая оценка на 32-битных половинах.
+             *
+             * @tparam _Ty Беззнаковый целочисленный тип.
+             * @param high Старшая половина делимого. Должна быть меньше `divisor`.
+             * @param low Младшая половина делимого.
+             * @param divisor Делитель. Не должен быть равен нулю.
+             * @param remainder Ссылка, в которую записывается остаток.
+             * @return Частное.
+             */
+            template<typename _Ty, typename = std::enable_if_t<std::is_unsigned<_Ty>::value>>
+            static inline _Ty divide(_Ty high, _Ty low, _Ty divisor, _Ty& remainder) noexcept {
+                constexpr int BITS = std::numeric_limits<_Ty>::digits;
+                if constexpr (BITS <= 16) {
+                    uint32_t dividend = (static_cast<uint32_t>(high) << BITS) | low;
+                    remainder = static_cast<_Ty>(dividend % divisor);
+                    return static_cast<_Ty>(dividend / divisor);
+                }
+                else if constexpr (BITS <= 32) {
+                    uint64_t dividend = (static_cast<uint64_t>(high) << BITS) | low;
+                    remainder = static_cast<_Ty>(dividend % divisor);
+                    return static_cast<_Ty>(dividend / divisor);
+                }
+                else {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+                    uint64_t quotient = 0, rem = 0;
+                    __asm__("divq %4" : "=a"(quotient), "=d"(rem) : "a"(static_cast<uint64_t>(low)), "d"(static_cast<uint64_t>(high)), "rm"(static_cast<uint64_t>(divisor)));
+                    remainder = static_cast<_Ty>(rem);
+                    return static_cast<_Ty>(quotient);
+#elif defined(__SIZEOF_INT128__)
+                    uint128_t dividend = (static_cast<uint128_t>(high) << 64) | low;
+                    remainder = static_cast<_Ty>(dividend % divisor);
+                    return static_cast<_Ty>(dividend / divisor);
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+                    unsigned __int64 rem = 0;
+                    _Ty quotient = static_cast<_Ty>(_udiv128(high, low, divisor, &rem));
+                    remainder = static_cast<_Ty>(rem);
+                    return quotient;
+#else
+                    uint64_t rem = 0;
+                    const _Ty quotient = static_cast<_Ty>(divide_halves(high, low, divisor, rem));
+                    remainder = static_cast<_Ty>(rem);
+                    return quotient;
+#endif
+                }
+            }
+
+            /**
+             * \~english
+             * @brief Portable `constexpr` 128/64 division on 32-bit halves (same contract as `divide`).
+             *
+             * The fallback of `divide` for targets without a native 128/64 division, and the
+             * division step of the fixed-width types during constant evaluation.
+             * \~russian
+             * @brief Переносимое `constexpr`-деление 128/64 на 32-битных половинах (тот же контракт, что у `divide`).
+             *
+             * Запасной вариант `divide` для платформ без встроенного деления 128/64 и шаг деления
+             * типов фиксированной ширины при вычислении во время компиляции.
+             */
+            static constexpr uint64_t divide_halves(uint64_t high, uint64_t low, uint64_t divisor, uint64_t& remainder) noexcept {
+                constexpr uint64_t HALF = 1ULL << 32;
+                int shift = 0;
+                uint64_t d = divisor;
+                while ((d & (1ULL << 63)) == 0) { d <<= 1; ++shift; }
+
+                const uint64_t d1 = d >> 32, d0 = d & 0xFFFFFFFFULL;
+                const uint64_t n32 = shift ? (high << shift) | (low >> (64 - shift)) : high;
+                const uint64_t n10 = low << shift;
+                const uint64_t n1 = n10 >> 32, n0 = n10 & 0xFFFFFFFFULL;
+
+                uint64_t q1 = n32 / d1, rhat = n32 - q1 * d1;
+                while (q1 >= HALF || q1 * d0 > ((rhat << 32) | n1)) {
+                    --q1; rhat += d1;
+                    if (rhat >= HALF) break;
+                }
+                const uint64_t n21 = (n32 << 32) + n1 - q1 * d;
+
+                uint64_t q0 = n21 / d1;
+                rhat = n21 - q0 * d1;
+                while (q0 >= HALF || q0 * d0 > ((rhat << 32) | n0)) {
+                    --q0; rhat += d1;
+                    if (rhat >= HALF) break;
+                }
+                remainder = ((n21 << 32) + n0 - q0 * d) >> shift;
+                return (q1 << 32) | q0;
+            }
         };
 
         /**
@@ -759,8 +1313,91 @@ namespace numsystem {
                 return { quotient_str, current_remainder_str };
             }
         };
+
+        /**
+         * \~english
+         * @brief `true` for the built-in integers (except `bool`) that fit into 64 bits and take the scalar fast path.
+         * \~russian
+         * @brief `true` для встроенных целых (кроме `bool`) не шире 64 бит, для которых есть быстрый путь со скаляром.
+         */
+        template<typename S>
+        constexpr bool is_small_scalar_v = std::is_integral_v<S> && !std::is_same_v<S, bool> && sizeof(S) <= sizeof(uint64_t);
+
+        /**
+         * \~english
+         * @brief Splits a built-in integer into its 64-bit magnitude and sign (`true` for negative).
+         * \~russian
+         * @brief Разделяет встроенное целое на 64-битный модуль и знак (`true` для отрицательных).
+         */
+        template<typename S>
+        constexpr std::pair<uint64_t, bool> scalar_parts(S value) noexcept {
+            if constexpr (std::is_signed_v<S>) {
+                // Модуль в беззнаковом типе, чтобы не переполнить min()
+                const bool negative = value < 0;
+                const uint64_t bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+                return { negative ? uint64_t(0) - bits : bits, negative };
+            }
+            else {
+                return { static_cast<uint64_t>(value), false };
+            }
+        }
+
+        // Меняет знак на месте; ноль остаётся неотрицательным
+        template<typename Derived>
+        constexpr void negate(Derived& value) noexcept {
+            if (!(value == Derived{})) value.sign(!value.sign());
+        }
+
+        /**
+         * \~english
+         * @brief `true` if `T` has `void multiply_into(const T&, const T&)` that writes a product straight into its own storage.
+         * \~russian
+         * @brief `true`, если у `T` есть `void multiply_into(const T&, const T&)`, пишущий произведение прямо в своё хранилище.
+         */
+        template<typename T, typename = void>
+        struct has_multiply_into : std::false_type {};
+        template<typename T>
+        struct has_multiply_into<T, std::void_t<decltype(std::declval<T&>().multiply_into(std::declval<const T&>(), std::declval<const T&>()))>>
+            : std::true_type {};
+        template<typename T>
+        constexpr bool has_multiply_into_v = has_multiply_into<T>::value;
     }
 
+    /**
+     * \~english
+     * @brief Read-only view of a contiguous array: a pointer and a length (a stand-in for `std::span<const T>` in C++17).
+     *
+     * Converts implicitly from any contiguous container or array (`std::vector`, `std::array`, `T[N]`, ...),
+     * so `from_limbs(vector)` and `from_limbs({ ptr, size })` both work. It does not own the elements.
+     * \~russian
+     * @brief Представление непрерывного массива только для чтения: указатель и длина (замена `std::span<const T>` в C++17).
+     *
+     * Неявно строится из любого непрерывного контейнера или массива (`std::vector`, `std::array`, `T[N]`, ...),
+     * поэтому работают и `from_limbs(vector)`, и `from_limbs({ ptr, size })`. Элементами не владеет.
+     */
+    template<typename T>
+    class ConstSpan {
+    public:
+        using value_type = T;
+        using iterator = const T*;
+
+        constexpr ConstSpan() noexcept = default;
+        constexpr ConstSpan(const T* data, size_t size) noexcept : _data(data), _size(size) {}
+        template<typename Container, typename = std::enable_if_t<
+            std::is_convertible_v<decltype(std::data(std::declval<const Container&>())), const T*>>>
+        constexpr ConstSpan(const Container& container) noexcept : _data(std::data(container)), _size(std::size(container)) {}
+
+        [[nodiscard]] constexpr const T* data() const noexcept { return _data; }
+        [[nodiscard]] constexpr size_t size() const noexcept { return _size; }
+        [[nodiscard]] constexpr bool empty() const noexcept { return _size == 0; }
+        [[nodiscard]] constexpr const T& operator[](size_t i) const noexcept { return _data[i]; }
+        [[nodiscard]] constexpr iterator begin() const noexcept { return _data; }
+        [[nodiscard]] constexpr iterator end() const noexcept { return _data + _size; }
+    private:
+        const T* _data = nullptr;
+        size_t _size = 0;
+    };
+
 
     /**
      * \~english
@@ -831,11 +1468,26 @@ namespace numsystem {
      * - `Derived multiply(const Derived&) const;`
      * - `Derived divide(const Derived&) const;`
      * - `Derived modulo(const Derived&) const;`
+     * - `std::pair<Derived, Derived> divmod(const Derived&) const;`
      * All these methods should return a new result object and not modify `*this`.
      *
+     * In-place counterparts with full signed semantics are also required; they back the
+     * compound assignment operators and may reuse the storage of `*this`. `rhs` may alias `*this`:
+     * - `void add_assign(const Derived&);`
+     * - `void subtract_assign(const Derived&);`
+     * - `void multiply_assign(const Derived&);`
+     *
+     * Mixed operations with a built-in integer `s` (`a + s`, `s * a`, `a %= s`, ...) and `++` / `--`
+     * go through scalar kernels that take the magnitude of `s` and its sign and do not build a `Derived`:
+     * - `void add_small(uint64_t, bool negative);`, `void mul_small(uint64_t, bool negative);`
+     * - `uint64_t divmod_small(uint64_t, bool negative);` (truncating, returns the remainder magnitude)
+     * - `uint64_t mod_small(uint64_t) const;`
+     *
      * This class then provides overloaded binary operators (`+`, `-`, `*`, `/`, `%`),
      * compound assignment operators (`+=`, `-=`, `*=`, `/=`, `%=`),
      * and increment/decrement operators (`++`, `--`) based on these fundamental methods.
+     * All of them are `constexpr`: they are evaluated at compile time whenever the methods of
+     * `Derived` are (the fixed-width types of `FixedArithmetic.h`).
      * @tparam Derived The derived class that inherits from `BaseArithmetic`.
      * \~russian
      * @brief Базовый CRTP-класс для реализации арифметических операторов.
@@ -846,11 +1498,26 @@ namespace numsystem {
      * - `Derived multiply(const Derived&) const;`
      * - `Derived divide(const Derived&) const;`
      * - `Derived modulo(const Derived&) const;`
+     * - `std::pair<Derived, Derived> divmod(const Derived&) const;`
      * Все эти методы должны возвращать новый объект-результат и не изменять `*this`.
      *
+     * Также нужны версии «на месте» с полной знаковой семантикой: на них построены операторы
+     * составного присваивания, и они могут переиспользовать хранилище `*this`. `rhs` может совпадать с `*this`:
+     * - `void add_assign(const Derived&);`
+     * - `void subtract_assign(const Derived&);`
+     * - `void multiply_assign(const Derived&);`
+     *
+     * Смешанные операции со встроенным целым `s` (`a + s`, `s * a`, `a %= s`, ...) и `++` / `--`
+     * идут через скалярные ядра, которые получают модуль `s` и его знак и не строят `Derived`:
+     * - `void add_small(uint64_t, bool negative);`, `void mul_small(uint64_t, bool negative);`
+     * - `uint64_t divmod_small(uint64_t, bool negative);` (с усечением, возвращает модуль остатка)
+     * - `uint64_t mod_small(uint64_t) const;`
+     *
      * Этот класс затем предоставляет перегруженные бинарные операторы (`+`, `-`, `*`, `/`, `%`),
      * операторы составного присваивания (`+=`, `-=`, `*=`, `/=`, `%=`),
      * и операторы инкремента/декремента (`++`, `--`), основанные на этих фундаментальных методах.
+     * Все они `constexpr`: вычисляются при компиляции, если это возможно для методов `Derived`
+     * (типы фиксированной ширины из `FixedArithmetic.h`).
      * @tparam Derived Производный класс, который наследует от `BaseArithmetic`.
      */
     template <typename Derived>
@@ -858,35 +1525,74 @@ namespace numsystem {
         /// \~english @brief Addition operator.
         /// \~russian @brief Оператор сложения.
         friend constexpr Derived operator+(const Derived& lhs, const Derived& rhs) {
-            if (lhs.sign() == rhs.sign()) {
-                // a + b | (-a) + (-b)
-                Derived result = lhs.add(rhs);
-                result.sign(lhs.sign());
-                return result;
-            }
-            else if (abs(lhs) == abs(rhs)) {
-                return 0;
-            }
-            else {
-                const bool lhsAbsGe = abs(lhs) > abs(rhs);
-                Derived larger = lhsAbsGe ? lhs : rhs;
-                Derived smaller = lhsAbsGe ? rhs : lhs;
-                Derived result = larger.subtract(smaller);
-                result.sign(larger.sign());
-                return result;
-            }
+            // Одна копия lhs, дальше сложение на месте с учётом знаков
+            Derived result(lhs);
+            result.add_assign(rhs);
+            return result;
         }
         /// \~english @brief Subtraction operator.
         /// \~russian @brief Оператор вычитания.
         friend constexpr Derived operator-(const Derived& lhs, const Derived& rhs) {
-            Derived _rhs(rhs); _rhs.sign(!_rhs.sign());
-            return lhs + _rhs;
+            Derived result(lhs);
+            result.subtract_assign(rhs);
+            return result;
         }
         /// \~english @brief Multiplication operator.
         /// \~russian @brief Оператор умножения.
         friend constexpr Derived operator*(const Derived& lhs, const Derived& rhs) {
             return lhs.multiply(rhs);
         }
+
+        // Temporary operands: the result takes over the storage of an rvalue operand instead of copying
+        /// \~english @brief Addition into the storage of the temporary `lhs`.
+        /// \~russian @brief Сложение в хранилище временного `lhs`.
+        friend constexpr Derived operator+(Derived&& lhs, const Derived& rhs) {
+            lhs.add_assign(rhs);
+            return std::move(lhs);
+        }
+        /// \~english @brief Addition into the storage of the temporary `rhs`.
+        /// \~russian @brief Сложение в хранилище временного `rhs`.
+        friend constexpr Derived operator+(const Derived& lhs, Derived&& rhs) {
+            rhs.add_assign(lhs);
+            return std::move(rhs);
+        }
+        friend constexpr Derived operator+(Derived&& lhs, Derived&& rhs) {
+            lhs.add_assign(rhs);
+            return std::move(lhs);
+        }
+        /// \~english @brief Subtraction into the storage of the temporary `lhs`.
+        /// \~russian @brief Вычитание в хранилище временного `lhs`.
+        friend constexpr Derived operator-(Derived&& lhs, const Derived& rhs) {
+            lhs.subtract_assign(rhs);
+            return std::move(lhs);
+        }
+        /// \~english @brief Subtraction into the storage of the temporary `rhs`: `lhs - rhs == -(rhs - lhs)`.
+        /// \~russian @brief Вычитание в хранилище временного `rhs`: `lhs - rhs == -(rhs - lhs)`.
+        friend constexpr Derived operator-(const Derived& lhs, Derived&& rhs) {
+            rhs.subtract_assign(lhs);
+            impl::negate(rhs);
+            return std::move(rhs);
+        }
+        friend constexpr Derived operator-(Derived&& lhs, Derived&& rhs) {
+            lhs.subtract_assign(rhs);
+            return std::move(lhs);
+        }
+        /// \~english @brief Multiplication into the storage of the temporary `lhs`.
+        /// \~russian @brief Умножение в хранилище временного `lhs`.
+        friend constexpr Derived operator*(Derived&& lhs, const Derived& rhs) {
+            lhs.multiply_assign(rhs);
+            return std::move(lhs);
+        }
+        /// \~english @brief Multiplication into the storage of the temporary `rhs`.
+        /// \~russian @brief Умножение в хранилище временного `rhs`.
+        friend constexpr Derived operator*(const Derived& lhs, Derived&& rhs) {
+            rhs.multiply_assign(lhs);
+            return std::move(rhs);
+        }
+        friend constexpr Derived operator*(Derived&& lhs, Derived&& rhs) {
+            lhs.multiply_assign(rhs);
+            return std::move(lhs);
+        }
         /// \~english @brief Division operator.
         /// \~russian @brief Оператор деления.
         friend constexpr Derived operator/(const Derived& lhs, const Derived& rhs) {
@@ -897,27 +1603,215 @@ namespace numsystem {
         friend constexpr Derived operator%(const Derived& lhs, const Derived& rhs) {
             return lhs.modulo(rhs);
         }
+        /// \~english @brief Quotient and remainder from a single division (truncating toward zero).
+        /// \~russian @brief Частное и остаток за одно деление (с усечением к нулю).
+        friend constexpr std::pair<Derived, Derived> divmod(const Derived& lhs, const Derived& rhs) {
+            return lhs.divmod(rhs);
+        }
+
+        /**
+         * \~english
+         * @brief `result = lhs + rhs`, reusing the capacity `result` already has.
+         *
+         * `result` may be the same object as `lhs` or `rhs`. Like `mpz_add(r, a, b)`: a loop that keeps
+         * one output object allocates nothing once that object has grown to the size of the results.
+         * @return `result`.
+         * \~russian
+         * @brief `result = lhs + rhs` с использованием уже имеющейся ёмкости `result`.
+         *
+         * `result` может совпадать с `lhs` или `rhs`. Как `mpz_add(r, a, b)`: цикл с одним выходным
+         * объектом ничего не выделяет, когда этот объект дорос до размера результатов.
+         * @return `result`.
+         */
+        friend constexpr Derived& add(Derived& result, const Derived& lhs, const Derived& rhs) {
+            if (&result == &rhs) {
+                result.add_assign(lhs);
+            }
+            else {
+                if (&result != &lhs) result = lhs;
+                result.add_assign(rhs);
+            }
+            return result;
+        }
+        /// \~english @brief `result = lhs - rhs`, reusing the capacity of `result`; `result` may alias either operand.
+        /// \~russian @brief `result = lhs - rhs` с использованием ёмкости `result`; `result` может совпадать с любым операндом.
+        friend constexpr Derived& subtract(Derived& result, const Derived& lhs, const Derived& rhs) {
+            if (&result == &rhs) {
+                result.subtract_assign(lhs);
+                impl::negate(result);
+            }
+            else {
+                if (&result != &lhs) result = lhs;
+                result.subtract_assign(rhs);
+            }
+            return result;
+        }
+        /**
+         * \~english
+         * @brief `result = lhs * rhs`, reusing the capacity of `result`; `result` may alias either operand.
+         *
+         * Types with `multiply_into` (`BinaryArithmetic`) write the product straight into `result`
+         * when it is a separate object, otherwise the product goes through `multiply_assign`.
+         * Nothing is allocated only while the shorter operand is below `NUMSYS_KARATSUBA_THRESHOLD` limbs
+         * (schoolbook range); longer products take temporary scratch from the current memory resource.
+         * \~russian
+         * @brief `result = lhs * rhs` с использованием ёмкости `result`; `result` может совпадать с любым операндом.
+         *
+         * Типы с `multiply_into` (`BinaryArithmetic`) пишут произведение прямо в `result`,
+         * если это отдельный объект, иначе произведение считается через `multiply_assign`.
+         * Без выделений памяти обходится только умножение «столбиком», пока меньший операнд короче
+         * `NUMSYS_KARATSUBA_THRESHOLD` слов; более длинные берут временный буфер из текущего ресурса памяти.
+         */
+        friend constexpr Derived& multiply(Derived& result, const Derived& lhs, const Derived& rhs) {
+            if constexpr (impl::has_multiply_into_v<Derived>) {
+                result.multiply_into(lhs, rhs);
+            }
+            else if (&result == &rhs) {
+                result.multiply_assign(lhs);
+            }
+            else {
+                if (&result != &lhs) result = lhs;
+                result.multiply_assign(rhs);
+            }
+            return result;
+        }
+
+        // Mixed operations with a built-in integer
+        /// \~english @brief Addition of a built-in integer without converting it to `Derived`.
+        /// \~russian @brief Сложение со встроенным целым без преобразования его в `Derived`.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator+(const Derived& lhs, S rhs) {
+            Derived result(lhs);
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            result.add_small(magnitude, negative);
+            return result;
+        }
+        /// \~english @brief Addition of a built-in integer without converting it to `Derived`.
+        /// \~russian @brief Сложение со встроенным целым без преобразования его в `Derived`.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator+(S lhs, const Derived& rhs) {
+            return rhs + lhs;
+        }
+        /// \~english @brief Subtraction of a built-in integer without converting it to `Derived`.
+        /// \~russian @brief Вычитание встроенного целого без преобразования его в `Derived`.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator-(const Derived& lhs, S rhs) {
+            Derived result(lhs);
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            result.add_small(magnitude, !negative);
+            return result;
+        }
+        /// \~english @brief Subtraction from a built-in integer: `s - a == -a + s`.
+        /// \~russian @brief Вычитание из встроенного целого: `s - a == -a + s`.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator-(S lhs, const Derived& rhs) {
+            Derived result(rhs);
+            result.sign(!result.sign());
+            const auto [magnitude, negative] = impl::scalar_parts(lhs);
+            result.add_small(magnitude, negative);
+            return result;
+        }
+        /// \~english @brief Multiplication by a built-in integer in a single pass over the digits.
+        /// \~russian @brief Умножение на встроенное целое за один проход по разрядам.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator*(const Derived& lhs, S rhs) {
+            Derived result(lhs);
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            result.mul_small(magnitude, negative);
+            return result;
+        }
+        /// \~english @brief Multiplication by a built-in integer in a single pass over the digits.
+        /// \~russian @brief Умножение на встроенное целое за один проход по разрядам.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator*(S lhs, const Derived& rhs) {
+            return rhs * lhs;
+        }
+        /// \~english @brief Division by a built-in integer (truncating toward zero).
+        /// \~russian @brief Деление на встроенное целое (с усечением к нулю).
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator/(const Derived& lhs, S rhs) {
+            Derived result(lhs);
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            result.divmod_small(magnitude, negative);
+            return result;
+        }
+        /// \~english @brief Remainder of division by a built-in integer; has the sign of `lhs`, like `lhs % Derived(rhs)`.
+        /// \~russian @brief Остаток от деления на встроенное целое; имеет знак `lhs`, как и `lhs % Derived(rhs)`.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator%(const Derived& lhs, S rhs) {
+            Derived result(lhs.mod_small(impl::scalar_parts(rhs).first));
+            if (!(result == Derived{})) result.sign(lhs.sign());
+            return result;
+        }
+
+        /// \~english @brief Addition of a built-in integer into the storage of the temporary `lhs`.
+        /// \~russian @brief Сложение со встроенным целым в хранилище временного `lhs`.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator+(Derived&& lhs, S rhs) {
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            lhs.add_small(magnitude, negative);
+            return std::move(lhs);
+        }
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator+(S lhs, Derived&& rhs) {
+            return std::move(rhs) + lhs;
+        }
+        /// \~english @brief Subtraction of a built-in integer in the storage of the temporary `lhs`.
+        /// \~russian @brief Вычитание встроенного целого в хранилище временного `lhs`.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator-(Derived&& lhs, S rhs) {
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            lhs.add_small(magnitude, !negative);
+            return std::move(lhs);
+        }
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator-(S lhs, Derived&& rhs) {
+            rhs.sign(!rhs.sign());
+            const auto [magnitude, negative] = impl::scalar_parts(lhs);
+            rhs.add_small(magnitude, negative);
+            return std::move(rhs);
+        }
+        /// \~english @brief Multiplication by a built-in integer in the storage of the temporary `lhs`.
+        /// \~russian @brief Умножение на встроенное целое в хранилище временного `lhs`.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator*(Derived&& lhs, S rhs) {
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            lhs.mul_small(magnitude, negative);
+            return std::move(lhs);
+        }
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator*(S lhs, Derived&& rhs) {
+            return std::move(rhs) * lhs;
+        }
+        /// \~english @brief Division by a built-in integer in the storage of the temporary `lhs`.
+        /// \~russian @brief Деление на встроенное целое в хранилище временного `lhs`.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        friend constexpr Derived operator/(Derived&& lhs, S rhs) {
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            lhs.divmod_small(magnitude, negative);
+            return std::move(lhs);
+        }
 
         // Compound assignment operators
         /// \~english @brief Compound addition assignment operator.
         /// \~russian @brief Оператор составного присваивания сложения.
         constexpr Derived& operator+=(const Derived& rhs) {
             Derived& self = static_cast<Derived&>(*this);
-            self = self + rhs;
+            self.add_assign(rhs);
             return self;
         }
         /// \~english @brief Compound subtraction assignment operator.
         /// \~russian @brief Оператор составного присваивания вычитания.
         constexpr Derived& operator-=(const Derived& rhs) {
             Derived& self = static_cast<Derived&>(*this);
-            self = self - rhs;
+            self.subtract_assign(rhs);
             return self;
         }
         /// \~english @brief Compound multiplication assignment operator.
         /// \~russian @brief Оператор составного присваивания умножения.
         constexpr Derived& operator*=(const Derived& rhs) {
             Derived& self = static_cast<Derived&>(*this);
-            self = self * rhs;
+            self.multiply_assign(rhs);
             return self;
         }
         /// \~english @brief Compound division assignment operator.
@@ -935,12 +1829,57 @@ namespace numsystem {
             return self;
         }
 
+        /// \~english @brief Compound addition of a built-in integer.
+        /// \~russian @brief Составное сложение со встроенным целым.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        constexpr Derived& operator+=(S rhs) {
+            Derived& self = static_cast<Derived&>(*this);
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            self.add_small(magnitude, negative);
+            return self;
+        }
+        /// \~english @brief Compound subtraction of a built-in integer.
+        /// \~russian @brief Составное вычитание встроенного целого.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        constexpr Derived& operator-=(S rhs) {
+            Derived& self = static_cast<Derived&>(*this);
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            self.add_small(magnitude, !negative);
+            return self;
+        }
+        /// \~english @brief Compound multiplication by a built-in integer.
+        /// \~russian @brief Составное умножение на встроенное целое.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        constexpr Derived& operator*=(S rhs) {
+            Derived& self = static_cast<Derived&>(*this);
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            self.mul_small(magnitude, negative);
+            return self;
+        }
+        /// \~english @brief Compound division by a built-in integer.
+        /// \~russian @brief Составное деление на встроенное целое.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        constexpr Derived& operator/=(S rhs) {
+            Derived& self = static_cast<Derived&>(*this);
+            const auto [magnitude, negative] = impl::scalar_parts(rhs);
+            self.divmod_small(magnitude, negative);
+            return self;
+        }
+        /// \~english @brief Compound modulo by a built-in integer.
+        /// \~russian @brief Составное взятие остатка от деления на встроенное целое.
+        template<typename S, typename = std::enable_if_t<impl::is_small_scalar_v<S>>>
+        constexpr Derived& operator%=(S rhs) {
+            Derived& self = static_cast<Derived&>(*this);
+            self = self % rhs;
+            return self;
+        }
+
         // Increment and decrement (prefix/postfix forms)
         /// \~english @brief Prefix increment operator.
         /// \~russian @brief Префиксный оператор инкремента.
         constexpr Derived& operator++() {
             Derived& self = static_cast<Derived&>(*this);
-            self = self + Derived(1);
+            self.add_small(1, false);
             return self;
         }
         /// \~english @brief Postfix increment operator.
@@ -948,14 +1887,14 @@ namespace numsystem {
         constexpr Derived operator++(int) {
             Derived& self = static_cast<Derived&>(*this);
             Derived old = self;
-            self = self + Derived(1);
+            self.add_small(1, false);
             return old;
         }
         /// \~english @brief Prefix decrement operator.
         /// \~russian @brief Префиксный оператор декремента.
         constexpr Derived& operator--() {
             Derived& self = static_cast<Derived&>(*this);
-            self = self - Derived(1);
+            self.add_small(1, true);
             return self;
         }
         /// \~english @brief Postfix decrement operator.
@@ -963,17 +1902,24 @@ namespace numsystem {
         constexpr Derived operator--(int) {
             Derived& self = static_cast<Derived&>(*this);
             Derived old = self;
-            self = self - Derived(1);
+            self.add_small(1, true);
             return old;
         }
 
         /// \~english @brief Unary negation operator.
         /// \~russian @brief Унарный оператор отрицания.
-        constexpr Derived operator-() const noexcept {
+        constexpr Derived operator-() const& noexcept {
             Derived copy = static_cast<const Derived&>(*this);
             copy.sign(!copy.sign());
             return copy;
         }
+        /// \~english @brief Unary negation of a temporary: flips the sign in place and moves the storage out.
+        /// \~russian @brief Унарное отрицание временного объекта: меняет знак на месте и забирает хранилище.
+        constexpr Derived operator-() && noexcept {
+            Derived& self = static_cast<Derived&>(*this);
+            self.sign(!self.sign());
+            return std::move(self);
+        }
         /// \~english @brief Unary plus operator (returns a copy).
         /// \~russian @brief Унарный оператор плюс (возвращает копию).
         constexpr Derived operator+() noexcept {
@@ -993,11 +1939,13 @@ namespace numsystem {
      * - `Derived multiply(const Derived&) const noexcept;`
      * - `Derived divide(const Derived&) const noexcept;`
      * - `Derived modulo(const Derived&) const noexcept;`
+     * - `void add_assign(const Derived&);`, `void subtract_assign(const Derived&);`, `void multiply_assign(const Derived&);`
      * - `std::string to_string() const;` (or `noexcept` if applicable)
+     * - `size_t bit_length() const;` — bits in `|value|`, used as the starting estimate for roots
      * - A constructor `Derived(int)` to handle `Derived{0}` and `Derived{1}` in `pow` and `sqrt`.
      *
      * This class provides common mathematical functions like absolute value (`abs`),
-     * exponentiation (`pow`), and integer square root (`sqrt`).
+     * exponentiation (`pow`), integer square root (`sqrt`, `sqrtrem`) and `n`-th root (`iroot`).
      * @tparam Derived The derived class that inherits from `IntegralBase`.
      * \~russian
      * @brief Комплексный базовый CRTP-класс для целочисленных типов, объединяющий функциональность сравнения и арифметики.
@@ -1009,11 +1957,13 @@ namespace numsystem {
      * - `Derived multiply(const Derived&) const noexcept;`
      * - `Derived divide(const Derived&) const noexcept;`
      * - `Derived modulo(const Derived&) const noexcept;`
+     * - `void add_assign(const Derived&);`, `void subtract_assign(const Derived&);`, `void multiply_assign(const Derived&);`
      * - `std::string to_string() const;` (или `noexcept`, если применимо)
+     * - `size_t bit_length() const;` — число бит в `|value|`, начальное приближение для корней
      * - Конструктор `Derived(int)` для обработки `Derived{0}` и `Derived{1}` в `pow` и `sqrt`.
      *
      * Этот класс предоставляет общие математические функции, такие как абсолютное значение (`abs`),
-     * возведение в степень (`pow`) и целочисленный квадратный корень (`sqrt`).
+     * возведение в степень (`pow`), целочисленный квадратный корень (`sqrt`, `sqrtrem`) и корень степени `n` (`iroot`).
      * @tparam Derived Производный класс, который наследует от `IntegralBase`.
      */
     template <typename Derived>
@@ -1034,6 +1984,12 @@ namespace numsystem {
             }
             return value;
         }
+        /// \~english @brief Absolute value of a temporary, computed in its own storage.
+        /// \~russian @brief Абсолютное значение временного объекта, вычисленное в его же хранилище.
+        friend constexpr Derived abs(Derived&& value) noexcept {
+            if (value < Derived{}) value.sign(false);
+            return std::move(value);
+        }
         /**
          * \~english
          * @brief Calculates the power of a base to an unsigned integer exponent (integer exponentiation).
@@ -1046,7 +2002,7 @@ namespace numsystem {
          * @param exp Беззнаковый целый показатель степени.
          * @return Результат `base` в степени `exp`.
          */
-        friend Derived pow(Derived base, unsigned int exp) {
+        friend constexpr Derived pow(Derived base, unsigned int exp) {
             Derived result = Derived{ 1 };
             while (exp > 0) {
                 if (exp % 2 == 1)
@@ -1056,45 +2012,92 @@ namespace numsystem {
             }
             return result;
         }
+        /**
+         * \~english
+         * @brief Integer square root and remainder: `{s, value - s * s}` with `s = floor(sqrt(value))`.
+         * @throws std::domain_error if `value` is negative.
+         * \~russian
+         * @brief Целочисленный квадратный корень и остаток: `{s, value - s * s}`, где `s = floor(sqrt(value))`.
+         * @throws std::domain_error Если `value` отрицательное.
+         */
+        friend constexpr std::pair<Derived, Derived> sqrtrem(const Derived& value) {
+            if (value < Derived{}) {
+                throw std::domain_error("sqrt of negative value");
+            }
+            Derived root = newton_root(value, 2);
+            Derived remainder = value - root * root;
+            return { std::move(root), std::move(remainder) };
+        }
         /**
          * \~english
          * @brief Calculates the integer square root of a non-negative number.
+         *
+         * Newton's iteration `x = (x + value / x) / 2` starts from `2^ceil(bit_length / 2)` and
+         * converges quadratically: `O(log(bit_length))` divisions instead of a binary search over the value.
          * @param value The non-negative number to calculate the square root of.
          * @return The integer square root of `value`. Returns 0 if `value` is 0.
          * @throws std::domain_error if `value` is negative.
          * \~russian
          * @brief Вычисляет целочисленный квадратный корень из неотрицательного числа.
+         *
+         * Итерация Ньютона `x = (x + value / x) / 2` стартует с `2^ceil(bit_length / 2)` и
+         * сходится квадратично: `O(log(bit_length))` делений вместо двоичного поиска по значению.
          * @param value Неотрицательное число, из которого нужно извлечь квадратный корень.
          * @return Целочисленный квадратный корень из `value`. Возвращает 0, если `value` равно 0.
          * @throws std::domain_error Если `value` отрицательное.
          */
-        friend Derived sqrt(const Derived& value) {
+        friend constexpr Derived sqrt(const Derived& value) {
             if (value < Derived{}) {
                 throw std::domain_error("sqrt of negative value");
             }
-            if (value == Derived{}) {
-                return Derived{};
+            return newton_root(value, 2);
+        }
+        /**
+         * \~english
+         * @brief Integer `n`-th root truncated toward zero: the largest `r` with `|r|^n <= |value|`, with the sign of `value`.
+         *
+         * Newton's iteration `x = ((n - 1) * x + value / x^(n - 1)) / n` from `2^ceil(bit_length / n)`.
+         * @throws std::domain_error if `n == 0`, or if `value` is negative and `n` is even.
+         * \~russian
+         * @brief Целочисленный корень степени `n` с усечением к нулю: наибольший `r`, для которого `|r|^n <= |value|`, со знаком `value`.
+         *
+         * Итерация Ньютона `x = ((n - 1) * x + value / x^(n - 1)) / n` от `2^ceil(bit_length / n)`.
+         * @throws std::domain_error Если `n == 0` или если `value` отрицательное, а `n` чётное.
+         */
+        friend constexpr Derived iroot(const Derived& value, unsigned int n) {
+            if (n == 0) {
+                throw std::domain_error("zeroth root");
             }
-
-            Derived low = Derived{ 1 };
-            Derived high = value;
-            Derived mid, mid_squared;
-
-            while (low <= high) {
-                mid = (low + high) / Derived{ 2 };
-                mid_squared = mid * mid;
-
-                if (mid_squared == value) {
-                    return mid;
-                }
-                else if (mid_squared < value) {
-                    low = mid + Derived{ 1 };
+            if (value < Derived{}) {
+                if (n % 2 == 0) {
+                    throw std::domain_error("even root of negative value");
                 }
-                else {
-                    high = mid - Derived{ 1 };
+                return -newton_root(-value, n);
+            }
+            return newton_root(value, n);
+        }
+
+    private:
+        // floor(value^(1/n)) для value >= 0. Начальное приближение 2^ceil(bits / n) не меньше корня,
+        // а целочисленный шаг Ньютона сверху монотонно убывает до ответа: останавливаемся, как только шаг перестал уменьшать x
+        static constexpr Derived newton_root(const Derived& value, unsigned int n) {
+            const uint64_t bits = value.bit_length();
+            if (bits <= 1 || n == 1) {
+                return value;
+            }
+            if (n >= bits) {
+                return Derived{ 1 };  // value < 2^bits <= 2^n
+            }
+            Derived x = pow(Derived{ 2 }, static_cast<unsigned int>((bits + n - 1) / n));
+            for (;;) {
+                Derived next = value / pow(x, n - 1);
+                next += x * (n - 1);
+                next /= n;
+                if (!(next < x)) {
+                    return x;
                 }
+                x = std::move(next);
             }
-            return high;
         }
     };
 
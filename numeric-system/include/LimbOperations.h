@@ -0,0 +1,795 @@
+﻿#pragma once
+#include "CpuDispatch.h"
+#include "Internal.h"
+#include <string_view>
+
+/**
+ * \~english
+ * @brief Operand size (in limbs) from which multiplication switches from schoolbook to Karatsuba.
+ *
+ * Can be overridden at build time (e.g. `-DNUMSYS_KARATSUBA_THRESHOLD=24`) to tune for a specific CPU.
+ * \~russian
+ * @brief Размер операнда (в словах), начиная с которого умножение переключается со «столбика» на Карацубу.
+ *
+ * Может быть переопределён при сборке (например, `-DNUMSYS_KARATSUBA_THRESHOLD=24`) для настройки под конкретный процессор.
+ */
+#ifndef NUMSYS_KARATSUBA_THRESHOLD
+#define NUMSYS_KARATSUBA_THRESHOLD 32
+#endif
+
+/**
+ * \~english
+ * @brief Operand size (in limbs) from which multiplication switches from Karatsuba to Toom-3.
+ *
+ * Can be overridden at build time (e.g. `-DNUMSYS_TOOM3_THRESHOLD=128`) to tune for a specific CPU.
+ * \~russian
+ * @brief Размер операнда (в словах), начиная с которого умножение переключается с Карацубы на Тоома-3.
+ *
+ * Может быть переопределён при сборке (например, `-DNUMSYS_TOOM3_THRESHOLD=128`) для настройки под конкретный процессор.
+ */
+#ifndef NUMSYS_TOOM3_THRESHOLD
+#define NUMSYS_TOOM3_THRESHOLD 160
+#endif
+
+/**
+ * \~english
+ * @brief Operand size (in limbs) from which multiplication switches from Toom-3 to the number-theoretic transform.
+ *
+ * Can be overridden at build time (e.g. `-DNUMSYS_FFT_THRESHOLD=2048`) to tune for a specific CPU.
+ * \~russian
+ * @brief Размер операнда (в словах), начиная с которого умножение переключается с Тоома-3 на теоретико-числовое преобразование.
+ *
+ * Может быть переопределён при сборке (например, `-DNUMSYS_FFT_THRESHOLD=2048`) для настройки под конкретный процессор.
+ */
+#ifndef NUMSYS_FFT_THRESHOLD
+#define NUMSYS_FFT_THRESHOLD 4096
+#endif
+
+/**
+ * \~english
+ * @brief Number size (in limbs) from which conversion to decimal switches to divide and conquer.
+ *
+ * Can be overridden at build time (e.g. `-DNUMSYS_GET_STR_DC_THRESHOLD=48`).
+ * \~russian
+ * @brief Размер числа (в словах), начиная с которого перевод в десятичную запись идёт «разделяй и властвуй».
+ *
+ * Может быть переопределён при сборке (например, `-DNUMSYS_GET_STR_DC_THRESHOLD=48`).
+ */
+#ifndef NUMSYS_GET_STR_DC_THRESHOLD
+#define NUMSYS_GET_STR_DC_THRESHOLD 24
+#endif
+
+/**
+ * \~english
+ * @brief Result size (in limbs) from which decimal parsing switches to divide and conquer.
+ *
+ * Can be overridden at build time (e.g. `-DNUMSYS_SET_STR_DC_THRESHOLD=64`).
+ * \~russian
+ * @brief Размер результата (в словах), начиная с которого разбор десятичной строки идёт «разделяй и властвуй».
+ *
+ * Может быть переопределён при сборке (например, `-DNUMSYS_SET_STR_DC_THRESHOLD=64`).
+ */
+#ifndef NUMSYS_SET_STR_DC_THRESHOLD
+#define NUMSYS_SET_STR_DC_THRESHOLD 48
+#endif
+
+/**
+ * \~english
+ * @brief Binary size (in limbs) from which conversion between factorial coefficients and binary limbs switches to divide and conquer.
+ *
+ * Can be overridden at build time (e.g. `-DNUMSYS_FACTORIAL_DC_THRESHOLD=64`).
+ * \~russian
+ * @brief Двоичный размер (в словах), начиная с которого перевод между факториальными коэффициентами и двоичными словами идёт «разделяй и властвуй».
+ *
+ * Может быть переопределён при сборке (например, `-DNUMSYS_FACTORIAL_DC_THRESHOLD=64`).
+ */
+#ifndef NUMSYS_FACTORIAL_DC_THRESHOLD
+#define NUMSYS_FACTORIAL_DC_THRESHOLD 32
+#endif
+
+namespace numsystem {
+    namespace impl {
+        /**
+         * \~english
+         * @brief Size thresholds used to select the multiplication algorithm.
+         *
+         * Thresholds are expressed in limbs of the operands and apply to every limb width.
+         * \~russian
+         * @brief Пороги размеров, по которым выбирается алгоритм умножения.
+         *
+         * Пороги выражены в словах операндов и действуют для любой ширины слова.
+         */
+        struct MultiplyThresholds {
+            /// \~english @brief Smaller operand size from which Karatsuba is used.
+            /// \~russian @brief Размер меньшего операнда, начиная с которого используется Карацуба.
+            static constexpr size_t KARATSUBA = NUMSYS_KARATSUBA_THRESHOLD;
+            /// \~english @brief Smaller operand size from which Toom-3 is used.
+            /// \~russian @brief Размер меньшего операнда, начиная с которого используется Тоом-3.
+            static constexpr size_t TOOM3 = NUMSYS_TOOM3_THRESHOLD;
+            /// \~english @brief Smaller operand size from which the three-prime NTT is used.
+            /// \~russian @brief Размер меньшего операнда, начиная с которого используется NTT по трём простым.
+            static constexpr size_t FFT = NUMSYS_FFT_THRESHOLD;
+
+            static_assert(KARATSUBA >= 4, "Karatsuba threshold must be at least 4 limbs");
+            static_assert(TOOM3 >= KARATSUBA, "Toom-3 threshold must not be below the Karatsuba threshold");
+            static_assert(FFT >= TOOM3, "FFT threshold must not be below the Toom-3 threshold");
+        };
+
+        /**
+         * \~english
+         * @brief Size thresholds used to select the decimal conversion algorithm.
+         * \~russian
+         * @brief Пороги размеров, по которым выбирается алгоритм десятичного преобразования.
+         */
+        struct ConversionThresholds {
+            /// \~english @brief Number size in limbs from which `get_str` divides by cached powers of 10.
+            /// \~russian @brief Размер числа в словах, начиная с которого `get_str` делит на кэшированные степени 10.
+            static constexpr size_t GET_STR_DC = NUMSYS_GET_STR_DC_THRESHOLD;
+            /// \~english @brief Result size in limbs from which `set_str` splits the string in halves.
+            /// \~russian @brief Размер результата в словах, начиная с которого `set_str` делит строку пополам.
+            static constexpr size_t SET_STR_DC = NUMSYS_SET_STR_DC_THRESHOLD;
+            /// \~english @brief Binary size in limbs from which factorial <-> binary conversion splits by products of radices.
+            /// \~russian @brief Двоичный размер в словах, начиная с которого перевод факториальной записи в двоичную и обратно делится по произведениям оснований.
+            static constexpr size_t FACTORIAL_DC = NUMSYS_FACTORIAL_DC_THRESHOLD;
+
+            static_assert(GET_STR_DC >= 3, "get_str divide-and-conquer threshold must be at least 3 limbs");
+            static_assert(SET_STR_DC >= 1, "set_str divide-and-conquer threshold must be at least 1 limb");
+            static_assert(FACTORIAL_DC >= 2, "factorial conversion divide-and-conquer threshold must be at least 2 limbs");
+        };
+
+        /**
+         * \~english
+         * @brief Low-level kernels operating on raw little-endian limb arrays.
+         *
+         * All functions work on magnitudes only: the caller is responsible for signs,
+         * allocation and trimming. Unless stated otherwise, the result may alias an input
+         * of the same length, and sizes are limb counts.
+         * \~russian
+         * @brief Низкоуровневые ядра, работающие с «сырыми» массивами слов (младшее слово первым).
+         *
+         * Все функции работают только с модулями: знаки, выделение памяти и обрезка
+         * лежат на вызывающем. Если не сказано иное, результат может совпадать
+         * с входом той же длины, а размеры задаются в словах.
+         */
+        struct LimbOperations {
+            /**
+             * \~english
+             * @brief Kernel table for a runtime call on `n` limbs, or `nullptr` when the portable loops below are used.
+             *
+             * Constant evaluation and short arrays always take the portable loops; see `CpuDispatch.h`.
+             * \~russian
+             * @brief Таблица ядер для вызова на `n` словах во время выполнения или `nullptr`, если работают переносимые циклы ниже.
+             *
+             * При константном вычислении и на коротких массивах всегда работают переносимые циклы; см. `CpuDispatch.h`.
+             */
+            static constexpr const impl::KernelTable* dispatched(size_t n) noexcept {
+                if (NUMSYS_IS_CONSTANT_EVALUATED() || n < impl::DISPATCH_MIN_LIMBS) return nullptr;
+                return impl::dispatched_kernels();
+            }
+            /**
+             * \~english
+             * @brief Adds two arrays of equal length: `r = a + b`.
+             * @return The carry out (0 or 1).
+             * \~russian
+             * @brief Складывает два массива одинаковой длины: `r = a + b`.
+             * @return Перенос из старшего слова (0 или 1).
+             */
+            template<typename _Ty>
+            static constexpr _Ty add_n(_Ty* r, const _Ty* a, const _Ty* b, size_t n) noexcept {
+                if constexpr (std::is_same_v<_Ty, uint64_t>) {
+                    if (const impl::KernelTable* k = dispatched(n)) return k->add_n(r, a, b, n);
+                }
+                _Ty carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    r[i] = OverflowAwareOps::sum<_Ty>(a[i], b[i], carry);
+                }
+                return carry;
+            }
+            /**
+             * \~english
+             * @brief Adds a single limb to an array: `r = a + b`.
+             * @return The carry out (0 or 1).
+             * \~russian
+             * @brief Прибавляет одно слово к массиву: `r = a + b`.
+             * @return Перенос из старшего слова (0 или 1).
+             */
+            template<typename _Ty>
+            static constexpr _Ty add_1(_Ty* r, const _Ty* a, size_t n, _Ty b) noexcept {
+                _Ty carry = b;
+                for (size_t i = 0; i < n; ++i) {
+                    _Ty sum = static_cast<_Ty>(a[i] + carry);
+                    carry = (sum < carry) ? 1 : 0;
+                    r[i] = sum;
+                }
+                return carry;
+            }
+            /**
+             * \~english
+             * @brief Adds arrays of different lengths: `r[0..an) = a + b`, requires `an >= bn`.
+             * @return The carry out (0 or 1).
+             * \~russian
+             * @brief Складывает массивы разной длины: `r[0..an) = a + b`, требуется `an >= bn`.
+             * @return Перенос из старшего слова (0 или 1).
+             */
+            template<typename _Ty>
+            static constexpr _Ty add(_Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn) noexcept {
+                _Ty carry = add_n(r, a, b, bn);
+                return add_1(r + bn, a + bn, an - bn, carry);
+            }
+            /**
+             * \~english
+             * @brief Subtracts two arrays of equal length: `r = a - b`.
+             * @return The borrow out (0 or 1).
+             * \~russian
+             * @brief Вычитает два массива одинаковой длины: `r = a - b`.
+             * @return Заём из старшего слова (0 или 1).
+             */
+            template<typename _Ty>
+            static constexpr _Ty sub_n(_Ty* r, const _Ty* a, const _Ty* b, size_t n) noexcept {
+                if constexpr (std::is_same_v<_Ty, uint64_t>) {
+                    if (const impl::KernelTable* k = dispatched(n)) return k->sub_n(r, a, b, n);
+                }
+                _Ty borrow = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    r[i] = OverflowAwareOps::subtract<_Ty>(a[i], b[i], borrow);
+                }
+                return borrow;
+            }
+            /**
+             * \~english
+             * @brief Subtracts a single limb from an array: `r = a - b`.
+             * @return The borrow out (0 or 1).
+             * \~russian
+             * @brief Вычитает одно слово из массива: `r = a - b`.
+             * @return Заём из старшего слова (0 или 1).
+             */
+            template<typename _Ty>
+            static constexpr _Ty sub_1(_Ty* r, const _Ty* a, size_t n, _Ty b) noexcept {
+                _Ty borrow = b;
+                for (size_t i = 0; i < n; ++i) {
+                    _Ty ai = a[i];
+                    r[i] = static_cast<_Ty>(ai - borrow);
+                    borrow = (ai < borrow) ? 1 : 0;
+                }
+                return borrow;
+            }
+            /**
+             * \~english
+             * @brief Subtracts arrays of different lengths: `r[0..an) = a - b`, requires `an >= bn`.
+             * @return The borrow out (0 or 1).
+             * \~russian
+             * @brief Вычитает массивы разной длины: `r[0..an) = a - b`, требуется `an >= bn`.
+             * @return Заём из старшего слова (0 или 1).
+             */
+            template<typename _Ty>
+            static constexpr _Ty sub(_Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn) noexcept {
+                _Ty borrow = sub_n(r, a, b, bn);
+                return sub_1(r + bn, a + bn, an - bn, borrow);
+            }
+            /**
+             * \~english
+             * @brief Multiplies an array by a single limb: `r = a * b`.
+             * @return The high limb of the product.
+             * \~russian
+             * @brief Умножает массив на одно слово: `r = a * b`.
+             * @return Старшее слово произведения.
+             */
+            template<typename _Ty>
+            static constexpr _Ty mul_1(_Ty* r, const _Ty* a, size_t n, _Ty b) noexcept {
+                if constexpr (std::is_same_v<_Ty, uint64_t>) {
+                    if (const impl::KernelTable* k = dispatched(n)) return k->mul_1(r, a, n, b);
+                }
+                _Ty carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    _Ty high = 0, overflow = 0;
+                    _Ty low = OverflowAwareOps::multiply(a[i], b, high);
+                    r[i] = OverflowAwareOps::sum<_Ty>(low, carry, overflow);
+                    carry = static_cast<_Ty>(high + overflow);
+                }
+                return carry;
+            }
+            /**
+             * \~english
+             * @brief Multiplies an array by a single limb and accumulates: `r += a * b`.
+             * @return The limb carried out of `r[n - 1]`.
+             * \~russian
+             * @brief Умножает массив на одно слово с накоплением: `r += a * b`.
+             * @return Слово, перенесённое за пределы `r[n - 1]`.
+             */
+            template<typename _Ty>
+            static constexpr _Ty addmul_1(_Ty* r, const _Ty* a, size_t n, _Ty b) noexcept {
+                if constexpr (std::is_same_v<_Ty, uint64_t>) {
+                    if (const impl::KernelTable* k = dispatched(n)) return k->addmul_1(r, a, n, b);
+                }
+                _Ty carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    _Ty high = 0, overflow = 0;
+                    _Ty low = OverflowAwareOps::multiply(a[i], b, high);
+                    low = OverflowAwareOps::sum<_Ty>(low, r[i], overflow);
+                    high = static_cast<_Ty>(high + overflow);
+                    overflow = 0;
+                    r[i] = OverflowAwareOps::sum<_Ty>(low, carry, overflow);
+                    carry = static_cast<_Ty>(high + overflow);
+                }
+                return carry;
+            }
+            /**
+             * \~english
+             * @brief Multiplies an array by a single limb and subtracts: `r -= a * b`.
+             * @return The limb borrowed from beyond `r[n - 1]`.
+             * \~russian
+             * @brief Умножает массив на одно слово с вычитанием: `r -= a * b`.
+             * @return Слово, занятое из-за пределов `r[n - 1]`.
+             */
+            template<typename _Ty>
+            static constexpr _Ty submul_1(_Ty* r, const _Ty* a, size_t n, _Ty b) noexcept {
+                if constexpr (std::is_same_v<_Ty, uint64_t>) {
+                    if (const impl::KernelTable* k = dispatched(n)) return k->submul_1(r, a, n, b);
+                }
+                _Ty carry = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    _Ty high = 0, overflow = 0;
+                    _Ty low = OverflowAwareOps::multiply(a[i], b, high);
+                    low = OverflowAwareOps::sum<_Ty>(low, carry, overflow);
+                    high = static_cast<_Ty>(high + overflow);
+                    overflow = 0;
+                    r[i] = OverflowAwareOps::subtract<_Ty>(r[i], low, overflow);
+                    carry = static_cast<_Ty>(high + overflow);
+                }
+                return carry;
+            }
+            /**
+             * \~english
+             * @brief Shifts an array left by `shift` bits (`0 < shift < limb width`): `r = a << shift`.
+             *
+             * `r` may be equal to `a` or start above it.
+             * @return The bits shifted out of `a[n - 1]`, in the low positions.
+             * \~russian
+             * @brief Сдвигает массив влево на `shift` бит (`0 < shift < ширины слова`): `r = a << shift`.
+             *
+             * `r` может совпадать с `a` или начинаться выше него.
+             * @return Биты, вытесненные из `a[n - 1]`, в младших позициях.
+             */
+            template<typename _Ty>
+            static constexpr _Ty lshift(_Ty* r, const _Ty* a, size_t n, unsigned shift) noexcept {
+                constexpr unsigned BITS = std::numeric_limits<_Ty>::digits;
+                _Ty out = static_cast<_Ty>(a[n - 1] >> (BITS - shift));
+                for (size_t i = n - 1; i > 0; --i) {
+                    r[i] = static_cast<_Ty>((a[i] << shift) | (a[i - 1] >> (BITS - shift)));
+                }
+                r[0] = static_cast<_Ty>(a[0] << shift);
+                return out;
+            }
+            /**
+             * \~english
+             * @brief Shifts an array right by `shift` bits (`0 < shift < limb width`): `r = a >> shift`.
+             *
+             * `r` may be equal to `a` or start below it.
+             * @return The bits shifted out of `a[0]`, in the high positions.
+             * \~russian
+             * @brief Сдвигает массив вправо на `shift` бит (`0 < shift < ширины слова`): `r = a >> shift`.
+             *
+             * `r` может совпадать с `a` или начинаться ниже него.
+             * @return Биты, вытесненные из `a[0]`, в старших позициях.
+             */
+            template<typename _Ty>
+            static constexpr _Ty rshift(_Ty* r, const _Ty* a, size_t n, unsigned shift) noexcept {
+                constexpr unsigned BITS = std::numeric_limits<_Ty>::digits;
+                _Ty out = static_cast<_Ty>(a[0] << (BITS - shift));
+                for (size_t i = 0; i + 1 < n; ++i) {
+                    r[i] = static_cast<_Ty>((a[i] >> shift) | (a[i + 1] << (BITS - shift)));
+                }
+                r[n - 1] = static_cast<_Ty>(a[n - 1] >> shift);
+                return out;
+            }
+            /**
+             * \~english
+             * @brief Divides an array by a single limb: `q = a / d`.
+             * @return The remainder `a % d`.
+             * \~russian
+             * @brief Делит массив на одно слово: `q = a / d`.
+             * @return Остаток `a % d`.
+             */
+            template<typename _Ty>
+            static _Ty divrem_1(_Ty* q, const _Ty* a, size_t n, _Ty d) noexcept {
+                _Ty remainder = 0;
+                for (size_t i = n; i-- > 0;) {
+                    q[i] = OverflowAwareOps::divide<_Ty>(remainder, a[i], d, remainder);
+                }
+                return remainder;
+            }
+            /**
+             * \~english
+             * @brief Remainder of an array divided by a single limb: `a % d`, without storing the quotient.
+             * \~russian
+             * @brief Остаток от деления массива на одно слово: `a % d`, без сохранения частного.
+             */
+            template<typename _Ty>
+            static _Ty mod_1(const _Ty* a, size_t n, _Ty d) noexcept {
+                _Ty remainder = 0;
+                for (size_t i = n; i-- > 0;) {
+                    OverflowAwareOps::divide<_Ty>(remainder, a[i], d, remainder);
+                }
+                return remainder;
+            }
+            /**
+             * \~english
+             * @brief Compares two arrays of equal length.
+             * @return Negative, zero or positive, like `memcmp`.
+             * \~russian
+             * @brief Сравнивает два массива одинаковой длины.
+             * @return Отрицательное, ноль или положительное значение, как `memcmp`.
+             */
+            template<typename _Ty>
+            static constexpr int cmp_n(const _Ty* a, const _Ty* b, size_t n) noexcept {
+                for (size_t i = n; i-- > 0;) {
+                    if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+                }
+                return 0;
+            }
+            /**
+             * \~english
+             * @brief Returns the length of the array without its high zero limbs.
+             * \~russian
+             * @brief Возвращает длину массива без старших нулевых слов.
+             */
+            template<typename _Ty>
+            static constexpr size_t normalized_size(const _Ty* a, size_t n) noexcept {
+                while (n > 0 && a[n - 1] == 0) --n;
+                return n;
+            }
+            /**
+             * \~english
+             * @brief Number of trailing zero bits of a nonzero limb.
+             * \~russian
+             * @brief Количество младших нулевых бит ненулевого слова.
+             */
+            template<typename _Ty>
+            static unsigned count_trailing_zeros(_Ty x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+                return static_cast<unsigned>(__builtin_ctzll(static_cast<unsigned long long>(x)));
+#elif defined(_MSC_VER) && defined(_M_X64)
+                unsigned long index;
+                _BitScanForward64(&index, static_cast<unsigned long long>(x));
+                return static_cast<unsigned>(index);
+#else
+                unsigned count = 0;
+                for (; (x & 1) == 0; x = static_cast<_Ty>(x >> 1)) ++count;
+                return count;
+#endif
+            }
+            /**
+             * \~english
+             * @brief Number of leading zero bits of a nonzero limb.
+             * \~russian
+             * @brief Количество старших нулевых бит ненулевого слова.
+             */
+            template<typename _Ty>
+            static unsigned count_leading_zeros(_Ty x) noexcept {
+                constexpr unsigned PAD = 64 - std::numeric_limits<_Ty>::digits;
+#if defined(__GNUC__) || defined(__clang__)
+                return static_cast<unsigned>(__builtin_clzll(static_cast<unsigned long long>(x))) - PAD;
+#elif defined(_MSC_VER) && defined(_M_X64)
+                unsigned long index;
+                _BitScanReverse64(&index, static_cast<unsigned long long>(x));
+                return 63 - static_cast<unsigned>(index) - PAD;
+#else
+                unsigned count = 0;
+                for (_Ty top = _Ty(1) << (std::numeric_limits<_Ty>::digits - 1); (x & top) == 0; x = static_cast<_Ty>(x << 1)) ++count;
+                return count;
+#endif
+            }
+            /**
+             * \~english
+             * @brief Number of significant bits of a limb (0 for 0).
+             * \~russian
+             * @brief Количество значащих бит слова (0 для 0).
+             */
+            template<typename _Ty>
+            static unsigned bit_width(_Ty x) noexcept {
+                return x == 0 ? 0 : std::numeric_limits<_Ty>::digits - count_leading_zeros(x);
+            }
+            /**
+             * \~english
+             * @brief Number of set bits of a limb.
+             * \~russian
+             * @brief Количество единичных бит слова.
+             */
+            template<typename _Ty>
+            static unsigned popcount(_Ty x) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+                return static_cast<unsigned>(__builtin_popcountll(static_cast<unsigned long long>(x)));
+#else
+                // SWAR: суммы по 2, 4, 8 бит, затем сложение байтов умножением
+                uint64_t v = static_cast<uint64_t>(x);
+                v = v - ((v >> 1) & 0x5555555555555555ULL);
+                v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+                v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+                return static_cast<unsigned>((v * 0x0101010101010101ULL) >> 56);
+#endif
+            }
+            /**
+             * \~english
+             * @brief Number of set bits in an array.
+             * \~russian
+             * @brief Количество единичных бит в массиве.
+             */
+            template<typename _Ty>
+            static size_t popcount_n(const _Ty* a, size_t n) noexcept {
+                size_t count = 0;
+                for (size_t i = 0; i < n; ++i) count += popcount(a[i]);
+                return count;
+            }
+            /**
+             * \~english
+             * @brief Limb-wise `r = a & b`, `r = a | b`, `r = a ^ b` and `r = ~a`.
+             *
+             * Branch-free loops over independent limbs that compilers vectorize; `r` may equal `a` or `b`.
+             * \~russian
+             * @brief Пословные `r = a & b`, `r = a | b`, `r = a ^ b` и `r = ~a`.
+             *
+             * Циклы без ветвлений по независимым словам, которые компилятор векторизует; `r` может совпадать с `a` или `b`.
+             */
+            template<typename _Ty>
+            static constexpr void and_n(_Ty* r, const _Ty* a, const _Ty* b, size_t n) noexcept {
+                for (size_t i = 0; i < n; ++i) r[i] = static_cast<_Ty>(a[i] & b[i]);
+            }
+            template<typename _Ty>
+            static constexpr void ior_n(_Ty* r, const _Ty* a, const _Ty* b, size_t n) noexcept {
+                for (size_t i = 0; i < n; ++i) r[i] = static_cast<_Ty>(a[i] | b[i]);
+            }
+            template<typename _Ty>
+            static constexpr void xor_n(_Ty* r, const _Ty* a, const _Ty* b, size_t n) noexcept {
+                for (size_t i = 0; i < n; ++i) r[i] = static_cast<_Ty>(a[i] ^ b[i]);
+            }
+            template<typename _Ty>
+            static constexpr void com_n(_Ty* r, const _Ty* a, size_t n) noexcept {
+                for (size_t i = 0; i < n; ++i) r[i] = static_cast<_Ty>(~a[i]);
+            }
+            /**
+             * \~english
+             * @brief Shifts an array left by any number of bits in place: `a[0..n + bits / W + 1) = a[0..n) << bits`.
+             *
+             * `a` must have room for `n + bits / W + 1` limbs. Whole limbs are moved with `memmove`,
+             * the remaining bits with one pass of `lshift`.
+             * \~russian
+             * @brief Сдвигает массив влево на произвольное число бит на месте: `a[0..n + bits / W + 1) = a[0..n) << bits`.
+             *
+             * В `a` должно быть место под `n + bits / W + 1` слов. Целые слова переносятся через `memmove`,
+             * оставшиеся биты — одним проходом `lshift`.
+             */
+            template<typename _Ty>
+            static void lshift_inplace(_Ty* a, size_t n, size_t bits) noexcept {
+                constexpr size_t BITS = std::numeric_limits<_Ty>::digits;
+                const size_t words = bits / BITS;
+                const unsigned rem = static_cast<unsigned>(bits % BITS);
+                if (n == 0) {
+                    std::fill(a, a + words + 1, _Ty(0));
+                    return;
+                }
+                if (rem != 0) a[n + words] = lshift(a + words, a, n, rem);
+                else {
+                    std::copy_backward(a, a + n, a + n + words);
+                    a[n + words] = 0;
+                }
+                std::fill(a, a + words, _Ty(0));
+            }
+            /**
+             * \~english
+             * @brief Shifts an array right by any number of bits in place, dropping the low bits.
+             * @return The new length `n - bits / W` (0 if everything was shifted out) and whether any dropped bit was set.
+             * \~russian
+             * @brief Сдвигает массив вправо на произвольное число бит на месте, отбрасывая младшие биты.
+             * @return Новую длину `n - bits / W` (0, если всё вытеснено) и признак того, что среди отброшенных бит была единица.
+             */
+            template<typename _Ty>
+            static std::pair<size_t, bool> rshift_inplace(_Ty* a, size_t n, size_t bits) noexcept {
+                constexpr size_t BITS = std::numeric_limits<_Ty>::digits;
+                const size_t words = bits / BITS;
+                const unsigned rem = static_cast<unsigned>(bits % BITS);
+                const size_t dropped = std::min(words, n);
+                bool inexact = std::any_of(a, a + dropped, [](_Ty limb) { return limb != 0; });
+                if (words >= n) return { 0, inexact };
+                const size_t size = n - words;
+                if (rem != 0) inexact |= rshift(a, a + words, size, rem) != 0;
+                else if (words != 0) std::copy(a + words, a + n, a);
+                return { size, inexact };
+            }
+            /**
+             * \~english
+             * @brief Schoolbook multiplication: `r[0..an+bn) = a * b`.
+             *
+             * `r` must not overlap the inputs.
+             * \~russian
+             * @brief Умножение «в столбик»: `r[0..an+bn) = a * b`.
+             *
+             * `r` не должен пересекаться со входами.
+             */
+            template<typename _Ty>
+            static constexpr void mul_basecase(_Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn) noexcept {
+                r[an] = mul_1(r, a, an, b[0]);
+                for (size_t j = 1; j < bn; ++j) {
+                    r[an + j] = addmul_1(r + j, a, an, b[j]);
+                }
+            }
+            /**
+             * \~english
+             * @brief Inverse of an odd limb modulo `B = 2^W`: `a * binvert_limb(a) == 1 (mod B)`.
+             *
+             * Newton iteration `x = x * (2 - a * x)` doubles the number of correct low bits;
+             * `x = a` is already correct in the 3 low bits for any odd `a`.
+             * \~russian
+             * @brief Обратное к нечётному слову по модулю `B = 2^W`: `a * binvert_limb(a) == 1 (mod B)`.
+             *
+             * Итерация Ньютона `x = x * (2 - a * x)` удваивает число верных младших бит;
+             * для любого нечётного `a` у `x = a` уже верны 3 младших бита.
+             */
+            template<typename _Ty>
+            static constexpr _Ty binvert_limb(_Ty a) noexcept {
+                // Считаем в uint64_t: узкие слова иначе продвигаются до знакового int
+                uint64_t x = a;
+                for (unsigned bits = 3; bits < static_cast<unsigned>(std::numeric_limits<_Ty>::digits); bits *= 2) {
+                    x *= 2 - static_cast<uint64_t>(a) * x;
+                }
+                return static_cast<_Ty>(x);
+            }
+            /**
+             * \~english
+             * @brief Montgomery reduction: `r[0..n) = t * B^-n mod m` for `t[0..2n) < m * B^n`.
+             *
+             * `minv` is `-m^-1 mod B` (see `binvert_limb`), `m[n - 1] != 0`. Each step adds
+             * `u * m` with `u = t[i] * minv` to zero out the low limb, so the reduction costs
+             * `n` passes of `addmul_1`. `t` is destroyed; `r` may alias `t`.
+             * \~russian
+             * @brief Редукция Монтгомери: `r[0..n) = t * B^-n mod m` для `t[0..2n) < m * B^n`.
+             *
+             * `minv` — это `-m^-1 mod B` (см. `binvert_limb`), `m[n - 1] != 0`. Каждый шаг прибавляет
+             * `u * m` с `u = t[i] * minv`, обнуляя младшее слово, поэтому редукция стоит
+             * `n` проходов `addmul_1`. `t` портится; `r` может совпадать с `t`.
+             */
+            template<typename _Ty>
+            static constexpr void redc(_Ty* r, _Ty* t, const _Ty* m, size_t n, _Ty minv) noexcept {
+                _Ty high = 0;  // перенос за пределы t[0..2n)
+                for (size_t i = 0; i < n; ++i) {
+                    const _Ty u = static_cast<_Ty>(static_cast<uint64_t>(t[i]) * minv);
+                    const _Ty carry = addmul_1(t + i, m, n, u);
+                    high += add_1(t + i + n, t + i + n, n - i, carry);
+                }
+                // Результат t[n..2n) + high * B^n меньше 2m: хватает одного вычитания
+                if (high != 0 || cmp_n(t + n, m, n) >= 0) sub_n(r, t + n, m, n);
+                else std::copy(t + n, t + 2 * n, r);
+            }
+            /**
+             * \~english
+             * @brief Multiplies two arrays: `r[0..an+bn) = a * b`, requires `an >= bn >= 1`.
+             *
+             * Dispatches by operand size to schoolbook, Karatsuba, Toom-3 or a three-prime
+             * number-theoretic transform (see `MultiplyThresholds`); squaring (`a == b`, `an == bn`)
+             * needs only one forward transform. `r` must not overlap the inputs.
+             * \~russian
+             * @brief Перемножает два массива: `r[0..an+bn) = a * b`, требуется `an >= bn >= 1`.
+             *
+             * По размеру операндов выбирает «столбик», Карацубу, Тоома-3 или теоретико-числовое
+             * преобразование по трём простым (см. `MultiplyThresholds`); возведению в квадрат (`a == b`, `an == bn`)
+             * хватает одного прямого преобразования. `r` не должен пересекаться со входами.
+             */
+            template<typename _Ty>
+            static void mul(_Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn);
+            /**
+             * \~english
+             * @brief Long division: `q[0..an-bn] = a / b`, `r[0..bn) = a % b`, requires `an >= bn >= 1`
+             * and `b[bn - 1] != 0`.
+             *
+             * Uses Knuth's Algorithm D on normalized operands (one quotient limb per step)
+             * and `divrem_1` when the divisor is a single limb. `q` and `r` must not overlap the inputs.
+             * \~russian
+             * @brief Деление «уголком»: `q[0..an-bn] = a / b`, `r[0..bn) = a % b`, требуется `an >= bn >= 1`
+             * и `b[bn - 1] != 0`.
+             *
+             * Использует алгоритм D Кнута на нормализованных операндах (одно слово частного за шаг)
+             * и `divrem_1`, если делитель состоит из одного слова. `q` и `r` не должны пересекаться со входами.
+             */
+            template<typename _Ty>
+            static void divrem(_Ty* q, _Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn);
+            /**
+             * \~english
+             * @brief Number of decimal digits handled per limb step: the largest `k` with `10^k` fitting in `_Ty`.
+             * \~russian
+             * @brief Количество десятичных цифр на одно слово: наибольшее `k`, при котором `10^k` помещается в `_Ty`.
+             */
+            template<typename _Ty>
+            static constexpr unsigned chunk_digits() noexcept { return std::numeric_limits<_Ty>::digits10; }
+            /**
+             * \~english
+             * @brief `10^chunk_digits<_Ty>()`, the radix of one limb step.
+             * \~russian
+             * @brief `10^chunk_digits<_Ty>()` — основание одного шага по словам.
+             */
+            template<typename _Ty>
+            static constexpr _Ty chunk_base() noexcept {
+                _Ty base = 1;
+                for (unsigned i = 0; i < chunk_digits<_Ty>(); ++i) base = static_cast<_Ty>(base * 10);
+                return base;
+            }
+            /**
+             * \~english
+             * @brief Formats the magnitude `a[0..n)` as decimal digits (no sign, `"0"` for zero).
+             *
+             * Small numbers are divided by `chunk_base()` one limb step at a time. From
+             * `ConversionThresholds::GET_STR_DC` limbs the number is split by cached powers
+             * `10^(chunk_digits * 2^k)` using Barrett reduction with cached reciprocals,
+             * so the cost follows multiplication.
+             * \~russian
+             * @brief Переводит модуль `a[0..n)` в десятичные цифры (без знака, `"0"` для нуля).
+             *
+             * Небольшие числа делятся на `chunk_base()` по слову за шаг. Начиная с
+             * `ConversionThresholds::GET_STR_DC` слов число делится на кэшированные степени
+             * `10^(chunk_digits * 2^k)` редукцией Барретта с кэшированными обратными величинами,
+             * поэтому стоимость определяется умножением.
+             */
+            template<typename _Ty>
+            static std::string get_str(const _Ty* a, size_t n);
+            /**
+             * \~english
+             * @brief Parses a string of decimal digits (no sign) into a normalized magnitude.
+             *
+             * Digits are folded `chunk_digits()` at a time; long strings are split in two at
+             * a cached power of 10 and recombined with `mul`. Zero yields an empty vector.
+             * \~russian
+             * @brief Разбирает строку десятичных цифр (без знака) в нормализованный модуль.
+             *
+             * Цифры сворачиваются по `chunk_digits()` за шаг; длинные строки делятся надвое
+             * по кэшированной степени 10 и собираются обратно через `mul`. Для нуля возвращается пустой вектор.
+             */
+            template<typename _Ty>
+            static std::vector<_Ty> set_str(std::string_view digits);
+            /**
+             * \~english
+             * @brief Builds the cached powers of 10 and their reciprocals that `get_str`/`set_str` use for up to `digits` decimal digits.
+             *
+             * The cache is shared by all threads and read without locks; this only moves its growth to a chosen moment.
+             * \~russian
+             * @brief Строит кэшированные степени 10 и обратные к ним, которые `get_str`/`set_str` используют для чисел до `digits` цифр.
+             *
+             * Кэш общий для всех потоков и читается без блокировок; вызов лишь переносит его рост в выбранный момент.
+             */
+            template<typename _Ty>
+            static void preload_powers(size_t digits);
+            /**
+             * \~english
+             * @brief Receives the next piece of digits from `get_str_to`; `context` is the pointer passed to it.
+             * \~russian
+             * @brief Получает очередной кусок цифр от `get_str_to`; `context` — переданный ему указатель.
+             */
+            using DigitWriter = void (*)(void* context, const char* digits, size_t count);
+            /**
+             * \~english
+             * @brief Formats the magnitude `a[0..n)` like `get_str`, but hands the digits to `write` piece by piece, most significant first.
+             *
+             * The same divide-and-conquer split, run depth-first: every dividend is released right after its division,
+             * so the working memory stays within a small multiple of the binary size and no full digit string is built.
+             * \~russian
+             * @brief Переводит модуль `a[0..n)` как `get_str`, но отдаёт цифры в `write` кусками, начиная со старших.
+             *
+             * То же деление «разделяй и властвуй», выполняемое в глубину: каждое делимое освобождается сразу после деления,
+             * поэтому рабочая память не превышает небольшого кратного двоичного размера, а строка цифр целиком не строится.
+             */
+            template<typename _Ty>
+            static void get_str_to(const _Ty* a, size_t n, DigitWriter write, void* context);
+            /**
+             * \~english
+             * @brief `high = high * 10^digits + low` for a normalized `low < 10^digits`.
+             *
+             * When `digits` is `chunk_digits * 2^k` the power comes from the cache shared with `set_str`,
+             * which is how a streaming parser joins equal-length pieces of digits.
+             * \~russian
+             * @brief `high = high * 10^digits + low` для нормализованного `low < 10^digits`.
+             *
+             * Если `digits` равно `chunk_digits * 2^k`, степень берётся из общего с `set_str` кэша —
+             * так потоковый разбор склеивает куски цифр одинаковой длины.
+             */
+            template<typename _Ty>
+            static void mul_pow10_add(std::vector<_Ty>& high, const std::vector<_Ty>& low, size_t digits);
+        };
+    }
+}
@@ -0,0 +1,76 @@
+﻿#pragma once
+#include "Internal.h"
+
+namespace numsystem {
+    /**
+     * \~english
+     * @brief Makes numbers created on the current thread allocate from `resource` while the guard is alive.
+     *
+     * Applies to every `BinaryArithmetic` / `FactorialArithmetic` constructed in the scope, including
+     * the temporaries and scratch buffers of `multiply`, `divide`, `divmod`, etc. A value keeps the
+     * resource it was created with, so it must not outlive that resource (or its `reset()`);
+     * assigning it to a value created outside of the scope copies the digits.
+     * Guards nest: the destructor restores the previously active resource.
+     * \~russian
+     * @brief Пока защитник жив, числа, создаваемые в текущем потоке, выделяют память из `resource`.
+     *
+     * Действует на все `BinaryArithmetic` / `FactorialArithmetic`, созданные в области видимости,
+     * включая временные значения и рабочие буферы `multiply`, `divide`, `divmod` и т. д. Значение
+     * сохраняет ресурс, с которым создано, поэтому не должно переживать этот ресурс (или его `reset()`);
+     * присваивание значению, созданному вне области, копирует разряды.
+     * Защитники вкладываются: деструктор восстанавливает предыдущий ресурс.
+     */
+    class ScopedMemoryResource {
+    public:
+        explicit ScopedMemoryResource(std::pmr::memory_resource* resource) noexcept
+            : _previous(impl::current_resource_slot()) {
+            impl::current_resource_slot() = resource;
+        }
+        ~ScopedMemoryResource() { impl::current_resource_slot() = _previous; }
+
+        ScopedMemoryResource(const ScopedMemoryResource&) = delete;
+        ScopedMemoryResource& operator=(const ScopedMemoryResource&) = delete;
+    private:
+        std::pmr::memory_resource* _previous;
+    };
+
+    /**
+     * \~english
+     * @brief Monotonic arena: allocation is a pointer bump, deallocation is a no-op,
+     * and `reset()` frees everything allocated so far at once.
+     * \~russian
+     * @brief Монотонная арена: выделение — сдвиг указателя, освобождение ничего не делает,
+     * а `reset()` разом освобождает всё выделенное.
+     */
+    class Arena : public std::pmr::monotonic_buffer_resource {
+    public:
+        /// \~english @brief Creates an arena whose first block holds `initial_size` bytes.
+        /// \~russian @brief Создаёт арену, первый блок которой вмещает `initial_size` байт.
+        explicit Arena(size_t initial_size = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : std::pmr::monotonic_buffer_resource(initial_size, upstream) {}
+
+        /// \~english @brief Frees all memory handed out by the arena. Values allocated from it become invalid.
+        /// \~russian @brief Освобождает всю выданную ареной память. Значения, выделенные из неё, становятся недействительными.
+        void reset() noexcept { release(); }
+    };
+
+    /**
+     * \~english
+     * @brief Single-threaded pool with one free list per size class: freed limb buffers are reused
+     * by the next allocation of the same size instead of going back to the global allocator.
+     * \~russian
+     * @brief Однопоточный пул со списком свободных блоков на каждый класс размеров: освобождённые
+     * буферы слов переиспользуются следующим выделением того же размера, а не возвращаются в общий аллокатор.
+     */
+    class LimbPool : public std::pmr::unsynchronized_pool_resource {
+    public:
+        /// \~english @brief Creates a pool that serves blocks up to `largest_block` bytes from its size classes.
+        /// \~russian @brief Создаёт пул, который выдаёт блоки до `largest_block` байт из своих классов размеров.
+        explicit LimbPool(size_t largest_block = 64 * 1024, std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : std::pmr::unsynchronized_pool_resource(std::pmr::pool_options{ 0, largest_block }, upstream) {}
+
+        /// \~english @brief Returns all memory to the upstream resource. Values allocated from the pool become invalid.
+        /// \~russian @brief Возвращает всю память вышестоящему ресурсу. Значения, выделенные из пула, становятся недействительными.
+        void reset() { release(); }
+    };
+}
@@ -0,0 +1,108 @@
+﻿#pragma once
+#include "BinaryArithmetic.h"
+
+namespace numsystem {
+    /**
+     * \~english
+     * @brief Precomputed reduction data for a fixed modulus `m > 0`, reusable across any number of operations.
+     *
+     * For an odd modulus the context works in the Montgomery domain: it keeps
+     * `-m^-1 mod B`, `R mod m` and `R^2 mod m` (`R = B^n`, `n` is the limb count of `m`), and every
+     * modular product is one multiplication plus one `redc` pass — no long division.
+     * An even modulus falls back to Knuth division of the double-width product by `m`.
+     *
+     * Results are always reduced into `[0, m)`; operands may be negative or larger than `m`.
+     * The context is immutable after construction, so one instance may be shared between threads.
+     * \~russian
+     * @brief Предвычисленные данные редукции для фиксированного модуля `m > 0`, пригодные для любого числа операций.
+     *
+     * Для нечётного модуля контекст работает в представлении Монтгомери: хранит
+     * `-m^-1 mod B`, `R mod m` и `R^2 mod m` (`R = B^n`, `n` — число слов `m`), и каждое
+     * модульное произведение — одно умножение и один проход `redc` без деления «уголком».
+     * Для чётного модуля используется деление Кнута произведения двойной длины на `m`.
+     *
+     * Результаты всегда приведены к `[0, m)`; операнды могут быть отрицательными или больше `m`.
+     * После создания контекст не меняется, поэтому один экземпляр можно использовать из нескольких потоков.
+     */
+    template<typename Limb>
+    class BasicModContext {
+    public:
+        using number_type = BasicBinaryArithmetic<Limb>;
+
+        /// \~english @brief Precomputes the constants for `modulus`. @throws std::domain_error if `modulus <= 0`.
+        /// \~russian @brief Предвычисляет константы для `modulus`. @throws std::domain_error Если `modulus <= 0`.
+        explicit BasicModContext(const number_type& modulus);
+
+        /// \~english @brief The modulus `m`.
+        /// \~russian @brief Модуль `m`.
+        [[nodiscard]] const number_type& modulus() const noexcept { return _modulus; }
+        /// \~english @brief `true` if products are reduced by Montgomery multiplication (odd modulus).
+        /// \~russian @brief `true`, если произведения приводятся умножением Монтгомери (нечётный модуль).
+        [[nodiscard]] bool montgomery() const noexcept { return _montgomery; }
+
+        /// \~english @brief `a mod m` in `[0, m)`.
+        /// \~russian @brief `a mod m` в `[0, m)`.
+        [[nodiscard]] number_type reduce(const number_type& a) const;
+        /// \~english @brief `a * b mod m`.
+        /// \~russian @brief `a * b mod m`.
+        [[nodiscard]] number_type mulmod(const number_type& a, const number_type& b) const;
+        /**
+         * \~english
+         * @brief `base^exponent mod m` by sliding-window exponentiation.
+         *
+         * The window grows with the exponent length (up to 6 bits), so a 2048-bit exponent takes about
+         * 2048 squarings and 350 multiplications. A negative exponent raises `modinv(base)`.
+         * @throws std::domain_error if the exponent is negative and `base` is not invertible.
+         * \~russian
+         * @brief `base^exponent mod m` возведением в степень скользящим окном.
+         *
+         * Окно растёт с длиной показателя (до 6 бит), поэтому 2048-битный показатель обходится примерно
+         * в 2048 возведений в квадрат и 350 умножений. Отрицательный показатель возводит `modinv(base)`.
+         * @throws std::domain_error Если показатель отрицателен, а `base` необратим.
+         */
+        [[nodiscard]] number_type powmod(const number_type& base, const number_type& exponent) const;
+        /// \~english @brief `x` in `[0, m)` with `a * x == 1 (mod m)`. @throws std::domain_error if `gcd(a, m) != 1`.
+        /// \~russian @brief `x` в `[0, m)`, для которого `a * x == 1 (mod m)`. @throws std::domain_error Если `gcd(a, m) != 1`.
+        [[nodiscard]] number_type modinv(const number_type& a) const;
+
+    private:
+        using value_type = Limb;
+        using Limbs = std::vector<value_type>;
+
+        number_type _modulus;
+        Limbs _m;                   // модуль, ровно n слов
+        Limbs _one;                 // единица в рабочем представлении: R mod m или 1
+        Limbs _r2;                  // R^2 mod m для перевода в представление Монтгомери
+        value_type _minv = 0;       // -m^-1 mod B
+        bool _montgomery = false;
+
+        // a mod m в n словах (с учётом знака a)
+        void residue(const number_type& a, value_type* r) const;
+        // r = a * b в рабочем представлении; t — 2n слов, q — n + 1 слово рабочей памяти
+        void mul(value_type* r, const value_type* a, const value_type* b, value_type* t, value_type* q) const;
+        // Приведение t[0..tn) по модулю m делением
+        void divide_out(value_type* r, value_type* t, size_t tn, value_type* q) const;
+        [[nodiscard]] number_type make(const value_type* r) const;
+    };
+
+    // По умолчанию — 64-битные слова, как у BinaryArithmetic
+    using ModContext = BasicModContext<uint64_t>;
+
+    /// \~english @brief One-off `base^exponent mod modulus`; build a `BasicModContext` to reuse the modulus.
+    /// \~russian @brief Разовое `base^exponent mod modulus`; для повторного использования модуля создайте `BasicModContext`.
+    template<typename Limb>
+    [[nodiscard]] BasicBinaryArithmetic<Limb> powmod(const BasicBinaryArithmetic<Limb>& base, const BasicBinaryArithmetic<Limb>& exponent, const BasicBinaryArithmetic<Limb>& modulus) {
+        return BasicModContext<Limb>(modulus).powmod(base, exponent);
+    }
+    /// \~english @brief One-off inverse of `a` modulo `modulus`.
+    /// \~russian @brief Разовое обратное к `a` по модулю `modulus`.
+    template<typename Limb>
+    [[nodiscard]] BasicBinaryArithmetic<Limb> modinv(const BasicBinaryArithmetic<Limb>& a, const BasicBinaryArithmetic<Limb>& modulus) {
+        return BasicModContext<Limb>(modulus).modinv(a);
+    }
+
+    extern template class BasicModContext<uint8_t>;
+    extern template class BasicModContext<uint16_t>;
+    extern template class BasicModContext<uint32_t>;
+    extern template class BasicModContext<uint64_t>;
+}
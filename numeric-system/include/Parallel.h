@@ -0,0 +1,211 @@
+﻿#pragma once
+#include "Internal.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+/**
+ * \~english
+ * @brief Default operand size (in limbs) from which multiplication and decimal conversion split work across threads.
+ *
+ * Only used while a `ThreadPool` is active (see `ScopedParallelism`); each pool may override it.
+ * Can be overridden at build time (e.g. `-DNUMSYS_PARALLEL_THRESHOLD=4096`).
+ * \~russian
+ * @brief Размер операнда (в словах) по умолчанию, начиная с которого умножение и десятичное преобразование делят работу между потоками.
+ *
+ * Используется, только пока активен `ThreadPool` (см. `ScopedParallelism`); каждый пул может задать своё значение.
+ * Может быть переопределён при сборке (например, `-DNUMSYS_PARALLEL_THRESHOLD=4096`).
+ */
+#ifndef NUMSYS_PARALLEL_THRESHOLD
+#define NUMSYS_PARALLEL_THRESHOLD 2048
+#endif
+
+namespace numsystem {
+    class ThreadPool;
+
+    namespace impl {
+        /**
+         * \~english
+         * @brief One side of a fork: a type-erased callable plus its completion flag and exception.
+         * \~russian
+         * @brief Одна ветвь развилки: вызываемый объект со стёртым типом, флаг завершения и исключение.
+         */
+        struct ParallelTask {
+            void (*invoke)(void*) = nullptr;
+            void* callable = nullptr;
+            std::atomic<bool> done{ false };
+            std::exception_ptr error;
+
+            void run() noexcept {
+                try { invoke(callable); }
+                catch (...) { error = std::current_exception(); }
+                done.store(true, std::memory_order_release);
+            }
+        };
+
+        /**
+         * \~english
+         * @brief Thread-local pointer to the pool the kernels on this thread may split work across.
+         *
+         * Set through `numsystem::ScopedParallelism`; worker threads point at their own pool.
+         * \~russian
+         * @brief Указатель (на поток) на пул, между потоками которого ядра в этом потоке могут делить работу.
+         *
+         * Устанавливается через `numsystem::ScopedParallelism`; рабочие потоки указывают на свой пул.
+         */
+        inline ThreadPool*& current_pool_slot() noexcept {
+            static thread_local ThreadPool* pool = nullptr;
+            return pool;
+        }
+    }
+
+    /**
+     * \~english
+     * @brief Work-stealing thread pool for fork-join parallelism inside the arithmetic kernels.
+     *
+     * Every worker owns a deque: forked tasks are pushed to its back and popped back LIFO by the
+     * same worker, while idle workers steal from the front of the other deques. A thread waiting
+     * for a stolen task runs other tasks instead of blocking, so nested forks never deadlock.
+     * Forks from threads outside the pool go to a shared queue.
+     *
+     * Splitting only changes who computes disjoint parts of the result, never the result itself.
+     * \~russian
+     * @brief Пул потоков с перехватом работы для параллелизма «развилка — слияние» внутри арифметических ядер.
+     *
+     * У каждого рабочего потока своя очередь: задачи развилки кладутся в её конец и забираются
+     * обратно тем же потоком (LIFO), а простаивающие потоки перехватывают задачи из начала чужих очередей.
+     * Поток, ждущий перехваченную задачу, не блокируется, а выполняет другие задачи, поэтому вложенные
+     * развилки не приводят к взаимной блокировке. Развилки из потоков вне пула попадают в общую очередь.
+     *
+     * Разбиение меняет только то, кто считает непересекающиеся части результата, но не сам результат.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * \~english
+         * @brief Starts `threads` workers (at least one).
+         * @param threshold Operand size in limbs below which the kernels stay serial.
+         * \~russian
+         * @brief Запускает `threads` рабочих потоков (не меньше одного).
+         * @param threshold Размер операнда в словах, ниже которого ядра остаются последовательными.
+         */
+        explicit ThreadPool(size_t threads = std::thread::hardware_concurrency(), size_t threshold = NUMSYS_PARALLEL_THRESHOLD);
+        /// \~english @brief Finishes the queued tasks and joins the workers.
+        /// \~russian @brief Доделывает задачи из очереди и дожидается рабочих потоков.
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// \~english @brief Number of worker threads.
+        /// \~russian @brief Число рабочих потоков.
+        [[nodiscard]] size_t size() const noexcept { return _workers.size(); }
+        /// \~english @brief Operand size in limbs from which work is split.
+        /// \~russian @brief Размер операнда в словах, начиная с которого работа делится.
+        [[nodiscard]] size_t threshold() const noexcept { return _threshold; }
+
+        /**
+         * \~english
+         * @brief Runs all `tasks` and returns when every one has finished; the first one runs on the calling thread.
+         *
+         * If a task throws, the exception is rethrown after all of them have finished.
+         * \~russian
+         * @brief Выполняет все `tasks` и возвращается, когда каждая завершилась; первая выполняется в вызывающем потоке.
+         *
+         * Если задача бросила исключение, оно пробрасывается после завершения всех задач.
+         */
+        template<typename First, typename... Rest>
+        void invoke(First&& first, Rest&&... rest) {
+            if constexpr (sizeof...(Rest) == 0) {
+                first();
+            }
+            else {
+                // Хвост уходит одной задачей, которая сама делится дальше
+                auto tail = [&] { invoke(std::forward<Rest>(rest)...); };
+                impl::ParallelTask task;
+                task.invoke = [](void* callable) { (*static_cast<decltype(tail)*>(callable))(); };
+                task.callable = &tail;
+                push(&task);
+
+                std::exception_ptr error;
+                try { first(); }
+                catch (...) { error = std::current_exception(); }
+                join(&task);
+                if (error) std::rethrow_exception(error);
+                if (task.error) std::rethrow_exception(task.error);
+            }
+        }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<impl::ParallelTask*> tasks;
+        };
+
+        std::vector<std::thread> _workers;
+        std::deque<Queue> _queues;          // по очереди на рабочий поток и последняя — общая для внешних потоков
+        size_t _threshold;
+        std::mutex _sleep_mutex;
+        std::condition_variable _wake;
+        std::atomic<size_t> _pending{ 0 };
+        bool _stop = false;
+
+        void push(impl::ParallelTask* task);
+        void join(impl::ParallelTask* task);
+        // Своя очередь с конца, затем общая и чужие — с начала
+        impl::ParallelTask* find_task();
+        void work(size_t index);
+    };
+
+    /**
+     * \~english
+     * @brief Lets the kernels on the current thread split large operations across `pool` while the guard is alive.
+     *
+     * Karatsuba and Toom-3 products and divide-and-conquer decimal conversion run their independent
+     * halves in parallel once the operands reach `pool.threshold()` limbs. Work stays serial while a
+     * `ScopedMemoryResource` is active, because the arena and pool resources are single-threaded.
+     * Guards nest: the destructor restores the previously active pool.
+     * \~russian
+     * @brief Пока защитник жив, ядра в текущем потоке могут делить большие операции между потоками `pool`.
+     *
+     * Произведения Карацубы и Тоома-3 и десятичное преобразование «разделяй и властвуй» выполняют
+     * независимые половины параллельно, когда операнды достигают `pool.threshold()` слов. Пока активен
+     * `ScopedMemoryResource`, работа остаётся последовательной: арена и пул слов однопоточные.
+     * Защитники вкладываются: деструктор восстанавливает предыдущий пул.
+     */
+    class ScopedParallelism {
+    public:
+        explicit ScopedParallelism(ThreadPool& pool) noexcept
+            : _previous(impl::current_pool_slot()) {
+            impl::current_pool_slot() = &pool;
+        }
+        ~ScopedParallelism() { impl::current_pool_slot() = _previous; }
+
+        ScopedParallelism(const ScopedParallelism&) = delete;
+        ScopedParallelism& operator=(const ScopedParallelism&) = delete;
+    private:
+        ThreadPool* _previous;
+    };
+
+    namespace impl {
+        /**
+         * \~english
+         * @brief Runs `tasks` in parallel on the current pool if `size` reaches its threshold, otherwise one after another.
+         * \~russian
+         * @brief Выполняет `tasks` параллельно в текущем пуле, если `size` достигает его порога, иначе — по очереди.
+         */
+        template<typename... Tasks>
+        void parallel_invoke(size_t size, Tasks&&... tasks) {
+            ThreadPool* pool = current_pool_slot();
+            if (pool != nullptr && size >= pool->threshold() && current_resource_slot() == nullptr) {
+                pool->invoke(std::forward<Tasks>(tasks)...);
+            }
+            else {
+                (tasks(), ...);
+            }
+        }
+    }
+}
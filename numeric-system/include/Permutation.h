@@ -0,0 +1,76 @@
+#pragma once
+#include "FactorialArithmetic.h"
+#include <vector>
+
+namespace numsystem {
+    /**
+     * \~english
+     * @brief Lexicographic rank of a permutation of `0..n-1` (its Lehmer code) as a factorial number.
+     *
+     * The coefficient at `k!` is the number of elements after position `n-1-k` that are smaller than
+     * the element at that position, so the coefficients are written straight into the packed storage
+     * without any radix conversion. An order-statistic Fenwick tree makes the whole pass O(n log n).
+     * @throws std::invalid_argument if `permutation[0..n)` is not a permutation of `0..n-1`.
+     * \~russian
+     * @brief Лексикографический номер перестановки `0..n-1` (её код Лемера) в виде факториального числа.
+     *
+     * Коэффициент при `k!` — число элементов после позиции `n-1-k`, меньших элемента на этой позиции,
+     * поэтому коэффициенты пишутся прямо в упакованное хранилище без перевода между системами.
+     * Дерево Фенвика для порядковых статистик даёт O(n log n) на весь проход.
+     * @throws std::invalid_argument Если `permutation[0..n)` — не перестановка `0..n-1`.
+     */
+    [[nodiscard]] FactorialArithmetic rank_permutation(const size_t* permutation, size_t n);
+    [[nodiscard]] inline FactorialArithmetic rank_permutation(const std::vector<size_t>& permutation) {
+        return rank_permutation(permutation.data(), permutation.size());
+    }
+
+    /**
+     * \~english
+     * @brief Writes into `permutation[0..n)` the permutation of `0..n-1` with lexicographic rank `rank`, in O(n log n).
+     * @throws std::out_of_range if `rank` is negative or not less than `n!`.
+     * \~russian
+     * @brief Записывает в `permutation[0..n)` перестановку `0..n-1` с лексикографическим номером `rank` за O(n log n).
+     * @throws std::out_of_range Если `rank` отрицателен или не меньше `n!`.
+     */
+    void unrank_permutation(const FactorialArithmetic& rank, size_t* permutation, size_t n);
+    [[nodiscard]] inline std::vector<size_t> unrank_permutation(const FactorialArithmetic& rank, size_t n) {
+        std::vector<size_t> permutation(n);
+        unrank_permutation(rank, permutation.data(), n);
+        return permutation;
+    }
+
+    /**
+     * \~english
+     * @brief Walks the permutations of `0..n-1` in lexicographic order together with their ranks.
+     *
+     * `next()` increments the factorial rank in place: the carry clears the trailing coefficients
+     * that were at their maximum, and exactly that suffix of the permutation is rearranged, so a
+     * step costs amortized O(1) and the rank never goes through a decimal or binary conversion.
+     * \~russian
+     * @brief Перебирает перестановки `0..n-1` в лексикографическом порядке вместе с их номерами.
+     *
+     * `next()` увеличивает факториальный номер на месте: перенос обнуляет младшие коэффициенты,
+     * стоявшие на максимуме, и перестраивается ровно соответствующий хвост перестановки, поэтому
+     * шаг стоит O(1) в среднем, а номер не проходит через десятичное или двоичное представление.
+     */
+    class PermutationEnumerator {
+    public:
+        /// \~english @brief Starts at the identity permutation (rank 0).
+        /// \~russian @brief Начинает с тождественной перестановки (номер 0).
+        explicit PermutationEnumerator(size_t n);
+        /// \~english @brief Starts at the permutation with rank `start`; @throws std::out_of_range as `unrank_permutation`.
+        /// \~russian @brief Начинает с перестановки с номером `start`; @throws std::out_of_range как `unrank_permutation`.
+        PermutationEnumerator(size_t n, const FactorialArithmetic& start);
+
+        [[nodiscard]] size_t size() const noexcept { return _permutation.size(); }
+        [[nodiscard]] const std::vector<size_t>& permutation() const noexcept { return _permutation; }
+        [[nodiscard]] const FactorialArithmetic& rank() const noexcept { return _rank; }
+
+        /// \~english @brief Advances to the next permutation; returns `false` (and stays put) after the last one.
+        /// \~russian @brief Переходит к следующей перестановке; после последней возвращает `false` и остаётся на месте.
+        bool next();
+    private:
+        std::vector<size_t> _permutation;
+        FactorialArithmetic _rank;
+    };
+}
@@ -0,0 +1,153 @@
+﻿#pragma once
+#include "BinaryArithmetic.h"
+#include "FactorialArithmetic.h"
+#include <cstddef>
+
+namespace numsystem {
+    /**
+     * \~english
+     * @brief Version of the binary wire format written by `serialize_to`.
+     *
+     * A serialized value is a 16-byte header followed by its 64-bit words, all little-endian:
+     * - bytes 0-1: magic `'N'`, `'S'`;
+     * - byte 2: format version;
+     * - byte 3: kind, `1` for `BinaryArithmetic` (words are the magnitude limbs) or `2` for
+     *   `FactorialArithmetic` (words are the packed coefficients);
+     * - bytes 4-7: number of words (0 for zero);
+     * - bytes 8-15: the `StateInfo` word: bit 63 is the sign, bits 0-62 the auxiliary value
+     *   (the highest coefficient index of a factorial number, 0 for binary).
+     *
+     * The words start 16 bytes into the record and every record is a multiple of 8 bytes, so records
+     * written back to back into an 8-byte aligned buffer keep their words aligned for `BinaryArithmeticView`.
+     * \~russian
+     * @brief Версия двоичного формата, который пишет `serialize_to`.
+     *
+     * Сериализованное значение — 16-байтный заголовок и 64-битные слова, всё в порядке little-endian:
+     * - байты 0-1: метка `'N'`, `'S'`;
+     * - байт 2: версия формата;
+     * - байт 3: вид, `1` — `BinaryArithmetic` (слова — модуль), `2` — `FactorialArithmetic`
+     *   (слова — упакованные коэффициенты);
+     * - байты 4-7: число слов (0 для нуля);
+     * - байты 8-15: слово `StateInfo`: бит 63 — знак, биты 0-62 — вспомогательное значение
+     *   (номер старшего коэффициента факториального числа, 0 для двоичного).
+     *
+     * Слова начинаются с 16-го байта записи, а длина каждой записи кратна 8, поэтому записи, идущие подряд
+     * в буфере с выравниванием 8, сохраняют выравнивание слов для `BinaryArithmeticView`.
+     */
+    inline constexpr uint8_t SERIALIZATION_VERSION = 1;
+
+    /// \~english @brief Bytes `serialize_to` writes for `value`.
+    /// \~russian @brief Сколько байт `serialize_to` запишет для `value`.
+    [[nodiscard]] size_t serialized_size(const BinaryArithmetic& value) noexcept;
+    [[nodiscard]] size_t serialized_size(const FactorialArithmetic& value) noexcept;
+
+    /**
+     * \~english
+     * @brief Writes `value` into `buffer` in the binary format, copying its words as they are stored.
+     * @return Bytes written (`serialized_size(value)`).
+     * @throws std::length_error if `size` is smaller than `serialized_size(value)`.
+     * \~russian
+     * @brief Записывает `value` в `buffer` в двоичном формате, копируя слова в том виде, в каком они хранятся.
+     * @return Число записанных байт (`serialized_size(value)`).
+     * @throws std::length_error Если `size` меньше `serialized_size(value)`.
+     */
+    size_t serialize_to(const BinaryArithmetic& value, std::byte* buffer, size_t size);
+    size_t serialize_to(const FactorialArithmetic& value, std::byte* buffer, size_t size);
+
+    /**
+     * \~english
+     * @brief Reads one value written by `serialize_to` from the start of `buffer`.
+     *
+     * The record is validated (magic, version, kind, length, normalized words, coefficient ranges),
+     * so untrusted input never produces a malformed number.
+     * @return Bytes consumed, i.e. the offset of the next record.
+     * @throws std::invalid_argument if the record is truncated or malformed.
+     * \~russian
+     * @brief Читает одно значение, записанное `serialize_to`, из начала `buffer`.
+     *
+     * Запись проверяется (метка, версия, вид, длина, нормализованность слов, диапазоны коэффициентов),
+     * поэтому непроверенные данные никогда не дают некорректное число.
+     * @return Число прочитанных байт, то есть смещение следующей записи.
+     * @throws std::invalid_argument Если запись обрезана или некорректна.
+     */
+    size_t deserialize(const std::byte* buffer, size_t size, BinaryArithmetic& value);
+    size_t deserialize(const std::byte* buffer, size_t size, FactorialArithmetic& value);
+
+    /**
+     * \~english
+     * @brief Non-owning read-only view of a binary number whose words live elsewhere:
+     * in a `BinaryArithmetic`, a serialized record or a memory-mapped file.
+     *
+     * Comparison, `to_string` and the arithmetic operators read the words in place; only the
+     * result (a new `BinaryArithmetic`) is allocated. A view never outlives the memory it points to.
+     * \~russian
+     * @brief Невладеющее представление двоичного числа только для чтения, слова которого лежат
+     * в другом месте: в `BinaryArithmetic`, сериализованной записи или отображённом в память файле.
+     *
+     * Сравнение, `to_string` и арифметические операторы читают слова на месте; память выделяется
+     * только под результат (новый `BinaryArithmetic`). Представление не должно переживать память, на которую указывает.
+     */
+    class BinaryArithmeticView : public BaseComparable<BinaryArithmeticView> {
+    public:
+        using limb_type = uint64_t;
+
+        /// \~english @brief View of zero.
+        /// \~russian @brief Представление нуля.
+        constexpr BinaryArithmeticView() noexcept = default;
+        /// \~english @brief View of the magnitude `limbs[0..size)` (least significant first) with the given sign.
+        /// \~russian @brief Представление модуля `limbs[0..size)` (младшее слово первым) с заданным знаком.
+        BinaryArithmeticView(const limb_type* limbs, size_t size, bool negative) noexcept;
+        /// \~english @brief View of the words of `value`; valid until `value` changes or is destroyed.
+        /// \~russian @brief Представление слов `value`; действительно, пока `value` не изменено и не уничтожено.
+        BinaryArithmeticView(const BinaryArithmetic& value) noexcept;
+
+        /**
+         * \~english
+         * @brief View of a record written by `serialize_to` for a `BinaryArithmetic`, without copying its words.
+         *
+         * The words are used in place, so on big-endian targets or when they are not 8-byte
+         * aligned the record cannot be viewed and `deserialize` has to be used instead.
+         * @param consumed If not null, receives the size of the record.
+         * @throws std::invalid_argument if the record is malformed, misaligned or the target is big-endian.
+         * \~russian
+         * @brief Представление записи, сделанной `serialize_to` для `BinaryArithmetic`, без копирования слов.
+         *
+         * Слова используются на месте, поэтому на big-endian платформах или без выравнивания слов на 8 байт
+         * запись нельзя просмотреть, и нужно использовать `deserialize`.
+         * @param consumed Если не null, получает размер записи.
+         * @throws std::invalid_argument Если запись некорректна, не выровнена или платформа big-endian.
+         */
+        static BinaryArithmeticView from_bytes(const std::byte* buffer, size_t size, size_t* consumed = nullptr);
+
+        /// \~english @brief The magnitude words, least significant first (no leading zero words).
+        /// \~russian @brief Слова модуля, младшее первым (без ведущих нулевых слов).
+        [[nodiscard]] const limb_type* data() const noexcept { return _limbs; }
+        /// \~english @brief Number of magnitude words (0 for zero).
+        /// \~russian @brief Число слов модуля (0 для нуля).
+        [[nodiscard]] size_t size() const noexcept { return _size; }
+        [[nodiscard]] bool sign() const noexcept { return _negative; }
+        // Число значащих бит модуля (0 для нуля)
+        [[nodiscard]] size_t bit_length() const noexcept;
+        [[nodiscard]] int compare(const BinaryArithmeticView& other) const noexcept;
+        // Модуль остатка |*this| % divisor
+        [[nodiscard]] uint64_t mod_small(uint64_t divisor) const;
+
+        /// \~english @brief Copies the viewed value into an owning number.
+        /// \~russian @brief Копирует значение в владеющее число.
+        [[nodiscard]] explicit operator BinaryArithmetic() const;
+
+        friend BinaryArithmetic operator+(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs);
+        friend BinaryArithmetic operator-(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs);
+        friend BinaryArithmetic operator*(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs);
+        // Деление с усечением к нулю, остаток со знаком делимого; @throws std::overflow_error при делении на ноль
+        friend BinaryArithmetic operator/(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs);
+        friend BinaryArithmetic operator%(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs);
+        friend std::pair<BinaryArithmetic, BinaryArithmetic> divmod(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs);
+
+        friend std::string to_string(const BinaryArithmeticView& value);
+    private:
+        const limb_type* _limbs = nullptr;
+        size_t _size = 0;
+        bool _negative = false;
+    };
+}
@@ -0,0 +1,146 @@
+#pragma once
+#include "BinaryArithmetic.h"
+#include "LimbOperations.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace numsystem {
+    namespace impl {
+        /**
+         * \~english
+         * @brief Process-wide table that only grows: lock-free reads, growth under a mutex.
+         *
+         * Entries live in segments of doubling size that are never moved or freed, so a reference
+         * stays valid for the lifetime of the process. The number of built entries is published with
+         * a release store after the entry is complete: a reader that sees `i < size()` (one acquire load)
+         * reads the immutable entry without taking the lock. A missing entry is built under the mutex
+         * together with all entries before it, each published as soon as it is ready.
+         * \~russian
+         * @brief Общая для процесса таблица, которая только растёт: чтение без блокировок, рост под мьютексом.
+         *
+         * Элементы лежат в сегментах удваивающегося размера, которые не перемещаются и не освобождаются,
+         * поэтому ссылка на элемент действительна до конца процесса. Число готовых элементов публикуется
+         * release-записью после построения элемента: читатель, увидевший `i < size()` (одна acquire-загрузка),
+         * читает неизменяемый элемент без блокировки. Недостающий элемент строится под мьютексом
+         * вместе со всеми предыдущими, и каждый публикуется сразу по готовности.
+         */
+        template<typename Entry>
+        class GrowOnlyTable {
+        public:
+            GrowOnlyTable() = default;
+            GrowOnlyTable(const GrowOnlyTable&) = delete;
+            GrowOnlyTable& operator=(const GrowOnlyTable&) = delete;
+
+            [[nodiscard]] size_t size() const noexcept { return _size.load(std::memory_order_acquire); }
+
+            // Только для уже опубликованных элементов: i < size()
+            [[nodiscard]] const Entry& operator[](size_t i) const noexcept {
+                const unsigned segment = segment_of(i);
+                return _segments[segment][i + 1 - (size_t(1) << segment)];
+            }
+
+            /**
+             * \~english
+             * @brief Entry `i`; missing entries `[size(), i]` are built in order by `make(index)`.
+             *
+             * `make` runs under the table's mutex and may read the already published entries through
+             * `operator[]` (every index below the one being built) or other tables, but must not grow this one.
+             * \~russian
+             * @brief Элемент `i`; недостающие элементы `[size(), i]` строятся по порядку вызовом `make(index)`.
+             *
+             * `make` выполняется под мьютексом таблицы и может читать уже опубликованные элементы через
+             * `operator[]` (все индексы меньше строящегося) или другие таблицы, но не должен растить эту.
+             */
+            template<typename Make>
+            const Entry& get(size_t i, Make&& make) {
+                if (i < size()) return (*this)[i];
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (size_t n = _size.load(std::memory_order_relaxed); n <= i; ++n) {
+                    const unsigned segment = segment_of(n);
+                    if (!_segments[segment]) _segments[segment] = std::make_unique<Entry[]>(size_t(1) << segment);
+                    _segments[segment][n + 1 - (size_t(1) << segment)] = make(n);
+                    _size.store(n + 1, std::memory_order_release);
+                }
+                return (*this)[i];
+            }
+
+        private:
+            // Сегмент s хранит элементы [2^s - 1, 2^(s+1) - 1)
+            static unsigned segment_of(size_t i) noexcept {
+                return LimbOperations::bit_width(static_cast<uint64_t>(i) + 1) - 1;
+            }
+
+            std::array<std::unique_ptr<Entry[]>, std::numeric_limits<size_t>::digits> _segments;
+            std::atomic<size_t> _size{ 0 };
+            std::mutex _mutex;
+        };
+
+        /// \~english @brief Number of factorial indices in a level-0 block of the radix product cache.
+        /// \~russian @brief Число факториальных индексов в блоке нулевого уровня кэша произведений оснований.
+        inline constexpr uint64_t RADIX_BLOCK = 64;
+        /// \~english @brief Number of block levels: a level-`L` block spans `RADIX_BLOCK << L` indices.
+        /// \~russian @brief Число уровней блоков: блок уровня `L` охватывает `RADIX_BLOCK << L` индексов.
+        inline constexpr unsigned RADIX_BLOCK_LEVELS = 58;
+
+        /**
+         * \~english
+         * @brief Cached product `(s + 1)(s + 2)...(s + W) = (s + W)! / s!` for `W = RADIX_BLOCK << level`, `s = index * W`.
+         *
+         * These are the nodes of the dyadic product tree over the factorial indices: a block is the product
+         * of its two children one level below, so divide-and-conquer conversion that splits ranges at
+         * block boundaries finds every radix product it needs here. Normalized 64-bit limbs, at least one limb.
+         * \~russian
+         * @brief Кэшированное произведение `(s + 1)(s + 2)...(s + W) = (s + W)! / s!` для `W = RADIX_BLOCK << level`, `s = index * W`.
+         *
+         * Это узлы двоичного дерева произведений над факториальными индексами: блок — произведение двух
+         * своих потомков уровнем ниже, поэтому перевод «разделяй и властвуй», делящий диапазоны по границам
+         * блоков, находит здесь все нужные произведения оснований. Нормализованные 64-битные слова, не меньше одного.
+         */
+        [[nodiscard]] const std::vector<uint64_t>& radix_block(unsigned level, uint64_t index);
+    }
+
+    /**
+     * \~english
+     * @brief `n!` as a binary number, assembled from the cached radix product blocks.
+     *
+     * The blocks are shared with factorial <-> binary conversion, so computing a factorial warms the
+     * conversion of numbers of the same size and vice versa. Only the indices after the last whole block are multiplied anew.
+     * \~russian
+     * @brief `n!` в виде двоичного числа, собранный из кэшированных блоков произведений оснований.
+     *
+     * Блоки общие с переводом факториальных чисел в двоичные и обратно, поэтому вычисление факториала
+     * прогревает перевод чисел того же размера и наоборот. Заново перемножаются только индексы после последнего целого блока.
+     */
+    [[nodiscard]] BinaryArithmetic factorial(uint64_t n);
+
+    /**
+     * \~english
+     * @brief Builds the radix product blocks over the indices `[0, max_index)` ahead of time.
+     *
+     * After the call, conversion of factorial numbers with fewer than `max_index` coefficients reads
+     * the blocks without computing or locking. Meant for warming a service at startup; the tables are
+     * shared by all threads and kept until the process exits.
+     * \~russian
+     * @brief Заранее строит блоки произведений оснований над индексами `[0, max_index)`.
+     *
+     * После вызова перевод факториальных чисел с числом коэффициентов меньше `max_index` читает
+     * блоки без вычислений и блокировок. Рассчитано на прогрев сервиса при запуске; таблицы
+     * общие для всех потоков и хранятся до завершения процесса.
+     */
+    void preload_factorial_tables(uint64_t max_index);
+
+    /**
+     * \~english
+     * @brief Builds the cached powers `10^(chunk_digits * 2^k)` and their reciprocals used for numbers of up to `digits` decimal digits.
+     *
+     * Covers parsing and formatting of `BinaryArithmetic` (64-bit limbs); other limb widths keep
+     * their own tables, which grow on first use.
+     * \~russian
+     * @brief Строит кэшированные степени `10^(chunk_digits * 2^k)` и обратные к ним, нужные для чисел длиной до `digits` десятичных цифр.
+     *
+     * Покрывает разбор и вывод `BinaryArithmetic` (64-битные слова); таблицы других размеров слова
+     * свои и растут при первом использовании.
+     */
+    void preload_decimal_tables(size_t digits);
+}
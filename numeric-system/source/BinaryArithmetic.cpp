@@ -1,9 +1,11 @@
 ﻿#include "BinaryArithmetic.h"
+#include "LimbOperations.h"
 
 namespace numsystem {
     namespace {
         using BNO = impl::BigNumberOperations;
-        using OverflowOps = impl::OverflowAwareOps;   
+        using OverflowOps = impl::OverflowAwareOps;
+        using LO = impl::LimbOperations;
         struct BinaryAccess {
             template<typename Container>
             static std::optional<typename Container::value_type> extract(const Container& data, size_t index) {
@@ -18,42 +20,63 @@ namespace numsystem {
                 }
                 data[index] = value;
             }
-        };   
-
-        template<typename value_type>
-        impl::Storage<value_type> shift_left(const impl::Storage<value_type>& input, uint64_t shift) {
-            if (input.empty() || shift == 0)
-                return input;
-
-            uint64_t word_shift = shift / input.VALUE_COUNT_BIT;
-            uint64_t bit_shift = shift % input.VALUE_COUNT_BIT;
-
-            impl::Storage<value_type> result{};
-            result.resize(input.size() + word_shift, 0);
-
-            // Сдвиг по словам
-            for (size_t i = 0; i < input.size(); ++i) {
-                result[i + word_shift] = input[i];
+        };
+
+        // Пословные операции и правило знака результата в дополнительном коде
+        struct BitAnd {
+            template<typename _Ty> static void apply(_Ty* r, const _Ty* a, const _Ty* b, size_t n) noexcept { LO::and_n(r, a, b, n); }
+            static constexpr bool sign(bool a, bool b) noexcept { return a && b; }
+        };
+        struct BitOr {
+            template<typename _Ty> static void apply(_Ty* r, const _Ty* a, const _Ty* b, size_t n) noexcept { LO::ior_n(r, a, b, n); }
+            static constexpr bool sign(bool a, bool b) noexcept { return a || b; }
+        };
+        struct BitXor {
+            template<typename _Ty> static void apply(_Ty* r, const _Ty* a, const _Ty* b, size_t n) noexcept { LO::xor_n(r, a, b, n); }
+            static constexpr bool sign(bool a, bool b) noexcept { return a != b; }
+        };
+
+        // Скаляр из 64 бит в словах хранилища (младшими вперёд) и обратно
+        template<typename _Ty>
+        constexpr size_t SCALAR_LIMBS_OF = 64 / std::numeric_limits<_Ty>::digits;
+
+        template<typename _Ty>
+        size_t split_scalar(uint64_t value, _Ty* limbs) noexcept {
+            if constexpr (std::numeric_limits<_Ty>::digits == 64) {
+                limbs[0] = value;
+                return value != 0 ? 1 : 0;
             }
-
-            // Побитовый сдвиг с переносом
-            if (bit_shift != 0) {
-                value_type carry = 0;
-                for (size_t i = word_shift; i < result.size(); ++i) {
-                    value_type current = result[i];
-                    result[i] = (current << bit_shift) | carry;
-                    carry = current >> (input.VALUE_COUNT_BIT - bit_shift);
-                }
-                if (carry != 0) {
-                    result.push_back(carry);
+            else {
+                size_t count = 0;
+                for (; value != 0; ++count, value >>= std::numeric_limits<_Ty>::digits) {
+                    limbs[count] = static_cast<_Ty>(value);
                 }
+                return count;
+            }
+        }
+        template<typename _Ty>
+        uint64_t join_scalar(const _Ty* limbs, size_t count) noexcept {
+            if constexpr (std::numeric_limits<_Ty>::digits == 64) {
+                return count != 0 ? limbs[0] : 0;
+            }
+            else {
+                uint64_t value = 0;
+                for (size_t i = count; i-- > 0;) value = (value << std::numeric_limits<_Ty>::digits) | limbs[i];
+                return value;
             }
+        }
 
-            return result;
+        // |x| -> дополнительный код -x по модулю B^n: ~(|x| - 1)
+        template<typename _Ty>
+        void negate_twos(_Ty* a, size_t n) noexcept {
+            LO::sub_1(a, a, n, _Ty(1));
+            LO::com_n(a, a, n);
         }
     }
 
-    BinaryArithmetic::BinaryArithmetic(std::string_view value) {
+    template<typename Limb>
+    BasicBinaryArithmetic<Limb>::BasicBinaryArithmetic(std::string_view value) {
+        NUMSYS_TRACE_OPERATION(Parse, value.size());
         if (!BNO::is_integral_valid_string(value)) {
             throw std::invalid_argument("Invalid input string for integral string disability error. Value: " + std::string(value));
         }
@@ -68,39 +91,14 @@ namespace numsystem {
             return;
         }
 
-        // Копируем value в std::string для безопасной модификации
-        std::string _value(value);
-        std::vector<value_type> storage{};
-        value_type word = 0;
-        int bit_index = 0;
-
-        // Процесс преобразования числа в бинарную форму
-        while (_value != "0") {
-            // Остаток от деления на 2 — это младший бит
-            auto [quotient, remainder] = BNO::divide_string_by_integral(_value, 2);
-            std::swap(_value, quotient);
-            
-            word |= static_cast<value_type>(remainder) << (bit_index);
-            bit_index++;
-
-            // Как только слово заполнилось (битов >= VALUE_COUNT_BIT), добавляем его в вектор
-            if (bit_index == _storage.VALUE_COUNT_BIT) {
-                storage.push_back(word); // Добавляем слово в вектор
-                word = 0;                // Очищаем для следующего слова
-                bit_index = 0;           // Сбрасываем индекс
-            }
-        }
-
-        // Если остались незаписанные биты, добавляем их в вектор
-        if (bit_index != 0) {
-            storage.push_back(word);
-        }
-
-        BNO::remove_zeros(_storage.data(), BNO::TrimMode::Leading);
-        std::swap(_storage.data(), storage);
+        // Кусками по chunk_digits цифр, для длинных строк — делением пополам по степеням 10
+        const std::vector<value_type> limbs = LO::set_str<value_type>(value);
+        _storage.data().assign(limbs.begin(), limbs.end());
+        if (_storage.empty()) _storage.push_back(0);    // строка из одних нулей
+        trim_leading_zeros();
     }    
-    int BinaryArithmetic::compare(const BinaryArithmetic& other) const noexcept {
-        using value_type = BinaryArithmetic::value_type;
+    template<typename Limb>
+    int BasicBinaryArithmetic<Limb>::compare(const BasicBinaryArithmetic& other) const noexcept {
 
         // 1. Сравнение знаков
         if (sign() != other.sign()) {
@@ -131,10 +129,12 @@ namespace numsystem {
         return 0;
     }
 
-    BinaryArithmetic BinaryArithmetic::add(const BinaryArithmetic& other) const {
-        BinaryArithmetic result{};
+    template<typename Limb>
+    BasicBinaryArithmetic<Limb> BasicBinaryArithmetic<Limb>::add(const BasicBinaryArithmetic& other) const {
+        BasicBinaryArithmetic result{};
         value_type carry = 0;
         size_t size = std::max(_storage.size(), other._storage.size());
+        NUMSYS_TRACE_OPERATION(Add, size);
         result._storage.reserve(size);
 
         for (size_t idx = 0; idx < size; ++idx) {
@@ -147,10 +147,12 @@ namespace numsystem {
         result.trim_leading_zeros();
         return result;
     }
-    BinaryArithmetic BinaryArithmetic::subtract(const BinaryArithmetic& other) const {
-        BinaryArithmetic result{};
+    template<typename Limb>
+    BasicBinaryArithmetic<Limb> BasicBinaryArithmetic<Limb>::subtract(const BasicBinaryArithmetic& other) const {
+        BasicBinaryArithmetic result{};
         value_type borrow = 0;
         size_t size = std::max(_storage.size(), other._storage.size());
+        NUMSYS_TRACE_OPERATION(Subtract, size);
         result._storage.reserve(size);
 
         for (size_t idx = 0; idx < size; ++idx) {
@@ -163,171 +165,451 @@ namespace numsystem {
         result.trim_leading_zeros();
         return result;
     }
-    BinaryArithmetic BinaryArithmetic::multiply(const BinaryArithmetic& other) const {
-        if (is_zero() || other.is_zero()) return BinaryArithmetic(0);
-
-        BinaryArithmetic result(0);
-        for (size_t elem_idx = 0; elem_idx < other._storage.size(); ++elem_idx) {
-            value_type word = other._storage[elem_idx];
-            for (size_t bit_idx = 0; bit_idx < _storage.VALUE_COUNT_BIT; ++bit_idx) {
-                if ((word >> bit_idx) & 1) {
-                    size_t bit_pos = elem_idx * _storage.VALUE_COUNT_BIT + bit_idx;
-                    BinaryArithmetic temp{};
-                    temp._storage = shift_left<value_type>(_storage, bit_pos);
-                    temp._storage.sign(false); // inline abs
-                    result += temp;
-                }
-            }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::add_signed(const BasicBinaryArithmetic& other, bool other_sign) {
+        // resize() ниже может переместить данные, поэтому x += x считаем через копию
+        if (&other == this) {
+            const BasicBinaryArithmetic copy(other);
+            add_signed(copy, other_sign);
+            return;
         }
 
-        // Установка знака
-        result.sign(this->sign() ^ other.sign());
-        result.trim_leading_zeros();
-        return result;
+        add_limbs(other._storage.data().data(), other._storage.size(), other_sign);
     }
-    BinaryArithmetic BinaryArithmetic::divide(const BinaryArithmetic& other) const {
-        if (other.is_zero()) throw std::overflow_error("Division by zero");
-        if (is_zero()) return BinaryArithmetic(0);
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::add_limbs(const value_type* rhs, size_t rhs_size, bool other_sign) {
+        auto& data = _storage.data();
+        const size_t lhs_size = LO::normalized_size(data.data(), data.size());
+        rhs_size = LO::normalized_size(rhs, rhs_size);
+        if (rhs_size == 0) {
+            if (data.empty()) data.push_back(0);
+            trim_leading_zeros();
+            return;
+        }
+        if (lhs_size == 0) sign(other_sign);
 
-        using value_type = BinaryArithmetic::value_type;
-        constexpr size_t BITS = impl::Storage<value_type>::VALUE_COUNT_BIT;
+        if (sign() == other_sign) {
+            // Знаки совпадают: складываем модули, знак не меняется
+            const size_t size = std::max(lhs_size, rhs_size);
+            data.resize(size + 1, 0);
+            data[size] = LO::add(data.data(), data.data(), size, rhs, rhs_size);
+        }
+        else {
+            // Знаки разные: из большего модуля вычитаем меньший, знак — у большего
+            const int cmp = (lhs_size != rhs_size) ? (lhs_size < rhs_size ? -1 : 1) : LO::cmp_n(data.data(), rhs, lhs_size);
+            if (cmp >= 0) {
+                LO::sub(data.data(), data.data(), lhs_size, rhs, rhs_size);
+            }
+            else {
+                data.resize(rhs_size, 0);
+                LO::sub(data.data(), rhs, rhs_size, data.data(), lhs_size);
+                sign(other_sign);
+            }
+        }
+        trim_leading_zeros();
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::add_small(uint64_t value, bool negative) {
+        value_type limbs[SCALAR_LIMBS_OF<value_type>];
+        add_limbs(limbs, split_scalar(value, limbs), negative);
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::mul_small(uint64_t value, bool negative) {
+        const size_t size = LO::normalized_size(_storage.data().data(), _storage.size());
+        if (size == 0 || value == 0) {
+            _storage.data().assign(1, 0);
+            sign(false);
+            return;
+        }
+        _storage.resize(size);
+        if (value <= _storage.MAX_VALUE) {
+            // Множитель в одно слово: один проход mul_1 на месте
+            const value_type carry = LO::mul_1(_storage.data().data(), _storage.data().data(), size, static_cast<value_type>(value));
+            if (carry != 0) _storage.push_back(carry);
+        }
+        else {
+            value_type limbs[SCALAR_LIMBS_OF<value_type>];
+            const size_t count = split_scalar(value, limbs);
+            std::pmr::vector<value_type> product(size + count, impl::current_resource());
+            if (size >= count) LO::mul(product.data(), _storage.data().data(), size, limbs, count);
+            else               LO::mul(product.data(), limbs, count, _storage.data().data(), size);
+            _storage.data().assign(product.begin(), product.end());
+        }
+        sign(sign() != negative);
+        trim_leading_zeros();
+    }
+    template<typename Limb>
+    uint64_t BasicBinaryArithmetic<Limb>::divmod_small(uint64_t divisor, bool negative) {
+        if (divisor == 0) throw std::overflow_error("Division by zero");
+        const size_t size = LO::normalized_size(_storage.data().data(), _storage.size());
+        if (size == 0) return 0;
+
+        uint64_t remainder = 0;
+        if (divisor <= _storage.MAX_VALUE) {
+            remainder = LO::divrem_1(_storage.data().data(), _storage.data().data(), size, static_cast<value_type>(divisor));
+        }
+        else {
+            // Делитель шире слова (узкие слова): то же деление Кнута, что и для длинного делителя
+            value_type limbs[SCALAR_LIMBS_OF<value_type>];
+            const size_t count = split_scalar(divisor, limbs);
+            const value_type* data = _storage.data().data();
+            if (size < count || (size == count && LO::cmp_n(data, limbs, size) < 0)) {
+                remainder = join_scalar(data, size);
+                _storage.data().assign(1, 0);
+            }
+            else {
+                std::pmr::vector<value_type> quotient(size - count + 1, impl::current_resource());
+                value_type rest[SCALAR_LIMBS_OF<value_type>];
+                LO::divrem(quotient.data(), rest, data, size, limbs, count);
+                remainder = join_scalar(rest, count);
+                _storage.data().assign(quotient.begin(), quotient.end());
+            }
+        }
+        sign(sign() != negative);
+        trim_leading_zeros();
+        return remainder;
+    }
+    template<typename Limb>
+    uint64_t BasicBinaryArithmetic<Limb>::mod_small(uint64_t divisor) const {
+        if (divisor == 0) throw std::overflow_error("Division by zero");
+        if (divisor <= _storage.MAX_VALUE) {
+            return LO::mod_1(_storage.data().data(), _storage.size(), static_cast<value_type>(divisor));
+        }
+        BasicBinaryArithmetic copy(*this);
+        return copy.divmod_small(divisor);
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::add_assign(const BasicBinaryArithmetic& other) {
+        NUMSYS_TRACE_OPERATION(Add, std::max(_storage.size(), other._storage.size()));
+        add_signed(other, other.sign());
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::subtract_assign(const BasicBinaryArithmetic& other) {
+        NUMSYS_TRACE_OPERATION(Subtract, std::max(_storage.size(), other._storage.size()));
+        add_signed(other, !other.sign());
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::multiply_assign(const BasicBinaryArithmetic& other) {
+        NUMSYS_TRACE_OPERATION(Multiply, std::max(_storage.size(), other._storage.size()));
+        const value_type* lhs = _storage.data().data();
+        const value_type* rhs = other._storage.data().data();
+        const size_t lhs_size = LO::normalized_size(lhs, _storage.size());
+        const size_t rhs_size = LO::normalized_size(rhs, other._storage.size());
+        if (lhs_size == 0 || rhs_size == 0) {
+            _storage.data().assign(1, 0);
+            sign(false);
+            return;
+        }
 
-        BinaryArithmetic lhs_abs = abs(*this);
-        BinaryArithmetic rhs_abs = abs(other);
+        // Произведение не может писаться поверх множителя, поэтому считаем его в буфер потока
+        // и меняем буферы местами: старое хранилище становится буфером для следующего умножения.
+        // Буфер потока живёт дольше любой арены, поэтому он всегда из ресурса по умолчанию,
+        // а хранилище из другого ресурса получает копию произведения
+        static thread_local typename impl::Storage<value_type>::buffer_type scratch(std::pmr::get_default_resource());
+        scratch.resize(lhs_size + rhs_size);
+        if (lhs_size >= rhs_size) LO::mul(scratch.data(), lhs, lhs_size, rhs, rhs_size);
+        else                      LO::mul(scratch.data(), rhs, rhs_size, lhs, lhs_size);
+        if (_storage.data().get_resource() == scratch.get_resource()) {
+            using std::swap;
+            swap(_storage.data(), scratch);
+        }
+        else {
+            _storage.data().assign(scratch.begin(), scratch.end());
+        }
 
-        BinaryArithmetic quotient(0);
-        BinaryArithmetic remainder(0);
+        sign(sign() != other.sign());
+        trim_leading_zeros();
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::multiply_into(const BasicBinaryArithmetic& lhs, const BasicBinaryArithmetic& rhs) {
+        // Совпадение с операндом — обычное умножение на месте через буфер потока
+        if (this == &lhs) { multiply_assign(rhs); return; }
+        if (this == &rhs) { multiply_assign(lhs); return; }
+
+        NUMSYS_TRACE_OPERATION(Multiply, std::max(lhs._storage.size(), rhs._storage.size()));
+        const value_type* a = lhs._storage.data().data();
+        const value_type* b = rhs._storage.data().data();
+        const size_t a_size = LO::normalized_size(a, lhs._storage.size());
+        const size_t b_size = LO::normalized_size(b, rhs._storage.size());
+        if (a_size == 0 || b_size == 0) {
+            _storage.data().assign(1, 0);
+            sign(false);
+            return;
+        }
 
-        quotient.sign(sign() != other.sign());
+        // Буфер результата не пересекается с множителями, поэтому пишем в него напрямую
+        _storage.resize(a_size + b_size);
+        if (a_size >= b_size) LO::mul(_storage.data().data(), a, a_size, b, b_size);
+        else                  LO::mul(_storage.data().data(), b, b_size, a, a_size);
+        sign(lhs.sign() != rhs.sign());
+        trim_leading_zeros();
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::shift_left_assign(size_t bits) {
+        const size_t size = LO::normalized_size(_storage.data().data(), _storage.size());
+        if (size == 0 || bits == 0) return;
+        _storage.resize(size + bits / _storage.VALUE_COUNT_BIT + 1);
+        LO::lshift_inplace(_storage.data().data(), size, bits);
+        trim_leading_zeros();
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::shift_right_assign(size_t bits) {
+        const size_t size = LO::normalized_size(_storage.data().data(), _storage.size());
+        if (size == 0 || bits == 0) return;
+        auto [new_size, inexact] = LO::rshift_inplace(_storage.data().data(), size, bits);
+        _storage.resize(new_size);
+        // Округление вниз: у отрицательного числа с потерянными битами модуль растёт на 1
+        if (sign() && inexact) {
+            if (_storage.empty()) _storage.push_back(0);
+            const value_type carry = LO::add_1(_storage.data().data(), _storage.data().data(), _storage.size(), value_type(1));
+            if (carry != 0) _storage.push_back(carry);
+        }
+        if (_storage.empty()) {
+            _storage.push_back(0);
+            sign(false);
+            return;
+        }
+        trim_leading_zeros();
+    }
+    template<typename Limb>
+    template<typename Op>
+    void BasicBinaryArithmetic<Limb>::bitwise_assign(const BasicBinaryArithmetic& other) {
+        const bool lhs_neg = sign();
+        const bool rhs_neg = other.sign();
+        const size_t lhs_size = LO::normalized_size(_storage.data().data(), _storage.size());
+        const size_t rhs_size = LO::normalized_size(other._storage.data().data(), other._storage.size());
+        const size_t n = std::max(lhs_size, rhs_size);
+        if (n == 0) return;
+
+        // Правый операнд копируется, только если его нужно дополнить, перевести в дополнительный код
+        // или он совпадает с *this
+        const value_type* rhs = other._storage.data().data();
+        std::pmr::vector<value_type> padded(impl::current_resource());
+        if (rhs_neg || rhs_size < n || &other == this) {
+            padded.assign(rhs, rhs + rhs_size);
+            padded.resize(n, 0);
+            if (rhs_neg) negate_twos(padded.data(), n);
+            rhs = padded.data();
+        }
 
-        const auto& data = lhs_abs._storage.data();
-
-        // Подсчёт старшего бита lhs_abs
-        int64_t total_bits = 0;
-        for (int64_t i = static_cast<int64_t>(data.size()) - 1; i >= 0; --i) {
-            if (data[i] != 0) {
-                for (int64_t bit = static_cast<int64_t>(BITS) - 1; bit >= 0; --bit) {
-                    if ((data[i] >> bit) & 1) {
-                        total_bits = i * static_cast<int64_t>(BITS) + bit + 1;
-                        break;
-                    }
-                }
-                if (total_bits > 0) break;
-            }
+        _storage.resize(n, 0);
+        value_type* lhs = _storage.data().data();
+        if (lhs_neg) negate_twos(lhs, n);
+        Op::apply(lhs, lhs, rhs, n);
+
+        // Биты за пределами n слов у обоих операндов — копии знака, поэтому знак результата
+        // определяется знаками операндов; отрицательный результат переводим обратно в модуль
+        const bool result_neg = Op::sign(lhs_neg, rhs_neg);
+        if (result_neg) {
+            LO::com_n(lhs, lhs, n);
+            const value_type carry = LO::add_1(lhs, lhs, n, value_type(1));
+            if (carry != 0) _storage.push_back(carry);
         }
+        sign(result_neg);
+        trim_leading_zeros();
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::bit_and_assign(const BasicBinaryArithmetic& other) {
+        bitwise_assign<BitAnd>(other);
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::bit_or_assign(const BasicBinaryArithmetic& other) {
+        bitwise_assign<BitOr>(other);
+    }
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::bit_xor_assign(const BasicBinaryArithmetic& other) {
+        bitwise_assign<BitXor>(other);
+    }
+    template<typename Limb>
+    size_t BasicBinaryArithmetic<Limb>::bit_length() const noexcept {
+        const size_t size = LO::normalized_size(_storage.data().data(), _storage.size());
+        if (size == 0) return 0;
+        return (size - 1) * _storage.VALUE_COUNT_BIT + LO::bit_width(_storage[size - 1]);
+    }
+    template<typename Limb>
+    size_t BasicBinaryArithmetic<Limb>::popcount() const noexcept {
+        return LO::popcount_n(_storage.data().data(), _storage.size());
+    }
+    template<typename Limb>
+    size_t BasicBinaryArithmetic<Limb>::countr_zero() const noexcept {
+        for (size_t i = 0; i < _storage.size(); ++i) {
+            if (_storage[i] != 0) return i * _storage.VALUE_COUNT_BIT + LO::count_trailing_zeros(_storage[i]);
+        }
+        return 0;
+    }
+    template<typename Limb>
+    bool BasicBinaryArithmetic<Limb>::test_bit(size_t index) const noexcept {
+        const size_t word = index / _storage.VALUE_COUNT_BIT;
+        const bool bit = word < _storage.size() && ((_storage[word] >> (index % _storage.VALUE_COUNT_BIT)) & 1) != 0;
+        if (!sign()) return bit;
+        // -x = ~(x - 1): ниже младшей единицы x нули, на её месте единица, выше — инверсия x
+        const size_t lowest = countr_zero();
+        return index < lowest ? false : (index == lowest ? true : !bit);
+    }
+    template<typename Limb>
+    BasicBinaryArithmetic<Limb> BasicBinaryArithmetic<Limb>::multiply(const BasicBinaryArithmetic& other) const {
+        NUMSYS_TRACE_OPERATION(Multiply, std::max(_storage.size(), other._storage.size()));
+        if (is_zero() || other.is_zero()) return BasicBinaryArithmetic(0);
 
-        for (int64_t i = total_bits - 1; i >= 0; --i) {
-            remainder._storage = shift_left<value_type>(remainder._storage, 1);
+        // Больший операнд идёт первым: LO::mul сам выбирает «столбик», Карацубу или Тоома-3
+        const bool lhs_longer = _storage.size() >= other._storage.size();
+        const auto& longer = lhs_longer ? _storage : other._storage;
+        const auto& shorter = lhs_longer ? other._storage : _storage;
 
-            size_t elem_idx = i / BITS;
-            size_t bit_idx = i % BITS;
-            if (elem_idx < data.size() && ((data[elem_idx] >> bit_idx) & 1)) {
-                remainder += 1;
-            }
+        BasicBinaryArithmetic result{};
+        result._storage.resize(longer.size() + shorter.size(), 0);
+        LO::mul(result._storage.data().data(), longer.data().data(), longer.size(), shorter.data().data(), shorter.size());
+
+        // Установка знака
+        result.sign(this->sign() ^ other.sign());
+        result.trim_leading_zeros();
+        return result;
+    }
+    template<typename Limb>
+    std::pair<BasicBinaryArithmetic<Limb>, BasicBinaryArithmetic<Limb>> BasicBinaryArithmetic<Limb>::divmod(const BasicBinaryArithmetic& other) const {
+        NUMSYS_TRACE_OPERATION(Divide, _storage.size());
+        if (other.is_zero()) throw std::overflow_error("Division by zero");
+        if (is_zero()) return { BasicBinaryArithmetic(0), BasicBinaryArithmetic(0) };
 
-            if (remainder >= rhs_abs) {
-                remainder -= rhs_abs;
+        const value_type* lhs = _storage.data().data();
+        const value_type* rhs = other._storage.data().data();
+        const size_t lhs_size = LO::normalized_size(lhs, _storage.size());
+        const size_t rhs_size = LO::normalized_size(rhs, other._storage.size());
 
-                size_t q_elem = i / BITS;
-                size_t q_bit = i % BITS;
-                if (q_elem >= quotient._storage.size())
-                    quotient._storage.resize(q_elem + 1, 0);
-                quotient._storage[q_elem] |= (static_cast<value_type>(1) << q_bit);
-            }
+        // |lhs| < |rhs|: частное 0, остаток — само делимое
+        if (lhs_size < rhs_size || (lhs_size == rhs_size && LO::cmp_n(lhs, rhs, lhs_size) < 0)) {
+            return { BasicBinaryArithmetic(0), *this };
         }
 
-        quotient.trim_leading_zeros();
-        if (quotient.is_zero()) {
-            quotient._storage.push_back(0);
+        BasicBinaryArithmetic quotient{};
+        BasicBinaryArithmetic remainder{};
+        const value_type top = rhs[rhs_size - 1];
+        if ((top & (top - 1)) == 0 && LO::normalized_size(rhs, rhs_size - 1) == 0) {
+            // Делитель — степень двойки: частное — сдвиг модуля, остаток — его младшие биты
+            const size_t bits = (rhs_size - 1) * _storage.VALUE_COUNT_BIT + LO::count_trailing_zeros(top);
+            quotient._storage.data().assign(lhs, lhs + lhs_size);
+            quotient._storage.resize(LO::rshift_inplace(quotient._storage.data().data(), lhs_size, bits).first);
+            if (quotient._storage.empty()) quotient._storage.push_back(0);
+            remainder._storage.data().assign(lhs, lhs + rhs_size);
+            remainder._storage.back() &= static_cast<value_type>(top - 1);
+        }
+        else {
+            quotient._storage.resize(lhs_size - rhs_size + 1, 0);
+            remainder._storage.resize(rhs_size, 0);
+            LO::divrem(quotient._storage.data().data(), remainder._storage.data().data(), lhs, lhs_size, rhs, rhs_size);
         }
-        return quotient;
-    }
-    BinaryArithmetic BinaryArithmetic::modulo(const BinaryArithmetic& other) const {
-        if (other.is_zero()) throw std::overflow_error("Division by zero");
-        if (is_zero()) return BinaryArithmetic(0);
-
-        BinaryArithmetic quotient = divide(other);
-        BinaryArithmetic remainder = *this - (quotient * other);
 
-        // Остаток всегда имеет знак lhs
-        remainder.sign(this->sign());
+        // Деление с усечением к нулю: остаток всегда имеет знак lhs
+        quotient.sign(sign() != other.sign());
+        remainder.sign(sign());
+        quotient.trim_leading_zeros();
         remainder.trim_leading_zeros();
-        return remainder;
+        return { quotient, remainder };
+    }
+    template<typename Limb>
+    BasicBinaryArithmetic<Limb> BasicBinaryArithmetic<Limb>::divide(const BasicBinaryArithmetic& other) const {
+        return divmod(other).first;
+    }
+    template<typename Limb>
+    BasicBinaryArithmetic<Limb> BasicBinaryArithmetic<Limb>::modulo(const BasicBinaryArithmetic& other) const {
+        return divmod(other).second;
     }
 
-    [[nodiscard]] bool BinaryArithmetic::is_zero() const noexcept {
+    template<typename Limb>
+    BasicBinaryArithmetic<Limb> BasicBinaryArithmetic<Limb>::from_limbs(ConstSpan<limb_type> limbs, bool negative) {
+        BasicBinaryArithmetic result;
+        const size_t size = LO::normalized_size(limbs.data(), limbs.size());
+        if (size == 0) {
+            result._storage.data().assign(1, 0);
+            return result;
+        }
+        result._storage.data().assign(limbs.begin(), limbs.begin() + size);
+        result.sign(negative);
+        return result;
+    }
+    template<typename Limb>
+    bool BasicBinaryArithmetic<Limb>::is_zero() const noexcept {
         for (auto w : _storage) {
             if (w != 0) return false;
         }
         return true;
     }
-    void BinaryArithmetic::trim_leading_zeros() noexcept {
+    template<typename Limb>
+    void BasicBinaryArithmetic<Limb>::trim_leading_zeros() noexcept {
+        NUMSYS_COUNT_OPERATION(Trim, _storage.size());
         BNO::remove_zeros(_storage.data(), BNO::TrimMode::Trailing);
         if (_storage.back() == 0) { // меняем знак если только число стало 0
             _storage.sign(false);
         }
     }    
-    std::string to_string(const BinaryArithmetic& other) {
+    template<typename Limb>
+    std::string to_string(const BasicBinaryArithmetic<Limb>& other) {
         const auto& refdata = other._storage;
+        NUMSYS_TRACE_OPERATION(Format, refdata.size());
         if (refdata.empty()) return "0";
 
-        // данных меньше чем 2^64 используем стандартный std::to_string
-        // BITS_PER_ELEMENT<uint64_t> / BITS_PER_ELEMENT<value_type>
-        if (refdata.size() <= (std::numeric_limits<uint64_t>::digits / refdata.VALUE_COUNT_BIT)) {
+        // модуль меньше 2^64 — используем стандартный std::to_string
+        if (other.bit_length() <= static_cast<size_t>(std::numeric_limits<uint64_t>::digits)) {
             return (refdata.sign() ? "-" : "") + std::to_string(static_cast<uint64_t>(other));
         }
 
-        auto multiply_vector_by_2 = [](std::vector<uint32_t>& digits) {
-            uint64_t carry = 0;
-            constexpr uint64_t base = 1'000'000'000ULL;
-            for (auto& d : digits) {
-                uint64_t val = static_cast<uint64_t>(d) * 2 + carry;
-                d = static_cast<uint32_t>(val % base);
-                carry = val / base;
-            }
-            if (carry) digits.push_back(static_cast<uint32_t>(carry));
-            };
-        auto add_bit_to_vector = [](std::vector<uint32_t>& digits, int bit) {
-            if (bit != 1) return;
-
-            uint64_t carry = 1;
-            constexpr uint64_t base = 1'000'000'000ULL;
-            for (auto& d : digits) {
-                uint64_t val = static_cast<uint64_t>(d) + carry;
-                d = static_cast<uint32_t>(val % base);
-                carry = val / base;
-                if (carry == 0) break;
-            }
-            if (carry) digits.push_back(static_cast<uint32_t>(carry));
-            };
-        auto digits_to_string = [](const std::vector<uint32_t>& digits, bool sign) ->std::string {
-            if (digits.empty()) return "0";
-            std::string result = std::to_string(digits.back());  // старший элемент
-            for (int i = (int)digits.size() - 2; i >= 0; --i) {
-                std::string part = std::to_string(digits[i]);
-                // добавляем ведущие нули, чтобы каждый элемент был длиной 9 символов
-                result += std::string(9 - part.length(), '0') + part;
-            }
-
-            // Use is_negative instead of _storage.sign()
-            if (sign && result != "0") {
-                result.insert(result.begin(), '-');
-            }
+        std::string digits = LO::get_str(refdata.data().data(), refdata.size());
+        if (refdata.sign() && digits != "0") {
+            digits.insert(digits.begin(), '-');
+        }
+        return digits;
+    }
 
-            return result;
-            };
-
-        std::vector<uint32_t> digits = { 0 };
-        for (auto it = refdata.rbegin(); it != refdata.rend(); ++it) {
-            uint64_t current_word = *it;
-            for (int i = refdata.VALUE_COUNT_BIT - 1; i >= 0; --i) {
-                int bit = (current_word >> i) & 1;
-                // Using the refactored static methods
-                multiply_vector_by_2(digits);
-                add_bit_to_vector(digits, bit);
+    template<typename Limb>
+    BasicBinaryArithmetic<Limb> gcd(const BasicBinaryArithmetic<Limb>& a, const BasicBinaryArithmetic<Limb>& b) {
+        if (a.is_zero()) return abs(b);
+        if (b.is_zero()) return abs(a);
+
+        using Limbs = std::pmr::vector<Limb>;
+        constexpr size_t BITS = std::numeric_limits<Limb>::digits;
+        Limbs u(a._storage.begin(), a._storage.end(), impl::current_resource());
+        Limbs v(b._storage.begin(), b._storage.end(), impl::current_resource());
+        // Общая степень двойки выносится сразу, дальше u и v всегда нечётные
+        const size_t shift = std::min(a.countr_zero(), b.countr_zero());
+        size_t un = LO::rshift_inplace(u.data(), LO::normalized_size(u.data(), u.size()), a.countr_zero()).first;
+        size_t vn = LO::rshift_inplace(v.data(), LO::normalized_size(v.data(), v.size()), b.countr_zero()).first;
+        un = LO::normalized_size(u.data(), un);
+        vn = LO::normalized_size(v.data(), vn);
+
+        for (;;) {
+            const int cmp = (un != vn) ? (un < vn ? -1 : 1) : LO::cmp_n(u.data(), v.data(), un);
+            if (cmp == 0) break;
+            if (cmp < 0) {
+                u.swap(v);
+                std::swap(un, vn);
             }
+            // Разность двух нечётных чётна: вычитаем и сразу убираем все младшие нули
+            LO::sub(u.data(), u.data(), un, v.data(), vn);
+            un = LO::normalized_size(u.data(), un);
+            size_t zeros = 0;
+            while (u[zeros / BITS] == 0) zeros += BITS;
+            zeros += LO::count_trailing_zeros(u[zeros / BITS]);
+            un = LO::normalized_size(u.data(), LO::rshift_inplace(u.data(), un, zeros).first);
         }
 
-        return digits_to_string(digits, refdata.sign());
+        BasicBinaryArithmetic<Limb> result;
+        result._storage.data().assign(u.begin(), u.begin() + un);
+        result.shift_left_assign(shift);
+        return result;
     }
-}
\ No newline at end of file
+
+    template class BasicBinaryArithmetic<uint8_t>;
+    template class BasicBinaryArithmetic<uint16_t>;
+    template class BasicBinaryArithmetic<uint32_t>;
+    template class BasicBinaryArithmetic<uint64_t>;
+
+    template std::string to_string(const BasicBinaryArithmetic<uint8_t>&);
+    template std::string to_string(const BasicBinaryArithmetic<uint16_t>&);
+    template std::string to_string(const BasicBinaryArithmetic<uint32_t>&);
+    template std::string to_string(const BasicBinaryArithmetic<uint64_t>&);
+
+    template BasicBinaryArithmetic<uint8_t> gcd(const BasicBinaryArithmetic<uint8_t>&, const BasicBinaryArithmetic<uint8_t>&);
+    template BasicBinaryArithmetic<uint16_t> gcd(const BasicBinaryArithmetic<uint16_t>&, const BasicBinaryArithmetic<uint16_t>&);
+    template BasicBinaryArithmetic<uint32_t> gcd(const BasicBinaryArithmetic<uint32_t>&, const BasicBinaryArithmetic<uint32_t>&);
+    template BasicBinaryArithmetic<uint64_t> gcd(const BasicBinaryArithmetic<uint64_t>&, const BasicBinaryArithmetic<uint64_t>&);
+}
@@ -0,0 +1,130 @@
+﻿#include "BinaryArithmeticBatch.h"
+#include "LimbOperations.h"
+
+namespace numsystem {
+    namespace {
+        using LO = impl::LimbOperations;
+        using OverflowOps = impl::OverflowAwareOps;
+        using Limb = BinaryArithmeticBatch::value_type;
+        constexpr size_t LIMB_BITS = std::numeric_limits<Limb>::digits;
+
+        // Элементы обрабатываются полосами по BLOCK штук: переносы полосы живут на стеке,
+        // а внутренний цикл по элементам без ветвлений векторизуется компилятором
+        constexpr size_t BLOCK = 64;
+
+        // a[i] = a[i] ± b[i] по всем словам; subtract выбирает вычитание
+        template<bool subtract>
+        void lanes_add(Limb* a, const Limb* b, size_t count, size_t limbs) noexcept {
+            for (size_t first = 0; first < count; first += BLOCK) {
+                const size_t width = std::min(BLOCK, count - first);
+                Limb carry[BLOCK] = {};
+                for (size_t j = 0; j < limbs; ++j) {
+                    Limb* x = a + j * count + first;
+                    const Limb* y = b + j * count + first;
+                    for (size_t i = 0; i < width; ++i) {
+                        if constexpr (subtract) {
+                            const Limb d = x[i] - y[i];
+                            const Limb borrow = (x[i] < y[i]) | (d < carry[i]);
+                            x[i] = d - carry[i];
+                            carry[i] = borrow;
+                        }
+                        else {
+                            const Limb s = x[i] + y[i];
+                            const Limb c = s < x[i];
+                            x[i] = s + carry[i];
+                            carry[i] = c | (x[i] < s);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    BinaryArithmeticBatch::BinaryArithmeticBatch(size_t count, size_t bits)
+        : _count(count), _limbs(std::max<size_t>((bits + LIMB_BITS - 1) / LIMB_BITS, 1)), _data(_count * _limbs, 0) {}
+
+    void BinaryArithmeticBatch::check_shape(const BinaryArithmeticBatch& other) const {
+        if (_count != other._count || _limbs != other._limbs) {
+            throw std::invalid_argument("Batches must have the same size and width");
+        }
+    }
+
+    void BinaryArithmeticBatch::set(size_t index, const BinaryArithmetic& value) {
+        if (index >= _count) throw std::out_of_range("Batch index is out of range");
+
+        // Знаковый диапазон [-2^(bits-1), 2^(bits-1)): у отрицательных проверяем |v| - 1
+        const auto& data = value._storage.data();
+        const size_t n = LO::normalized_size(data.data(), data.size());
+        std::vector<Limb> word(_limbs, 0);
+        if (n > _limbs) throw std::overflow_error("Value exceeds the bit width of the batch");
+        std::copy(data.begin(), data.begin() + n, word.begin());
+        if (value.sign()) LO::sub_1(word.data(), word.data(), _limbs, Limb(1));
+        if (word[_limbs - 1] >> (LIMB_BITS - 1)) throw std::overflow_error("Value exceeds the bit width of the batch");
+        // -v в дополнительном коде: ~(|v| - 1)
+        if (value.sign()) LO::com_n(word.data(), word.data(), _limbs);
+
+        for (size_t j = 0; j < _limbs; ++j) _data[j * _count + index] = word[j];
+    }
+
+    BinaryArithmetic BinaryArithmeticBatch::get(size_t index) const {
+        if (index >= _count) throw std::out_of_range("Batch index is out of range");
+
+        BinaryArithmetic result;
+        auto& data = result._storage.data();
+        data.resize(_limbs);
+        for (size_t j = 0; j < _limbs; ++j) data[j] = _data[j * _count + index];
+        const bool negative = (data[_limbs - 1] >> (LIMB_BITS - 1)) != 0;
+        if (negative) {
+            // |v| = ~v + 1
+            LO::com_n(data.data(), data.data(), _limbs);
+            LO::add_1(data.data(), data.data(), _limbs, Limb(1));
+        }
+        result.sign(negative);
+        result.trim_leading_zeros();
+        return result;
+    }
+
+    void BinaryArithmeticBatch::add(const BinaryArithmeticBatch& other) {
+        check_shape(other);
+        lanes_add<false>(_data.data(), other._data.data(), _count, _limbs);
+    }
+    void BinaryArithmeticBatch::sub(const BinaryArithmeticBatch& other) {
+        check_shape(other);
+        lanes_add<true>(_data.data(), other._data.data(), _count, _limbs);
+    }
+
+    void BinaryArithmeticBatch::mul_small(uint64_t factor) noexcept {
+        for (size_t first = 0; first < _count; first += BLOCK) {
+            const size_t width = std::min(BLOCK, _count - first);
+            Limb carry[BLOCK] = {};
+            for (size_t j = 0; j < _limbs; ++j) {
+                Limb* x = _data.data() + j * _count + first;
+                for (size_t i = 0; i < width; ++i) {
+                    Limb high = 0;
+                    const Limb low = OverflowOps::multiply<Limb>(x[i], factor, high);
+                    x[i] = low + carry[i];
+                    carry[i] = high + (x[i] < low);
+                }
+            }
+        }
+    }
+
+    void BinaryArithmeticBatch::compare(const BinaryArithmeticBatch& other, int* result) const {
+        check_shape(other);
+        // Старшее слово сравнивается со знаком, остальные — без; первое различие сверху решает
+        const size_t top = _limbs - 1;
+        for (size_t i = 0; i < _count; ++i) {
+            const int64_t x = static_cast<int64_t>(_data[top * _count + i]);
+            const int64_t y = static_cast<int64_t>(other._data[top * _count + i]);
+            result[i] = (x > y) - (x < y);
+        }
+        for (size_t j = top; j-- > 0;) {
+            const Limb* x = _data.data() + j * _count;
+            const Limb* y = other._data.data() + j * _count;
+            for (size_t i = 0; i < _count; ++i) {
+                const int order = (x[i] > y[i]) - (x[i] < y[i]);
+                result[i] = result[i] != 0 ? result[i] : order;
+            }
+        }
+    }
+}
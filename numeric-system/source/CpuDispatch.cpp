@@ -0,0 +1,210 @@
+#include "CpuDispatch.h"
+#include "Internal.h"
+#include <initializer_list>
+
+#if NUMSYS_DISPATCH_ENABLED && defined(__SIZEOF_INT128__)
+#define NUMSYS_KERNELS_INT128 1
+#else
+#define NUMSYS_KERNELS_INT128 0
+#endif
+
+// Набору x86 нужны 128-битные произведения компилятора, поэтому он собирается только GCC и Clang
+#if NUMSYS_KERNELS_INT128 && defined(__x86_64__)
+#define NUMSYS_KERNELS_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#else
+#define NUMSYS_KERNELS_X86 0
+#endif
+
+namespace numsystem {
+    namespace {
+        using impl::KernelTable;
+
+        constexpr KernelTable PORTABLE{ KernelSet::Portable, nullptr, nullptr, nullptr, nullptr, nullptr };
+
+#if NUMSYS_KERNELS_INT128
+        // Переносы берутся из старшей половины 128-битной суммы: компилятор сводит их к adc/adcs.
+        // Циклы встраиваются и в ядра x86, где собираются уже с mulx
+        using u128 = impl::uint128_t;
+#define NUMSYS_KERNEL_LOOP inline __attribute__((always_inline))
+
+        NUMSYS_KERNEL_LOOP uint64_t add_n_loop(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept {
+            uint64_t carry = 0;
+#pragma GCC unroll 4
+            for (size_t i = 0; i < n; ++i) {
+                const u128 t = static_cast<u128>(a[i]) + b[i] + carry;
+                r[i] = static_cast<uint64_t>(t);
+                carry = static_cast<uint64_t>(t >> 64);
+            }
+            return carry;
+        }
+        NUMSYS_KERNEL_LOOP uint64_t sub_n_loop(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept {
+            uint64_t borrow = 0;
+#pragma GCC unroll 4
+            for (size_t i = 0; i < n; ++i) {
+                const u128 t = static_cast<u128>(a[i]) - b[i] - borrow;
+                r[i] = static_cast<uint64_t>(t);
+                borrow = static_cast<uint64_t>(t >> 64) & 1;
+            }
+            return borrow;
+        }
+        NUMSYS_KERNEL_LOOP uint64_t mul_1_loop(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept {
+            uint64_t carry = 0;
+#pragma GCC unroll 4
+            for (size_t i = 0; i < n; ++i) {
+                const u128 t = static_cast<u128>(a[i]) * b + carry;
+                r[i] = static_cast<uint64_t>(t);
+                carry = static_cast<uint64_t>(t >> 64);
+            }
+            return carry;
+        }
+        NUMSYS_KERNEL_LOOP uint64_t addmul_1_loop(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept {
+            uint64_t carry = 0;
+#pragma GCC unroll 4
+            for (size_t i = 0; i < n; ++i) {
+                // (2^64 - 1)^2 + 2 (2^64 - 1) = 2^128 - 1: сумма помещается без переполнения
+                const u128 t = static_cast<u128>(a[i]) * b + r[i] + carry;
+                r[i] = static_cast<uint64_t>(t);
+                carry = static_cast<uint64_t>(t >> 64);
+            }
+            return carry;
+        }
+        NUMSYS_KERNEL_LOOP uint64_t submul_1_loop(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept {
+            uint64_t carry = 0;
+#pragma GCC unroll 4
+            for (size_t i = 0; i < n; ++i) {
+                const u128 t = static_cast<u128>(a[i]) * b + carry;
+                const uint64_t low = static_cast<uint64_t>(t);
+                const uint64_t ri = r[i];
+                r[i] = ri - low;
+                carry = static_cast<uint64_t>(t >> 64) + (ri < low ? 1 : 0);
+            }
+            return carry;
+        }
+
+        uint64_t add_n_int128(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept { return add_n_loop(r, a, b, n); }
+        uint64_t sub_n_int128(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept { return sub_n_loop(r, a, b, n); }
+        uint64_t mul_1_int128(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept { return mul_1_loop(r, a, n, b); }
+        uint64_t addmul_1_int128(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept { return addmul_1_loop(r, a, n, b); }
+        uint64_t submul_1_int128(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept { return submul_1_loop(r, a, n, b); }
+
+        constexpr KernelTable INT128{ KernelSet::Int128, add_n_int128, sub_n_int128, mul_1_int128, addmul_1_int128, submul_1_int128 };
+#endif
+
+#if NUMSYS_KERNELS_X86
+#define NUMSYS_TARGET_BMI2 __attribute__((target("bmi2")))
+        // Интринсики принимают unsigned long long, а uint64_t — unsigned long: значения идут через локальные переменные
+        using ull = unsigned long long;
+
+        // Цепочки adc развёрнуты вручную по четыре слова: иначе флаг переноса сохраняется через setc на каждой итерации
+        NUMSYS_TARGET_BMI2 uint64_t add_n_bmi2(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept {
+            unsigned char carry = 0;
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                ull s0, s1, s2, s3;
+                carry = _addcarry_u64(carry, a[i], b[i], &s0);
+                carry = _addcarry_u64(carry, a[i + 1], b[i + 1], &s1);
+                carry = _addcarry_u64(carry, a[i + 2], b[i + 2], &s2);
+                carry = _addcarry_u64(carry, a[i + 3], b[i + 3], &s3);
+                r[i] = s0, r[i + 1] = s1, r[i + 2] = s2, r[i + 3] = s3;
+            }
+            for (; i < n; ++i) {
+                ull s;
+                carry = _addcarry_u64(carry, a[i], b[i], &s);
+                r[i] = s;
+            }
+            return carry;
+        }
+        NUMSYS_TARGET_BMI2 uint64_t sub_n_bmi2(uint64_t* r, const uint64_t* a, const uint64_t* b, size_t n) noexcept {
+            unsigned char borrow = 0;
+            size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                ull d0, d1, d2, d3;
+                borrow = _subborrow_u64(borrow, a[i], b[i], &d0);
+                borrow = _subborrow_u64(borrow, a[i + 1], b[i + 1], &d1);
+                borrow = _subborrow_u64(borrow, a[i + 2], b[i + 2], &d2);
+                borrow = _subborrow_u64(borrow, a[i + 3], b[i + 3], &d3);
+                r[i] = d0, r[i + 1] = d1, r[i + 2] = d2, r[i + 3] = d3;
+            }
+            for (; i < n; ++i) {
+                ull d;
+                borrow = _subborrow_u64(borrow, a[i], b[i], &d);
+                r[i] = d;
+            }
+            return borrow;
+        }
+        // mulx не трогает флаги, и сложения переносов не ждут умножения
+        NUMSYS_TARGET_BMI2 uint64_t mul_1_bmi2(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept { return mul_1_loop(r, a, n, b); }
+        NUMSYS_TARGET_BMI2 uint64_t addmul_1_bmi2(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept { return addmul_1_loop(r, a, n, b); }
+        NUMSYS_TARGET_BMI2 uint64_t submul_1_bmi2(uint64_t* r, const uint64_t* a, size_t n, uint64_t b) noexcept { return submul_1_loop(r, a, n, b); }
+
+        constexpr KernelTable X86_BMI2{ KernelSet::X86Bmi2, add_n_bmi2, sub_n_bmi2, mul_1_bmi2, addmul_1_bmi2, submul_1_bmi2 };
+
+        bool cpu_has_bmi2() noexcept {
+            // CPUID.(EAX=7, ECX=0): EBX бит 8 — BMI2
+            unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) return false;
+            return (ebx & (1u << 8)) != 0;
+        }
+#endif
+
+        const KernelTable* table_for(KernelSet set) noexcept {
+            switch (set) {
+            case KernelSet::Portable:
+                return &PORTABLE;
+#if NUMSYS_KERNELS_INT128
+            case KernelSet::Int128:
+                return &INT128;
+#endif
+#if NUMSYS_KERNELS_X86
+            case KernelSet::X86Bmi2: {
+                static const bool supported = cpu_has_bmi2();
+                return supported ? &X86_BMI2 : nullptr;
+            }
+#endif
+            default:
+                return nullptr;
+            }
+        }
+    }
+
+    namespace impl {
+        const KernelTable* select_default_kernels() noexcept {
+            // Наборы перечислены от лучшего к худшему; Portable поддерживается всегда
+            const KernelTable* best = nullptr;
+            for (KernelSet set : { KernelSet::X86Bmi2, KernelSet::Int128, KernelSet::Portable }) {
+                if ((best = table_for(set)) != nullptr) break;
+            }
+            // Выбор, сделанный раньше (в том числе select_kernel_set), не перезаписывается
+            const KernelTable* expected = nullptr;
+            if (!active_kernels_slot.compare_exchange_strong(expected, best, std::memory_order_acq_rel)) return expected;
+            return best;
+        }
+    }
+
+    KernelSet active_kernel_set() noexcept {
+        const KernelTable* table = impl::active_kernels_slot.load(std::memory_order_acquire);
+        return (table != nullptr ? table : impl::select_default_kernels())->set;
+    }
+
+    bool kernel_set_supported(KernelSet set) noexcept {
+        return table_for(set) != nullptr;
+    }
+
+    bool select_kernel_set(KernelSet set) noexcept {
+        const KernelTable* table = table_for(set);
+        if (table == nullptr) return false;
+        impl::active_kernels_slot.store(table, std::memory_order_release);
+        return true;
+    }
+
+    const char* kernel_set_name(KernelSet set) noexcept {
+        switch (set) {
+        case KernelSet::Portable: return "portable";
+        case KernelSet::Int128: return "int128";
+        case KernelSet::X86Bmi2: return "x86-bmi2";
+        default: return "unknown";
+        }
+    }
+}
@@ -0,0 +1,156 @@
+#include "DecimalStream.h"
+#include "LimbOperations.h"
+#include <istream>
+#include <ostream>
+
+namespace numsystem {
+    namespace {
+        using LO = impl::LimbOperations;
+
+        // Считает записанные символы и сообщает прогресс после каждого куска
+        struct CountingWriter {
+            DecimalSink& sink;
+            uint64_t written = 0;
+
+            void put(std::string_view digits) {
+                sink.write(digits);
+                written += digits.size();
+                sink.progress(written);
+            }
+            static void write(void* context, const char* digits, size_t count) {
+                static_cast<CountingWriter*>(context)->put(std::string_view(digits, count));
+            }
+        };
+
+        class StreamSink final : public DecimalSink {
+        public:
+            explicit StreamSink(std::ostream& out) : _out(out) {}
+            void write(std::string_view digits) override { _out.write(digits.data(), static_cast<std::streamsize>(digits.size())); }
+        private:
+            std::ostream& _out;
+        };
+    }
+
+    uint64_t write_decimal(const BinaryArithmetic& value, DecimalSink& sink) {
+        const ConstSpan<uint64_t> limbs = value.limbs();
+        CountingWriter writer{ sink };
+        NUMSYS_TRACE_OPERATION(Format, limbs.size());
+        if (limbs.empty()) {
+            writer.put("0");
+            return writer.written;
+        }
+        if (value.sign()) writer.put("-");
+        LO::get_str_to(limbs.data(), limbs.size(), &CountingWriter::write, &writer);
+        return writer.written;
+    }
+    uint64_t write_decimal(const BinaryArithmetic& value, std::ostream& out) {
+        StreamSink sink(out);
+        return write_decimal(value, sink);
+    }
+    uint64_t write_decimal(const FactorialArithmetic& value, DecimalSink& sink) {
+        return write_decimal(value.to_binary(), sink);
+    }
+    uint64_t write_decimal(const FactorialArithmetic& value, std::ostream& out) {
+        return write_decimal(value.to_binary(), out);
+    }
+
+    DecimalParser::DecimalParser() {
+        _block.reserve(BLOCK_DIGITS);
+    }
+
+    void DecimalParser::feed(std::string_view text) {
+        for (size_t i = 0; i < text.size();) {
+            if (!_started && text[i] == '-') {
+                _negative = true;
+                _started = true;
+                ++i;
+                continue;
+            }
+            // Цифры до конца куска или до заполнения блока
+            const size_t room = BLOCK_DIGITS - _block.size();
+            size_t count = 0;
+            while (count < room && i + count < text.size() && text[i + count] >= '0' && text[i + count] <= '9') ++count;
+            if (count == 0) {
+                throw std::invalid_argument("DecimalParser: unexpected character '" + std::string(1, text[i]) + "'");
+            }
+            if (_zero || (_digits == 0 && text[i] == '0' && count > 1)) {
+                throw std::invalid_argument("DecimalParser: leading zeros are not allowed");
+            }
+            _zero = _digits == 0 && text[i] == '0';
+            _started = true;
+            _block.append(text.data() + i, count);
+            _digits += count;
+            i += count;
+            if (_block.size() == BLOCK_DIGITS) flush_block();
+        }
+    }
+
+    void DecimalParser::flush_block() {
+        _pieces.push_back({ LO::set_str<uint64_t>(_block), _block.size() });
+        _block.clear();
+        // Двоичный счётчик: два соседних куска одной длины склеиваются в один вдвое длиннее
+        while (_pieces.size() >= 2 && _pieces[_pieces.size() - 2].digits == _pieces.back().digits) {
+            Piece low = std::move(_pieces.back());
+            _pieces.pop_back();
+            Piece& high = _pieces.back();
+            LO::mul_pow10_add(high.limbs, low.limbs, low.digits);
+            high.digits += low.digits;
+        }
+    }
+
+    BinaryArithmetic DecimalParser::finish() {
+        if (_digits == 0) throw std::invalid_argument("DecimalParser: no digits");
+        NUMSYS_COUNT_OPERATION(Parse, static_cast<size_t>(_digits));
+        if (!_block.empty()) {
+            _pieces.push_back({ LO::set_str<uint64_t>(_block), _block.size() });
+            _block.clear();
+        }
+        // Сборка от старших кусков к младшим; каждый кусок освобождается сразу после добавления
+        std::vector<uint64_t> acc = std::move(_pieces.front().limbs);
+        for (size_t i = 1; i < _pieces.size(); ++i) {
+            LO::mul_pow10_add(acc, _pieces[i].limbs, _pieces[i].digits);
+            std::vector<uint64_t>().swap(_pieces[i].limbs);
+        }
+        const bool negative = _negative;
+        _pieces.clear();
+        _digits = 0;
+        _negative = _started = _zero = false;
+        return BinaryArithmetic::from_limbs(acc, negative);
+    }
+
+    BinaryArithmetic read_decimal(std::istream& in) {
+        const std::istream::sentry sentry(in);
+        if (!sentry) throw std::invalid_argument("read_decimal: stream is not readable");
+
+        // Читаем посимвольно через буфер потока, чтобы не забрать символ после числа,
+        // и передаём разбору кусками
+        constexpr size_t PIECE = 1 << 16;
+        DecimalParser parser;
+        std::string piece;
+        piece.reserve(PIECE);
+        std::streambuf* buffer = in.rdbuf();
+        bool first = true;
+        try {
+            for (auto c = buffer->sgetc();; c = buffer->snextc()) {
+                if (std::istream::traits_type::eq_int_type(c, std::istream::traits_type::eof())) {
+                    in.setstate(std::ios_base::eofbit);
+                    break;
+                }
+                const char ch = std::istream::traits_type::to_char_type(c);
+                if (!((ch >= '0' && ch <= '9') || (first && ch == '-'))) break;
+                first = false;
+                piece.push_back(ch);
+                if (piece.size() == PIECE) {
+                    parser.feed(piece);
+                    piece.clear();
+                }
+            }
+            parser.feed(piece);
+            return parser.finish();
+        }
+        catch (const std::invalid_argument&) {
+            in.setstate(std::ios_base::failbit);
+            throw;
+        }
+    }
+}
@@ -1,13 +1,291 @@
 ﻿#include "FactorialArithmetic.h"
+#include "LimbOperations.h"
+#include "BinaryArithmetic.h"
+#include "Tables.h"
+#include <cmath>
 
 namespace numsystem {
 	namespace {
 		using FA = internal::FactorAccess;
 		using BNO = impl::BigNumberOperations;
 		using OverflowOps = impl::OverflowAwareOps;
+		using LO = impl::LimbOperations;
+		// Временные двоичные представления берут память из ресурса текущего потока
+		using Limbs = std::pmr::vector<uint64_t>;
+
+		// Размер двоичного числа, начиная с которого перевод между системами идёт «разделяй и властвуй»
+		constexpr size_t RADIX_DC = impl::ConversionThresholds::FACTORIAL_DC;
+		constexpr uint64_t WORD_MAX = std::numeric_limits<uint64_t>::max();
+
+		Limbs multiply_limbs(ConstSpan<uint64_t> a, ConstSpan<uint64_t> b) {
+			const size_t an = LO::normalized_size(a.data(), a.size());
+			const size_t bn = LO::normalized_size(b.data(), b.size());
+			if (an == 0 || bn == 0) return Limbs(impl::current_resource());
+			Limbs product(an + bn, 0, impl::current_resource());
+			if (an >= bn) LO::mul(product.data(), a.data(), an, b.data(), bn);
+			else          LO::mul(product.data(), b.data(), bn, a.data(), an);
+			product.resize(LO::normalized_size(product.data(), product.size()));
+			return product;
+		}
+
+		// Значение коэффициентов с индексами [s, e): sum(d_k * k! / s!) по схеме Горнера:
+		// (...(d_{e-1} * (e - 1) + d_{e-2}) * (e - 2) + ...) * (s + 1) + d_s.
+		// Соседние основания склеиваются в одно слово, чтобы на каждое слово
+		// приходился один проход mul_1/add_1, а не по проходу на коэффициент
+		Limbs horner_basecase(const impl::Storage<uint64_t>& data, uint64_t s, uint64_t e) {
+			Limbs acc(impl::current_resource());
+			internal::FactorCursor cursor(data, e - 1);
+			for (bool done = false; !done;) {
+				uint64_t radix = 1;
+				uint64_t chunk = 0;
+				// radix * (idx + 1) должно поместиться в слово, chunk < radix гарантировано
+				while (!done && radix <= WORD_MAX / (cursor.index() + 1)) {
+					radix *= cursor.index() + 1;
+					chunk = chunk * (cursor.index() + 1) + *cursor;
+					if (cursor.index() == s) done = true;
+					else --cursor;
+				}
+				uint64_t carry = LO::mul_1(acc.data(), acc.data(), acc.size(), radix);
+				carry += LO::add_1(acc.data(), acc.data(), acc.size(), chunk);
+				if (carry != 0) acc.push_back(carry);
+			}
+			return acc;
+		}
+
+		// Наименьший уровень блока, охватывающего индексы [0, e)
+		unsigned top_level(uint64_t e) {
+			unsigned level = 0;
+			while ((impl::RADIX_BLOCK << level) < e) ++level;
+			return level;
+		}
+
+		// То же для длинных диапазонов: блок [s, s + W) уровня level делится пополам,
+		// value(s, e) = value(s, m) + (m! / s!) * value(m, e), где m! / s! — готовый блок
+		// из общего кэша. Стоимость определяется умножением, а не квадратична.
+		// Коэффициенты с индексами от top — нули, такие половины не считаются
+		Limbs coefficients_to_limbs(const impl::Storage<uint64_t>& data, uint64_t s, unsigned level, uint64_t top) {
+			const uint64_t e = std::min(s + (impl::RADIX_BLOCK << level), top);
+			const uint64_t bits = internal::FactorAccess::total_bits_up_to(e) - internal::FactorAccess::total_bits_up_to(s);
+			if (level == 0 || bits / std::numeric_limits<uint64_t>::digits < RADIX_DC) return horner_basecase(data, s, e);
+
+			const uint64_t half = impl::RADIX_BLOCK << (level - 1);
+			const uint64_t m = s + half;
+			Limbs low = coefficients_to_limbs(data, s, level - 1, top);
+			if (m >= top) return low;
+			const Limbs high = coefficients_to_limbs(data, m, level - 1, top);
+			Limbs result = multiply_limbs(impl::radix_block(level - 1, s / half), high);
+			if (result.empty()) return low;
+			const size_t ln = LO::normalized_size(low.data(), low.size());
+			result.push_back(0);
+			LO::add(result.data(), result.data(), result.size(), low.data(), ln);
+			result.resize(LO::normalized_size(result.data(), result.size()));
+			return result;
+		}
+
+		// Модуль числа в двоичных 64-битных словах
+		Limbs factorial_to_limbs(const impl::Storage<uint64_t>& data) {
+			NUMSYS_TRACE_OPERATION(FactorialToBinary, data.size());
+			const uint64_t top = data.value() + 1;
+			Limbs acc = coefficients_to_limbs(data, 0, top_level(top), top);
+			if (acc.empty()) acc.push_back(0);
+			return acc;
+		}
+
+		// Обратное преобразование для [s, e): d_k = x mod (k + 1), x /= (k + 1).
+		// Делим сразу на произведение нескольких оснований, а коэффициенты
+		// достаём из остатка, который помещается в одно слово
+		void divide_basecase(Limbs& x, size_t size, uint64_t s, uint64_t e, uint64_t* digits) {
+			for (uint64_t idx = s; size != 0;) {
+				const uint64_t first = idx;
+				uint64_t radix = 1;
+				while (radix <= WORD_MAX / (idx + 1)) {
+					radix *= idx + 1;
+					++idx;
+				}
+				uint64_t remainder = LO::divrem_1(x.data(), x.data(), size, radix);
+				size = LO::normalized_size(x.data(), size);
+				// x < e! / s!, поэтому коэффициенты за e — нули последнего куска
+				for (uint64_t k = first; k < idx && k < e; ++k) {
+					digits[k] = remainder % (k + 1);
+					remainder /= k + 1;
+				}
+			}
+		}
+
+		// Для длинных x и блока [s, s + W): x = q * (m! / s!) + r, где r даёт коэффициенты
+		// [s, m), а q — [m, s + W); делитель берётся из общего кэша блоков. Коэффициенты пишутся до e
+		void limbs_to_coefficients(Limbs x, uint64_t s, unsigned level, uint64_t e, uint64_t* digits) {
+			const size_t size = LO::normalized_size(x.data(), x.size());
+			if (size == 0) return;
+			if (level == 0 || size < RADIX_DC) {
+				divide_basecase(x, size, s, std::min(s + (impl::RADIX_BLOCK << level), e), digits);
+				return;
+			}
+
+			const uint64_t half = impl::RADIX_BLOCK << (level - 1);
+			const uint64_t m = s + half;
+			if (m >= e) {
+				limbs_to_coefficients(std::move(x), s, level - 1, e, digits);
+				return;
+			}
+			const std::vector<uint64_t>& power = impl::radix_block(level - 1, s / half);
+			if (size < power.size()) {
+				limbs_to_coefficients(std::move(x), s, level - 1, e, digits);
+				return;
+			}
+			Limbs quotient(size - power.size() + 1, 0, impl::current_resource());
+			Limbs remainder(power.size(), 0, impl::current_resource());
+			LO::divrem(quotient.data(), remainder.data(), x.data(), size, power.data(), power.size());
+			limbs_to_coefficients(std::move(remainder), s, level - 1, e, digits);
+			limbs_to_coefficients(std::move(quotient), m, level - 1, e, digits);
+		}
+
+		// Пишет coefficients[0..count) в хранилище одним проходом через накопитель слова,
+		// а не записью каждого коэффициента по отдельности; знак хранилища не меняется
+		void pack_coefficients(const uint64_t* coefficients, size_t count, impl::Storage<uint64_t>& data) {
+			constexpr uint64_t WORD_BITS = impl::Storage<uint64_t>::VALUE_COUNT_BIT;
+			data.clear();
+			data.resize((internal::FactorAccess::total_bits_up_to(count) + WORD_BITS - 1) / WORD_BITS, 0);
+			uint64_t* out = data.data().data();
+			uint64_t word = 0;          // накапливаемое слово
+			uint64_t filled = 0;        // занятые биты в word
+			uint64_t width = 1;         // ширина коэффициента k: число бит в k
+			for (size_t k = 1; k < count; ++k) {
+				if ((k & (k - 1)) == 0 && k > 1) ++width;
+				const uint64_t digit = coefficients[k];
+				if (digit > k) throw std::invalid_argument("from_coefficients: coefficient exceeds its index");
+				word |= digit << filled;
+				filled += width;
+				if (filled >= WORD_BITS) {
+					*out++ = word;
+					filled -= WORD_BITS;
+					// Старшие биты коэффициента, не поместившиеся в записанное слово
+					word = (filled == 0) ? 0 : digit >> (width - filled);
+				}
+			}
+			if (filled != 0) *out = word;
+			data.value(count == 0 ? 0 : count - 1);
+			if (data.empty()) data.push_back(0);
+		}
+
+		template<typename Container>
+		void factorial_from_limbs(Container x, impl::Storage<uint64_t>& data) {
+			const size_t size = LO::normalized_size(x.data(), x.size());
+			NUMSYS_TRACE_OPERATION(BinaryToFactorial, size);
+			if (size == 0) {
+				data.clear();
+				data.push_back(0);
+				return;
+			}
+
+			// Число коэффициентов e с e! > x: суммируем log2(k!) с запасом на погрешность
+			const double bits = static_cast<double>(size * std::numeric_limits<uint64_t>::digits);
+			uint64_t e = 1;
+			for (double log_factorial = 0; log_factorial <= bits + 2; ++e) log_factorial += std::log2(static_cast<double>(e + 1));
+			++e;
+
+			std::vector<uint64_t> digits(e, 0);
+			limbs_to_coefficients(Limbs(x.data(), x.data() + size, impl::current_resource()), 0, top_level(e), e, digits.data());
+			pack_coefficients(digits.data(), digits.size(), data);
+		}
+
+		// Сравнение модулей от старших коэффициентов к младшим
+		template<typename _Ty>
+		int compare_coefficients(const impl::Storage<_Ty>& a, const impl::Storage<_Ty>& b) noexcept {
+			const uint64_t maxindex = std::max(a.value(), b.value());
+			internal::FactorCursor lhs(a, maxindex);
+			internal::FactorCursor rhs(b, maxindex);
+			for (; lhs.index() > 0; --lhs, --rhs) {
+				if (*lhs != *rhs) return *lhs < *rhs ? -1 : 1;
+			}
+			return 0;
+		}
+
+		// |acc| += |other| на месте. Коэффициент читается до записи по тому же индексу,
+		// поэтому acc и other могут совпадать
+		template<typename _Ty>
+		void add_coefficients(impl::Storage<_Ty>& acc, const impl::Storage<_Ty>& other) {
+			const uint64_t maxindex = std::max(acc.value(), other.value());
+			internal::FactorCursor lhs(acc);
+			internal::FactorCursor rhs(other);
+			internal::FactorWriter writer(acc);
+			uint64_t carry = 0;
+			for (; lhs.index() <= maxindex || carry != 0; ++lhs, ++rhs) {
+				uint64_t base = lhs.index() + 1;
+				uint64_t sum = *lhs + *rhs + carry;
+				carry = 0;
+
+				if (sum >= base) {
+					carry = 1;
+					sum -= base;
+				}
+				writer.push(sum);
+			}
+		}
+
+		// |acc| -= |other| на месте, требуется |acc| >= |other|
+		template<typename _Ty>
+		void subtract_coefficients(impl::Storage<_Ty>& acc, const impl::Storage<_Ty>& other) {
+			const uint64_t maxindex = std::max(acc.value(), other.value());
+			internal::FactorCursor lhs(acc);
+			internal::FactorCursor rhs(other);
+			internal::FactorWriter writer(acc);
+			int64_t borrow = 0;
+			for (; lhs.index() <= maxindex; ++lhs, ++rhs) {
+				uint64_t base = lhs.index() + 1;
+				int64_t diff = static_cast<int64_t>(*lhs) - static_cast<int64_t>(*rhs) - borrow;
+
+				if (diff < 0) {
+					diff += base;
+					borrow = 1;
+				}
+				else {
+					borrow = 0;
+				}
+				writer.push(static_cast<uint64_t>(diff));
+			}
+
+			// Диагностика: если остался долг, значит |acc| < |other|
+			if (borrow != 0) {
+				writer.push(static_cast<uint64_t>(-borrow));
+			}
+		}
+
+		// Коэффициенты 64-битного скаляра: digits[k] = d_k. 2^64 < 21!, поэтому индексы не больше 20
+		constexpr size_t SCALAR_DIGITS = 21;
+		uint64_t scalar_coefficients(uint64_t value, uint64_t (&digits)[SCALAR_DIGITS]) noexcept {
+			uint64_t top = 0;
+			for (uint64_t radix = 1; value > 0; ++radix) {
+				digits[radix] = value % (radix + 1);
+				value /= radix + 1;
+				top = radix;
+			}
+			return top;
+		}
+
+		// Деление модуля на скаляр от старших коэффициентов к младшим: t = r * (k + 1) + d_k, q_k = t / divisor.
+		// t < divisor * (k + 1), поэтому старшая половина t меньше делителя, а q_k <= k — снова коэффициент.
+		// Для неконстантного хранилища частное пишется на место делимого
+		template<typename StorageT>
+		uint64_t divrem_coefficients(StorageT& data, uint64_t divisor) noexcept {
+			uint64_t remainder = 0;
+			for (internal::FactorPosition pos(data.value()); pos.index > 0; pos.prev()) {
+				const uint64_t digit = FA::read_bits(data, pos.offset, pos.width);
+				uint64_t high = 0;
+				uint64_t low = OverflowOps::multiply<uint64_t>(remainder, pos.index + 1, high);
+				low += digit;
+				high += (low < digit) ? 1 : 0;
+				const uint64_t quotient = OverflowOps::divide<uint64_t>(high, low, divisor, remainder);
+				if constexpr (!std::is_const_v<StorageT>) {
+					FA::write_bits(data, pos.offset, pos.width, quotient);
+				}
+			}
+			return remainder;
+		}
 	}
 
 	FactorialArithmetic::FactorialArithmetic(std::string_view value) {
+		NUMSYS_TRACE_OPERATION(Parse, value.size());
 		if (!BNO::is_integral_valid_string(value)) {
 			throw std::invalid_argument("Invalid input string for integral string disability error. Value: " + std::string(value));
 		}
@@ -20,35 +298,11 @@ namespace numsystem {
 			return;
 		}
 
-		// Копируем value в std::string для безопасной модификации
-		std::string _value(value);
-		std::vector<uint64_t> storage{};
-
-		// Процесс преобразования числа в факториальное представление
-		// i - это индекс цифры в факториальном представлении (0 для d_0, 1 для d_1 и т.д.)
-		for (uint64_t digit_idx = 0; _value != "0"; ++digit_idx) {
-			// Делитель для нахождения цифры d_i равен (i + 1)
-			uint64_t divisor = digit_idx + 1;
-
-			// Остаток от деления на divisor — это цифра d_{digit_idx}
-			auto [quotient, remainder] = BNO::divide_string_by_integral(_value, divisor);
-			std::swap(_value, quotient);
-
-			// Добавляем цифру в вектор
-			// storage[0] будет d_0, storage[1] будет d_1 и т.д.
-			storage.push_back(remainder);
-
-			// _value обновляется частным внутри divide_string_by_integral, 
-			// цикл продолжается, пока частное не станет нулем
-		}
-
-		BNO::remove_zeros(storage, BNO::TrimMode::Trailing);
-		for (size_t idx = 0; idx < storage.size(); idx++) {
-			FA::put(_storage, idx, storage[idx]);
-		}
+		// Десятичная строка -> двоичные слова -> коэффициенты
+		factorial_from_limbs(LO::set_str<uint64_t>(value), _storage);
+		trim_leading_zeros();
 	}
 	int FactorialArithmetic::compare(const FactorialArithmetic& other) const noexcept {
-		using FA = internal::FactorAccess;
 		if (sign() != other.sign()) {
 			return sign() ? -1 : 1;
 		}
@@ -59,183 +313,283 @@ namespace numsystem {
 		if (this_is_zero && !other_is_zero) return -1;
 		if (!this_is_zero && other_is_zero) return 1;
 
-		size_t maxindex = std::max(_storage.value(), other._storage.value());
-		for (size_t i = maxindex + 1; i-- > 0;) {
-			uint64_t lhs_coeff = FA::extract(_storage, i).value_or(0);
-			uint64_t rhs_coeff = FA::extract(other._storage, i).value_or(0);
-
-			if (lhs_coeff < rhs_coeff) {
-				return sign() ? 1 : -1;
-			}
-			if (lhs_coeff > rhs_coeff) {
-				return sign() ? -1 : 1;
-			}
-		}
-
-		return 0;
+		// Сравниваем от старших коэффициентов к младшим
+		const int magnitude = compare_coefficients(_storage, other._storage);
+		return sign() ? -magnitude : magnitude;
 	}
 	
 	FactorialArithmetic FactorialArithmetic::add(const FactorialArithmetic& other) const {
-		FactorialArithmetic result;
-		int carry = 0;
-		size_t idx = 0;
-
-		while (true) {
-			auto a_opt = FA::extract(_storage, idx);
-			auto b_opt = FA::extract(other._storage, idx);
-
-			// Условие выхода: если оба коэффициента отсутствуют и нет переноса
-			if (!a_opt.has_value() && !b_opt.has_value() && carry == 0) break;
-
-			uint64_t a = a_opt.value_or(0);
-			uint64_t b = b_opt.value_or(0);
-			uint64_t base = idx + 1;
-
-			uint64_t sum = a + b + carry;
-			carry = 0;
-
-			if (sum >= base) {
-				carry = 1;
-				sum -= base;
-			}
-
-			FA::put(result._storage, idx, sum);
-			++idx;
-		}
+		NUMSYS_TRACE_OPERATION(Add, std::max(_storage.size(), other._storage.size()));
+		FactorialArithmetic result(*this);
+		add_coefficients(result._storage, other._storage);
 		result.trim_leading_zeros();
+		result.sign(false);
 		return result;
 	}
 	FactorialArithmetic FactorialArithmetic::subtract(const FactorialArithmetic& other) const {
-		FactorialArithmetic result;
-		int64_t borrow = 0;
-		size_t idx = 0;
-
-		while (true) {
-			auto a_opt = FA::extract(_storage, idx);
-			auto b_opt = FA::extract(other._storage, idx);
+		NUMSYS_TRACE_OPERATION(Subtract, std::max(_storage.size(), other._storage.size()));
+		FactorialArithmetic result(*this);
+		subtract_coefficients(result._storage, other._storage);
+		result.trim_leading_zeros();
+		result.sign(false);
+		return result;
+	}
+	void FactorialArithmetic::add_signed(const FactorialArithmetic& other, bool other_sign) {
+		if (other.is_zero()) return;
+		if (is_zero()) {
+			_storage = other._storage;
+			sign(other_sign);
+			return;
+		}
 
-			// Условие выхода: если обе опции пусты и нет долга
-			if (!a_opt.has_value() && !b_opt.has_value() && borrow == 0) break;
+		if (sign() == other_sign) {
+			// Знаки совпадают: складываем модули, знак не меняется
+			add_coefficients(_storage, other._storage);
+		}
+		else {
+			// Знаки разные: из большего модуля вычитаем меньший, знак — у большего
+			const int cmp = compare_coefficients(_storage, other._storage);
+			if (cmp == 0) {
+				_storage.clear();
+				_storage.push_back(0);
+				_storage.value(0);
+				sign(false);
+				return;
+			}
+			if (cmp > 0) {
+				subtract_coefficients(_storage, other._storage);
+			}
+			else {
+				impl::Storage<value_type> difference(other._storage);
+				subtract_coefficients(difference, _storage);
+				_storage = std::move(difference);
+				sign(other_sign);
+			}
+		}
+		trim_leading_zeros();
+	}
+	void FactorialArithmetic::add_assign(const FactorialArithmetic& other) {
+		NUMSYS_TRACE_OPERATION(Add, std::max(_storage.size(), other._storage.size()));
+		add_signed(other, other.sign());
+	}
+	void FactorialArithmetic::subtract_assign(const FactorialArithmetic& other) {
+		NUMSYS_TRACE_OPERATION(Subtract, std::max(_storage.size(), other._storage.size()));
+		add_signed(other, !other.sign());
+	}
+	void FactorialArithmetic::multiply_assign(const FactorialArithmetic& other) {
+		// Произведение всё равно собирается в новом хранилище из двоичных слов
+		*this = multiply(other);
+	}
+	
+	void FactorialArithmetic::add_small(uint64_t value, bool negative) {
+		if (is_zero()) {
+			*this = FactorialArithmetic(value);
+			sign(negative && value != 0);
+			return;
+		}
+		if (value == 0) return;
 
-			uint64_t a = a_opt.value_or(0);
-			uint64_t b = b_opt.value_or(0);
-			uint64_t base = idx + 1;
+		uint64_t digits[SCALAR_DIGITS] = {};
+		const uint64_t top = scalar_coefficients(value, digits);
+		const auto digit_at = [&](uint64_t index) { return index <= top ? digits[index] : 0; };
 
-			int64_t diff = static_cast<int64_t>(a) - static_cast<int64_t>(b) - borrow;
+		if (sign() == negative) {
+			// Перенос не больше 1 и гаснет на первом коэффициенте за top, где нет переполнения
+			internal::FactorCursor lhs(_storage, 1);
+			internal::FactorWriter writer(_storage, 1);
+			uint64_t carry = 0;
+			for (; lhs.index() <= top || carry != 0; ++lhs) {
+				const uint64_t base = lhs.index() + 1;
+				uint64_t sum = *lhs + digit_at(lhs.index()) + carry;
+				carry = (sum >= base) ? 1 : 0;
+				if (carry != 0) sum -= base;
+				writer.push(sum);
+			}
+		}
+		else {
+			// Старший коэффициент выше top означает |*this| >= (top + 1)! > value
+			int cmp = (_storage.value() > top) ? 1 : 0;
+			for (internal::FactorCursor lhs(_storage, top); cmp == 0 && lhs.index() > 0; --lhs) {
+				if (*lhs != digits[lhs.index()]) cmp = (*lhs < digits[lhs.index()]) ? -1 : 1;
+			}
+			if (cmp == 0) {
+				_storage.clear();
+				_storage.push_back(0);
+				_storage.value(0);
+				sign(false);
+				return;
+			}
 
-			if (diff < 0) {
-				diff += base;
-				borrow = 1;
+			internal::FactorCursor lhs(_storage, 1);
+			uint64_t borrow = 0;
+			if (cmp > 0) {
+				// |*this| -= value: заём тоже гаснет сразу за top
+				internal::FactorWriter writer(_storage, 1);
+				for (; lhs.index() <= top || borrow != 0; ++lhs) {
+					const uint64_t need = digit_at(lhs.index()) + borrow;
+					const uint64_t current = *lhs;
+					borrow = (current < need) ? 1 : 0;
+					writer.push(current + (borrow != 0 ? lhs.index() + 1 : 0) - need);
+				}
 			}
 			else {
-				borrow = 0;
+				// value - |*this|: все коэффициенты *this не выше top, результат собирается заново
+				uint64_t difference[SCALAR_DIGITS] = {};
+				for (; lhs.index() <= top; ++lhs) {
+					const uint64_t need = *lhs + borrow;
+					const uint64_t current = digits[lhs.index()];
+					borrow = (current < need) ? 1 : 0;
+					difference[lhs.index()] = current + (borrow != 0 ? lhs.index() + 1 : 0) - need;
+				}
+				_storage.clear();
+				_storage.value(0);
+				internal::FactorWriter writer(_storage);
+				for (uint64_t index = 0; index <= top; ++index) writer.push(difference[index]);
+				sign(negative);
 			}
-			FA::put(result._storage, idx, static_cast<uint64_t>(diff));
-
-			++idx;
+		}
+		trim_leading_zeros();
+	}
+	void FactorialArithmetic::mul_small(uint64_t value, bool negative) {
+		if (value == 0 || is_zero()) {
+			*this = FactorialArithmetic(0);
+			return;
 		}
 
-		// Диагностика: если остался долг, значит |lhs| < |rhs|
-		if (borrow != 0) {
-			FA::put(result._storage, idx, static_cast<uint64_t>(-borrow));
+		// s = d_k * value + carry, d_k = s mod (k + 1), carry = s / (k + 1).
+		// carry <= value, поэтому s <= (k + 1) * value и старшая половина s меньше k + 1
+		const uint64_t top = _storage.value();
+		internal::FactorCursor lhs(_storage, 1);
+		internal::FactorWriter writer(_storage, 1);
+		uint64_t carry = 0;
+		for (; lhs.index() <= top || carry != 0; ++lhs) {
+			uint64_t high = 0;
+			uint64_t low = OverflowOps::multiply<uint64_t>(*lhs, value, high);
+			low += carry;
+			high += (low < carry) ? 1 : 0;
+			uint64_t digit = 0;
+			carry = OverflowOps::divide<uint64_t>(high, low, lhs.index() + 1, digit);
+			writer.push(digit);
 		}
-		result.trim_leading_zeros();
-		return result;
+		sign(sign() != negative);
+		trim_leading_zeros();
+	}
+	uint64_t FactorialArithmetic::divmod_small(uint64_t divisor, bool negative) {
+		if (divisor == 0) throw std::overflow_error("Division by zero");
+		if (is_zero()) return 0;
+
+		const uint64_t remainder = divrem_coefficients(_storage, divisor);
+		trim_leading_zeros();
+		sign(!is_zero() && sign() != negative);
+		return remainder;
+	}
+	uint64_t FactorialArithmetic::mod_small(uint64_t divisor) const {
+		if (divisor == 0) throw std::overflow_error("Division by zero");
+		return divrem_coefficients(_storage, divisor);
+	}
+	size_t FactorialArithmetic::bit_length() const {
+		if (is_zero()) return 0;
+		const Limbs limbs = factorial_to_limbs(_storage);
+		const size_t size = LO::normalized_size(limbs.data(), limbs.size());
+		return (size - 1) * std::numeric_limits<uint64_t>::digits + LO::bit_width(limbs[size - 1]);
 	}
 	
 	FactorialArithmetic FactorialArithmetic::multiply(const FactorialArithmetic& other) const {
-		// Проверка на ноль (нужно определить метод is_zero() или использовать compare с 0)
+		NUMSYS_TRACE_OPERATION(Multiply, std::max(_storage.size(), other._storage.size()));
 		if (is_zero() || other.is_zero()) return FactorialArithmetic(0);
 
-		// Получаем строковые представления и знаки
-		std::string a = to_string(*this);
-		std::string b = to_string(other);
-		bool negA = (!a.empty() && a[0] == '-');
-		bool negB = (!b.empty() && b[0] == '-');
+		// Перемножаем в двоичном представлении и раскладываем результат обратно по факториалам
+		Limbs a = factorial_to_limbs(_storage);
+		Limbs b = factorial_to_limbs(other._storage);
+		if (a.size() < b.size()) std::swap(a, b);
 
-		// Убираем знак для работы с абсолютными значениями
-		if (negA) a.erase(0, 1);
-		if (negB) b.erase(0, 1);
-	
-		std::string res = BNO::multiply_strings(a, b);
-
-		// Восстанавливаем знак результата
-		if (negA ^ negB && res != "0") {
-			res.insert(res.begin(), '-');
-		}
+		Limbs product(a.size() + b.size(), 0, impl::current_resource());
+		LO::mul(product.data(), a.data(), a.size(), b.data(), b.size());
 
-		return FactorialArithmetic(res);
+		FactorialArithmetic result;
+		factorial_from_limbs(std::move(product), result._storage);
+		result.trim_leading_zeros();
+		result.sign(sign() != other.sign());
+		return result;
 	}
 	FactorialArithmetic FactorialArithmetic::divide(const FactorialArithmetic& other) const	{
-		if (is_zero()) return FactorialArithmetic(0);
+		return divmod(other).first;
+	}
+	std::pair<FactorialArithmetic, FactorialArithmetic> FactorialArithmetic::divmod(const FactorialArithmetic& other) const {
+		NUMSYS_TRACE_OPERATION(Divide, _storage.size());
 		if (other.is_zero()) throw std::overflow_error("Division by zero");
+		if (is_zero()) return { FactorialArithmetic(0), FactorialArithmetic(0) };
 
-		static constexpr char kMINUS = '-';
-
-		std::string a = to_string(*this);
-		std::string b = to_string(other);
-
-		bool negA = (!a.empty() && a[0] == kMINUS);
-		bool negB = (!b.empty() && b[0] == kMINUS);
+		const Limbs a = factorial_to_limbs(_storage);
+		const Limbs b = factorial_to_limbs(other._storage);
+		if (a.size() < b.size() || (a.size() == b.size() && LO::cmp_n(a.data(), b.data(), a.size()) < 0)) {
+			return { FactorialArithmetic(0), *this };
+		}
 
-		if (negA) a.erase(0, 1);
-		if (negB) b.erase(0, 1);
+		Limbs quotient(a.size() - b.size() + 1, 0, impl::current_resource());
+		Limbs remainder(b.size(), 0, impl::current_resource());
+		LO::divrem(quotient.data(), remainder.data(), a.data(), a.size(), b.data(), b.size());
 
-		auto [current, quotient] = BNO::divide_strings(a, b);
-		bool negResult = (negA ^ negB) && current != "0";
-		if (negResult) current.insert(current.begin(), kMINUS);
+		FactorialArithmetic q, r;
+		factorial_from_limbs(std::move(quotient), q._storage);
+		factorial_from_limbs(std::move(remainder), r._storage);
+		q.trim_leading_zeros();
+		r.trim_leading_zeros();
 
-		return FactorialArithmetic(current);
+		// Деление с усечением к нулю: остаток имеет знак lhs (нулевой остаток — без знака)
+		q.sign(!q.is_zero() && sign() != other.sign());
+		r.sign(!r.is_zero() && sign());
+		return { q, r };
 	}
 	FactorialArithmetic FactorialArithmetic::modulo(const FactorialArithmetic& other) const	{
-		if (other.is_zero()) throw std::overflow_error("Division by zero");
-		if (is_zero()) return FactorialArithmetic(0);
-
-		FactorialArithmetic quotient = divide(other);
-		FactorialArithmetic remainder = *this - (quotient * other);
-
-		// Остаток всегда имеет знак lhs
-		remainder.sign(this->sign());
-		remainder.trim_leading_zeros();
-		return remainder;
+		return divmod(other).second;
 	}
 		
+	FactorialArithmetic FactorialArithmetic::from_coefficients(ConstSpan<uint64_t> coefficients, bool negative) {
+		if (!coefficients.empty() && coefficients[0] != 0) throw std::invalid_argument("from_coefficients: the coefficient at 0! must be 0");
+		FactorialArithmetic result;
+		pack_coefficients(coefficients.data(), coefficients.size(), result._storage);
+		result.trim_leading_zeros();
+		result.sign(negative && !result.is_zero());
+		return result;
+	}
+	BinaryArithmetic FactorialArithmetic::to_binary() const {
+		const Limbs limbs = factorial_to_limbs(_storage);
+		return BinaryArithmetic::from_limbs(limbs, sign());
+	}
+	FactorialArithmetic FactorialArithmetic::from_binary(const BinaryArithmetic& value) {
+		const ConstSpan<uint64_t> limbs = value.limbs();
+		FactorialArithmetic result;
+		factorial_from_limbs(limbs, result._storage);
+		result.trim_leading_zeros();
+		result.sign(value.sign() && !result.is_zero());
+		return result;
+	}
 	bool FactorialArithmetic::is_zero() const noexcept {
-		for (size_t idx = 0; idx < FA::MAXINDEX; ++idx) {
-			auto digit_opt = FA::extract(_storage, idx);
-			if (!digit_opt.has_value()) {
-				break; // достигли конца
-			}
-			if (digit_opt.value() != 0) {
-				return false; // нашли ненулевой коэффициент
-			}
-		}
-		return true; // всё нули
+		// Биты за последним коэффициентом всегда нулевые, поэтому достаточно проверить слова
+		return std::all_of(_storage.begin(), _storage.end(), [](value_type word) { return word == 0; });
 	}
 	void FactorialArithmetic::trim_leading_zeros() noexcept {
-		size_t maxindex = 0;
+		NUMSYS_COUNT_OPERATION(Trim, _storage.size());
+		// Последнее ненулевое слово
+		size_t words_used = _storage.size();
+		while (words_used > 0 && _storage[words_used - 1] == 0) --words_used;
 
-		// Находим последний индекс, где есть коэффициент
-		for (size_t idx = 0; idx < FA::MAXINDEX; ++idx) {
-			auto digit_opt = FA::extract(_storage, idx);
-			if (!digit_opt.has_value()) {
-				break; // достигли конца коэффициентов
-			}
-			maxindex = idx;
-		}
-
-		// Если нет ни одного коэффициента, очищаем весь storage
-		if (maxindex == 0 && !_storage.empty()) {
+		// Если нет ни одного ненулевого коэффициента, очищаем весь storage
+		if (words_used == 0) {
 			_storage.clear();
 			_storage.push_back(0);
 			_storage.value(0);
 			return;
 		}
 
-		// Считаем сколько бит занято для коэффициентов от 0 до max_index включительно
-		// Подсчёт количества слов (элементов) в _storage, которые занимают эти биты
+		// Старший ненулевой коэффициент — тот, в который попадает старший единичный бит
+		uint64_t top_bit = (words_used - 1) * _storage.VALUE_COUNT_BIT + FA::log2_floor(_storage[words_used - 1]);
+		uint64_t maxindex = FA::index_at_bit(top_bit);
+
+		// Подсчёт количества слов (элементов) в _storage, которые занимают коэффициенты от 0 до maxindex
 		size_t bits_used = FA::total_bits_up_to(maxindex + 1);
-		size_t words_used = (bits_used + _storage.VALUE_COUNT_BIT - 1) / _storage.VALUE_COUNT_BIT;
+		words_used = (bits_used + _storage.VALUE_COUNT_BIT - 1) / _storage.VALUE_COUNT_BIT;
 
 		// Обрезаем _storage до words_used
 		if (_storage.size() > words_used) {
@@ -244,70 +598,15 @@ namespace numsystem {
 		_storage.value(maxindex);
 	}
 	std::string to_string(const FactorialArithmetic& other) {
+		NUMSYS_TRACE_OPERATION(Format, other._storage.size());
 		if (other.is_zero()) return "0";
-		const auto& refdata = other._storage;
-		auto multiply_string_by_uint64 = [](std::string_view num_str, uint64_t factor) -> std::string {
-			if (factor == 0 || num_str == "0") return "0";
-			if (factor == 1) return std::string(num_str); // копируем исходную строку как есть
-
-			std::string result;
-			result.reserve(num_str.size() + 20); // немного с запасом
-
-			uint64_t carry = 0;
-			for (int i = static_cast<int>(num_str.length()) - 1; i >= 0; --i) {
-				uint64_t digit = num_str[i] - '0';
-				uint64_t product = digit * factor + carry;
-				result += std::to_string(product % 10);
-				carry = product / 10;
-			}
-			while (carry > 0) {
-				result += std::to_string(carry % 10);
-				carry /= 10;
-			}
-			std::reverse(result.begin(), result.end());
-			return result;
-			};
-		auto add_strings = [](std::string_view num1_str, std::string_view num2_str) -> std::string {
-			if (num1_str == "0") return std::string(num2_str);
-			if (num2_str == "0") return std::string(num1_str);
-
-			std::string sum;
-			sum.reserve(std::max(num1_str.size(), num2_str.size()) + 1);
-
-			int i = static_cast<int>(num1_str.length()) - 1;
-			int j = static_cast<int>(num2_str.length()) - 1;
-			int carry = 0;
-
-			while (i >= 0 || j >= 0 || carry) {
-				int digit1 = (i >= 0) ? num1_str[i--] - '0' : 0;
-				int digit2 = (j >= 0) ? num2_str[j--] - '0' : 0;
-				int current_sum = digit1 + digit2 + carry;
-				sum += std::to_string(current_sum % 10);
-				carry = current_sum / 10;
-			}
-			std::reverse(sum.begin(), sum.end());
-			return sum;
-			};
-
-		std::string decimal_sum = "0";
-		std::string current_factorial = "1";  // 0! = 1
 
-		for (size_t idx = 0; idx <= refdata.value(); ++idx) {
-			auto value_r_opt = FA::extract(refdata, idx);
-			if (!value_r_opt.has_value()) break;
-
-			uint64_t coefficient = value_r_opt.value();
-			if (coefficient != 0) {
-				std::string term_str = multiply_string_by_uint64(current_factorial, coefficient);
-				decimal_sum = add_strings(decimal_sum, term_str);
-			}
-
-			current_factorial = multiply_string_by_uint64(current_factorial, idx + 1);
-		}
-
-		if (other.sign() && decimal_sum != "0") {
-			return "-" + decimal_sum;
+		// Коэффициенты -> двоичные слова -> десятичная строка
+		const Limbs limbs = factorial_to_limbs(other._storage);
+		std::string digits = LO::get_str(limbs.data(), limbs.size());
+		if (other.sign()) {
+			digits.insert(digits.begin(), '-');
 		}
-		return decimal_sum;
-	}	
+		return digits;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "Instrumentation.h"
+
+namespace numsystem {
+    InstrumentationSnapshot instrumentation_snapshot() noexcept {
+        InstrumentationSnapshot snapshot;
+        if constexpr (instrumentation_enabled()) {
+            const impl::InstrumentationCounters& counters = impl::instrumentation_counters();
+            for (size_t kind = 0; kind < OPERATION_KINDS; ++kind) {
+                for (size_t bucket = 0; bucket < SIZE_BUCKETS; ++bucket) {
+                    snapshot.operations[kind][bucket] = counters.operations[kind][bucket].load(std::memory_order_relaxed);
+                }
+            }
+            for (size_t tier = 0; tier < ALGORITHM_KINDS; ++tier) {
+                snapshot.algorithms[tier] = counters.algorithms[tier].load(std::memory_order_relaxed);
+            }
+            snapshot.reallocations = counters.reallocations.load(std::memory_order_relaxed);
+            snapshot.bytes_allocated = counters.bytes_allocated.load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    void reset_instrumentation() noexcept {
+        impl::InstrumentationCounters& counters = impl::instrumentation_counters();
+        for (auto& buckets : counters.operations) {
+            for (auto& count : buckets) count.store(0, std::memory_order_relaxed);
+        }
+        for (auto& count : counters.algorithms) count.store(0, std::memory_order_relaxed);
+        counters.reallocations.store(0, std::memory_order_relaxed);
+        counters.bytes_allocated.store(0, std::memory_order_relaxed);
+    }
+
+    void set_trace_hook(TraceHook hook, void* context) noexcept {
+        if constexpr (instrumentation_enabled()) {
+            impl::InstrumentationCounters& counters = impl::instrumentation_counters();
+            // Сначала контекст, затем hook: загрузившая hook операция увидит и его контекст
+            counters.context.store(context, std::memory_order_relaxed);
+            counters.hook.store(hook, std::memory_order_release);
+        }
+        else {
+            (void)hook;
+            (void)context;
+        }
+    }
+}
@@ -0,0 +1,834 @@
+﻿#include "LimbOperations.h"
+#include "Parallel.h"
+#include "Tables.h"
+
+namespace numsystem {
+    namespace impl {
+        namespace {
+            using LO = LimbOperations;
+
+            // Временные буферы умножения и деления берут память из ресурса текущего потока
+            template<typename _Ty>
+            using Scratch = std::pmr::vector<_Ty>;
+
+            // Знаковое число «модуль + знак» для промежуточных значений Тоома-3,
+            // которые в отличие от входов могут быть отрицательными.
+            template<typename _Ty>
+            struct SignedLimbs {
+                Scratch<_Ty> mag{ current_resource() };
+                bool neg = false;
+
+                SignedLimbs() = default;
+                SignedLimbs(const _Ty* data, size_t n) : mag(data, data + LO::normalized_size(data, n), current_resource()) {}
+
+                void normalize() {
+                    mag.resize(LO::normalized_size(mag.data(), mag.size()));
+                    if (mag.empty()) neg = false;
+                }
+            };
+
+            template<typename _Ty>
+            int cmp_magnitude(const Scratch<_Ty>& a, const Scratch<_Ty>& b) {
+                if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+                return LO::cmp_n(a.data(), b.data(), a.size());
+            }
+
+            // x ± y, где знак y дополнительно инвертируется при negate_y
+            template<typename _Ty>
+            SignedLimbs<_Ty> signed_add(const SignedLimbs<_Ty>& x, const SignedLimbs<_Ty>& y, bool negate_y) {
+                const bool y_neg = y.neg != negate_y && !y.mag.empty();
+                SignedLimbs<_Ty> result;
+                if (x.neg == y_neg) {
+                    const auto& big = x.mag.size() >= y.mag.size() ? x.mag : y.mag;
+                    const auto& small = x.mag.size() >= y.mag.size() ? y.mag : x.mag;
+                    result.mag.resize(big.size() + 1);
+                    result.mag[big.size()] = LO::add(result.mag.data(), big.data(), big.size(), small.data(), small.size());
+                    result.neg = x.neg;
+                }
+                else {
+                    const bool x_ge = cmp_magnitude(x.mag, y.mag) >= 0;
+                    const auto& big = x_ge ? x.mag : y.mag;
+                    const auto& small = x_ge ? y.mag : x.mag;
+                    result.mag.resize(big.size());
+                    LO::sub(result.mag.data(), big.data(), big.size(), small.data(), small.size());
+                    result.neg = x_ge ? x.neg : y_neg;
+                }
+                result.normalize();
+                return result;
+            }
+
+            template<typename _Ty>
+            SignedLimbs<_Ty> signed_mul(const SignedLimbs<_Ty>& x, const SignedLimbs<_Ty>& y) {
+                SignedLimbs<_Ty> result;
+                if (x.mag.empty() || y.mag.empty()) return result;
+                const auto& big = x.mag.size() >= y.mag.size() ? x.mag : y.mag;
+                const auto& small = x.mag.size() >= y.mag.size() ? y.mag : x.mag;
+                result.mag.resize(big.size() + small.size());
+                LO::mul(result.mag.data(), big.data(), big.size(), small.data(), small.size());
+                result.neg = x.neg != y.neg;
+                result.normalize();
+                return result;
+            }
+
+            // Сдвиг модуля на один бит влево/вправо; вправо используется только для точного деления на 2
+            template<typename _Ty>
+            void shift_one(SignedLimbs<_Ty>& x, bool left) {
+                constexpr int BITS = std::numeric_limits<_Ty>::digits;
+                if (left) {
+                    _Ty carry = 0;
+                    for (auto& limb : x.mag) {
+                        _Ty next = static_cast<_Ty>(limb >> (BITS - 1));
+                        limb = static_cast<_Ty>((limb << 1) | carry);
+                        carry = next;
+                    }
+                    if (carry) x.mag.push_back(carry);
+                }
+                else {
+                    _Ty carry = 0;
+                    for (size_t i = x.mag.size(); i-- > 0;) {
+                        _Ty next = static_cast<_Ty>(x.mag[i] & 1);
+                        x.mag[i] = static_cast<_Ty>((x.mag[i] >> 1) | (carry << (BITS - 1)));
+                        carry = next;
+                    }
+                    x.normalize();
+                }
+            }
+
+            template<typename _Ty>
+            void divexact_3(SignedLimbs<_Ty>& x) {
+                LO::divrem_1<_Ty>(x.mag.data(), x.mag.data(), x.mag.size(), 3);
+                x.normalize();
+            }
+
+            // r[offset..rn) += x, x неотрицательно и гарантированно помещается
+            template<typename _Ty>
+            void add_at(_Ty* r, size_t rn, size_t offset, const SignedLimbs<_Ty>& x) {
+                if (x.mag.empty()) return;
+                LO::add(r + offset, r + offset, rn - offset, x.mag.data(), x.mag.size());
+            }
+
+            // a * b, где an >= bn, но bn > an / 2 не гарантируется:
+            // a режется на куски по bn слов, каждый кусок умножается как сбалансированная пара
+            template<typename _Ty>
+            void mul_unbalanced(_Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn) {
+                std::fill(r, r + an + bn, _Ty(0));
+                Scratch<_Ty> product(2 * bn, current_resource());
+                for (size_t offset = 0; offset < an; offset += bn) {
+                    const size_t chunk = std::min(bn, an - offset);
+                    if (chunk >= bn) LO::mul(product.data(), a + offset, chunk, b, bn);
+                    else             LO::mul(product.data(), b, bn, a + offset, chunk);
+                    LO::add(r + offset, r + offset, an + bn - offset, product.data(), chunk + bn);
+                }
+            }
+
+            // Карацуба: a = a1*B^h + a0, b = b1*B^h + b0,
+            // a*b = z2*B^2h + ((a0+a1)(b0+b1) - z0 - z2)*B^h + z0
+            template<typename _Ty>
+            void mul_karatsuba(_Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn) {
+                const size_t h = (an + 1) / 2;
+                const size_t a1n = an - h;
+                const size_t b1n = bn - h;      // bn > an / 2, значит bn >= h
+                const size_t rn = an + bn;
+
+                if (b1n == 0) {
+                    mul_unbalanced(r, a, an, b, bn);
+                    return;
+                }
+
+                Scratch<_Ty> scratch(4 * h + 4, current_resource());
+                _Ty* sa = scratch.data();
+                _Ty* sb = sa + h + 1;
+                _Ty* t = sb + h + 1;
+
+                sa[h] = LO::add(sa, a, h, a + h, a1n);
+                sb[h] = LO::add(sb, b, h, b + h, b1n);
+
+                // Три произведения пишут в непересекающиеся области и могут считаться параллельно
+                parallel_invoke(bn,
+                    [&] { LO::mul(r, a, h, b, h); },                        // z0 -> r[0..2h)
+                    [&] { LO::mul(r + 2 * h, a + h, a1n, b + h, b1n); },    // z2 -> r[2h..rn)
+                    [&] { LO::mul(t, sa, h + 1, sb, h + 1); });
+
+                LO::sub(t, t, 2 * h + 2, r, 2 * h);
+                LO::sub(t, t, 2 * h + 2, r + 2 * h, a1n + b1n);
+                LO::add(r + h, r + h, rn - h, t, LO::normalized_size(t, 2 * h + 2));
+            }
+
+            // Тоом-3 с точками 0, 1, -1, -2, inf и интерполяцией по Бодрато
+            template<typename _Ty>
+            void mul_toom3(_Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn) {
+                const size_t k = (an + 2) / 3;
+                const size_t a2n = an - 2 * k;
+                const size_t b2n = bn - 2 * k;  // вызывающий гарантирует bn > 2k
+                const size_t rn = an + bn;
+
+                using S = SignedLimbs<_Ty>;
+                const auto evaluate = [k](const _Ty* x, size_t x2n, S& p1, S& pm1, S& pm2) {
+                    const S x0(x, k), x1(x + k, k), x2(x + 2 * k, x2n);
+                    const S even = signed_add(x0, x2, false);
+                    p1 = signed_add(even, x1, false);
+                    pm1 = signed_add(even, x1, true);
+                    pm2 = signed_add(pm1, x2, false);
+                    shift_one(pm2, true);
+                    pm2 = signed_add(pm2, x0, true);
+                };
+
+                S p1, pm1, pm2, q1, qm1, qm2;
+                evaluate(a, a2n, p1, pm1, pm2);
+                evaluate(b, b2n, q1, qm1, qm2);
+
+                S w1, wm1, wm2;
+                std::fill(r, r + rn, _Ty(0));
+                parallel_invoke(bn,
+                    [&] { w1 = signed_mul(p1, q1); },
+                    [&] { wm1 = signed_mul(pm1, qm1); },
+                    [&] { wm2 = signed_mul(pm2, qm2); },
+                    [&] { LO::mul(r, a, k, b, k); },                 // w0 -> r[0..2k)
+                    [&] {
+                        if (a2n >= b2n) LO::mul(r + 4 * k, a + 2 * k, a2n, b + 2 * k, b2n);
+                        else            LO::mul(r + 4 * k, b + 2 * k, b2n, a + 2 * k, a2n);
+                    });
+                const S w0(r, 2 * k);
+                const S winf(r + 4 * k, a2n + b2n);
+
+                S r3 = signed_add(wm2, w1, true);
+                divexact_3(r3);
+                S r1 = signed_add(w1, wm1, true);
+                shift_one(r1, false);
+                S r2 = signed_add(wm1, w0, true);
+                r3 = signed_add(r2, r3, true);
+                shift_one(r3, false);
+                S winf2 = winf;
+                shift_one(winf2, true);
+                r3 = signed_add(r3, winf2, false);
+                r2 = signed_add(signed_add(r2, r1, false), winf, true);
+                r1 = signed_add(r1, r3, true);
+
+                add_at(r, rn, k, r1);
+                add_at(r, rn, 2 * k, r2);
+                add_at(r, rn, 3 * k, r3);
+            }
+
+            // Поле вычетов по простому p < 2^63 в представлении Монтгомери с R = 2^64
+            struct NttField {
+                uint64_t p = 0;
+                uint64_t inv = 0;       // p^-1 mod 2^64
+                uint64_t r1 = 0;        // R mod p — единица в представлении Монтгомери
+                uint64_t r2 = 0;        // R^2 mod p
+                uint64_t generator = 0; // первообразный корень, в обычном виде
+                unsigned max_log = 0;   // 2^max_log делит p - 1
+
+                NttField(uint64_t prime, uint64_t root, unsigned log) noexcept : p(prime), generator(root), max_log(log) {
+                    inv = LO::binvert_limb(p);
+                    r1 = (uint64_t(0) - p) % p;
+                    uint64_t high = 0;
+                    const uint64_t low = OverflowAwareOps::multiply(r1, r1, high);
+                    OverflowAwareOps::divide(high, low, p, r2);
+                }
+
+                // a * b * R^-1 mod p, требуется a * b < p * 2^64 (например, b < p)
+                uint64_t mul(uint64_t a, uint64_t b) const noexcept {
+                    uint64_t high = 0, uh = 0;
+                    const uint64_t low = OverflowAwareOps::multiply(a, b, high);
+                    OverflowAwareOps::multiply(low * inv, p, uh);
+                    // Младшие слова a * b и u * p совпадают, остаётся разность старших
+                    return high >= uh ? high - uh : high - uh + p;
+                }
+                uint64_t add(uint64_t a, uint64_t b) const noexcept {
+                    const uint64_t s = a + b;
+                    return s >= p ? s - p : s;
+                }
+                uint64_t sub(uint64_t a, uint64_t b) const noexcept {
+                    return a >= b ? a - b : a - b + p;
+                }
+                // Любое 64-битное x в представление Монтгомери (заодно приводит по модулю p)
+                uint64_t to_montgomery(uint64_t x) const noexcept { return mul(x, r2); }
+                // x^e для x в представлении Монтгомери
+                uint64_t pow(uint64_t x, uint64_t e) const noexcept {
+                    uint64_t result = r1;
+                    for (; e != 0; e >>= 1, x = mul(x, x)) {
+                        if (e & 1) result = mul(result, x);
+                    }
+                    return result;
+                }
+            };
+
+            // Три простых вида k * 2^m + 1: p1 * p2 * p3 > 2^183 вмещает свёртку 64-битных слов длиной до 2^54
+            const NttField* ntt_fields() {
+                static const NttField fields[3] = {
+                    { 4179340454199820289ULL, 3, 57 },     // 29 * 2^57 + 1
+                    { 2485986994308513793ULL, 5, 55 },     // 69 * 2^55 + 1
+                    { 1945555039024054273ULL, 5, 56 },     // 27 * 2^56 + 1
+                };
+                return fields;
+            }
+
+            // roots[len + j] = w^j, w — первообразный корень степени 2 * len (или обратный к нему);
+            // таблица на все этапы преобразования длины n занимает n слов
+            void ntt_roots(const NttField& f, uint64_t* roots, size_t n, bool inverse) {
+                for (size_t len = 1; len < n; len *= 2) {
+                    uint64_t w = f.pow(f.to_montgomery(f.generator), (f.p - 1) / (2 * len));
+                    if (inverse) w = f.pow(w, f.p - 2);
+                    roots[len] = f.r1;
+                    for (size_t j = 1; j < len; ++j) roots[len + j] = f.mul(roots[len + j - 1], w);
+                }
+            }
+
+            // Прямое преобразование с прореживанием по частоте: естественный порядок на входе, бит-реверсный на выходе
+            void ntt_forward(const NttField& f, uint64_t* a, size_t n, const uint64_t* roots) {
+                for (size_t len = n / 2; len >= 1; len /= 2) {
+                    for (size_t i = 0; i < n; i += 2 * len) {
+                        for (size_t j = 0; j < len; ++j) {
+                            const uint64_t u = a[i + j], v = a[i + j + len];
+                            a[i + j] = f.add(u, v);
+                            a[i + j + len] = f.mul(f.sub(u, v), roots[len + j]);
+                        }
+                    }
+                }
+            }
+
+            // Обратное преобразование с прореживанием по времени: бит-реверсный порядок на входе, естественный на выходе
+            void ntt_inverse(const NttField& f, uint64_t* a, size_t n, const uint64_t* roots) {
+                for (size_t len = 1; len < n; len *= 2) {
+                    for (size_t i = 0; i < n; i += 2 * len) {
+                        for (size_t j = 0; j < len; ++j) {
+                            const uint64_t u = a[i + j], v = f.mul(a[i + j + len], roots[len + j]);
+                            a[i + j] = f.add(u, v);
+                            a[i + j + len] = f.sub(u, v);
+                        }
+                    }
+                }
+            }
+
+            // out[0..n) = свёртка a и b по модулю f.p в обычном виде; при a == b — одно прямое преобразование
+            void ntt_convolve(const NttField& f, uint64_t* out, const uint64_t* a, size_t an, const uint64_t* b, size_t bn, size_t n) {
+                Scratch<uint64_t> roots(n, current_resource());
+                ntt_roots(f, roots.data(), n, false);
+
+                for (size_t i = 0; i < an; ++i) out[i] = f.to_montgomery(a[i]);
+                std::fill(out + an, out + n, uint64_t(0));
+                ntt_forward(f, out, n, roots.data());
+                if (a == b && an == bn) {
+                    for (size_t i = 0; i < n; ++i) out[i] = f.mul(out[i], out[i]);
+                }
+                else {
+                    Scratch<uint64_t> other(n, 0, current_resource());
+                    for (size_t i = 0; i < bn; ++i) other[i] = f.to_montgomery(b[i]);
+                    ntt_forward(f, other.data(), n, roots.data());
+                    for (size_t i = 0; i < n; ++i) out[i] = f.mul(out[i], other[i]);
+                }
+
+                ntt_roots(f, roots.data(), n, true);
+                ntt_inverse(f, out, n, roots.data());
+                // Умножение на обычное n^-1 = p - (p - 1) / n заодно выводит из представления Монтгомери
+                const uint64_t n_inv = f.p - (f.p - 1) / n;
+                for (size_t i = 0; i < n; ++i) out[i] = f.mul(out[i], n_inv);
+            }
+
+            // r[0..an+bn) = a * b для 64-битных слов: три свёртки по модулям и восстановление по КТО (схема Гарнера)
+            void mul_ntt(uint64_t* r, const uint64_t* a, size_t an, const uint64_t* b, size_t bn) {
+                const NttField* fields = ntt_fields();
+                const size_t rn = an + bn;
+                size_t n = 1;
+                unsigned log = 0;
+                for (; n < rn - 1; n *= 2) ++log;
+                if (log > std::min({ fields[0].max_log, fields[1].max_log, fields[2].max_log })) {
+                    throw std::length_error("Operands are too long for the number-theoretic transform");
+                }
+
+                Scratch<uint64_t> residues(3 * n, current_resource());
+                uint64_t* c[3] = { residues.data(), residues.data() + n, residues.data() + 2 * n };
+                // Свёртки по трём модулям независимы
+                parallel_invoke(bn,
+                    [&] { ntt_convolve(fields[0], c[0], a, an, b, bn, n); },
+                    [&] { ntt_convolve(fields[1], c[1], a, an, b, bn, n); },
+                    [&] { ntt_convolve(fields[2], c[2], a, an, b, bn, n); });
+
+                const NttField& f1 = fields[0];
+                const NttField& f2 = fields[1];
+                const NttField& f3 = fields[2];
+                // Константы Гарнера в представлении Монтгомери: mul(x, c) даёт обычное x * c mod p
+                const uint64_t inv_p1_mod_p2 = f2.pow(f2.to_montgomery(f1.p), f2.p - 2);
+                const uint64_t p1_mod_p3 = f3.to_montgomery(f1.p);
+                uint64_t p12_high = 0;
+                const uint64_t p12_low = OverflowAwareOps::multiply(f1.p, f2.p, p12_high);
+                const uint64_t inv_p12_mod_p3 = f3.pow(f3.mul(f3.to_montgomery(f1.p), f3.to_montgomery(f2.p)), f3.p - 2);
+
+                // x = r1 + p1 * t2 + p1 * p2 * t3 < 2^184; перенос в следующий коэффициент — старшие два слова суммы
+                uint64_t carry[2] = { 0, 0 };
+                for (size_t i = 0; i < rn; ++i) {
+                    uint64_t x[3] = { carry[0], carry[1], 0 };
+                    if (i < rn - 1) {
+                        const uint64_t r1 = c[0][i], r2 = c[1][i], r3 = c[2][i];
+                        const uint64_t t2 = f2.mul(f2.sub(r2, f2.mul(r1, f2.r1)), inv_p1_mod_p2);
+                        const uint64_t t3 = f3.mul(f3.sub(r3, f3.add(f3.mul(r1, f3.r1), f3.mul(t2, p1_mod_p3))), inv_p12_mod_p3);
+
+                        uint64_t term[3] = { 0, 0, 0 };
+                        term[0] = OverflowAwareOps::multiply(f1.p, t2, term[1]);
+                        LO::add(x, x, 3, term, 2);
+                        term[0] = OverflowAwareOps::multiply(p12_low, t3, term[1]);
+                        LO::add(x, x, 3, term, 2);
+                        term[1] = OverflowAwareOps::multiply(p12_high, t3, term[2]);
+                        LO::add(x + 1, x + 1, 2, term + 1, 2);
+                        LO::add_1(x, x, 3, r1);
+                    }
+                    r[i] = x[0];
+                    carry[0] = x[1];
+                    carry[1] = x[2];
+                }
+            }
+
+            // Длина преобразования — степень двойки, поэтому сразу за каждой степенью NTT почти вдвое длиннее
+            // произведения и проигрывает Тоому-3; берём его, только если дополнение не больше половины
+            template<typename _Ty>
+            bool ntt_pays_off(size_t an, size_t bn) noexcept {
+                const size_t words = ((an + bn) * sizeof(_Ty) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+                size_t n = 1;
+                while (n < words - 1) n *= 2;
+                return 2 * n <= 3 * words;
+            }
+
+            // NTT работает с 64-битными словами: более узкие слова упаковываются и распаковываются
+            template<typename _Ty>
+            void mul_fft(_Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn) {
+                if constexpr (std::is_same_v<_Ty, uint64_t>) {
+                    mul_ntt(r, a, an, b, bn);
+                }
+                else {
+                    constexpr size_t PER_WORD = sizeof(uint64_t) / sizeof(_Ty);
+                    constexpr unsigned BITS = std::numeric_limits<_Ty>::digits;
+                    const auto pack = [](const _Ty* x, size_t xn) {
+                        Scratch<uint64_t> words((xn + PER_WORD - 1) / PER_WORD, 0, current_resource());
+                        for (size_t i = 0; i < xn; ++i) words[i / PER_WORD] |= static_cast<uint64_t>(x[i]) << (i % PER_WORD * BITS);
+                        return words;
+                    };
+                    const Scratch<uint64_t> wa = pack(a, an);
+                    const Scratch<uint64_t> wb = (a == b && an == bn) ? Scratch<uint64_t>(current_resource()) : pack(b, bn);
+                    const uint64_t* pb = wb.empty() ? wa.data() : wb.data();
+                    const size_t pbn = wb.empty() ? wa.size() : wb.size();
+                    Scratch<uint64_t> product(wa.size() + pbn, current_resource());
+                    mul_ntt(product.data(), wa.data(), wa.size(), pb, pbn);
+                    for (size_t i = 0; i < an + bn; ++i) r[i] = static_cast<_Ty>(product[i / PER_WORD] >> (i % PER_WORD * BITS));
+                }
+            }
+
+            // Степень 10^(chunk_digits * 2^k)
+            template<typename _Ty>
+            struct DecimalPower {
+                std::vector<_Ty> power;
+                size_t digits = 0;
+            };
+
+            // Кэш степеней 10 на процесс: уровни читаются без блокировок, обратные величины
+            // для редукции Барретта лежат в отдельной таблице и считаются по требованию
+            template<typename _Ty>
+            class DecimalPowers {
+            public:
+                static const DecimalPower<_Ty>& level(size_t k) {
+                    return powers().get(k, [](size_t index) {
+                        if (index == 0) return DecimalPower<_Ty>{ { LO::chunk_base<_Ty>() }, LO::chunk_digits<_Ty>() };
+                        const DecimalPower<_Ty>& last = powers()[index - 1];
+                        const size_t m = last.power.size();
+                        std::vector<_Ty> square(2 * m);
+                        LO::mul(square.data(), last.power.data(), m, last.power.data(), m);
+                        square.resize(LO::normalized_size(square.data(), square.size()));
+                        return DecimalPower<_Ty>{ std::move(square), 2 * last.digits };
+                    });
+                }
+                // floor(B^(2m) / power), m = power.size()
+                static const std::vector<_Ty>& inverse(size_t k) {
+                    return inverses().get(k, [](size_t index) {
+                        const std::vector<_Ty>& power = level(index).power;
+                        const size_t m = power.size();
+                        std::vector<_Ty> numerator(2 * m + 1, 0);
+                        numerator[2 * m] = 1;
+                        std::vector<_Ty> remainder(m);
+                        std::vector<_Ty> result(m + 2);
+                        LO::divrem(result.data(), remainder.data(), numerator.data(), numerator.size(), power.data(), m);
+                        result.resize(LO::normalized_size(result.data(), result.size()));
+                        return result;
+                    });
+                }
+
+            private:
+                static GrowOnlyTable<DecimalPower<_Ty>>& powers() {
+                    static GrowOnlyTable<DecimalPower<_Ty>> table;
+                    return table;
+                }
+                static GrowOnlyTable<std::vector<_Ty>>& inverses() {
+                    static GrowOnlyTable<std::vector<_Ty>> table;
+                    return table;
+                }
+            };
+
+            // Редукция Барретта: q = x / P, r = x % P при xn <= 2m (HAC 14.42), не больше двух поправок
+            template<typename _Ty>
+            void divrem_barrett(std::vector<_Ty>& q, std::vector<_Ty>& r, const _Ty* x, size_t xn,
+                const std::vector<_Ty>& p, const std::vector<_Ty>& inv) {
+                const size_t m = p.size();
+
+                // q = floor(floor(x / B^(m-1)) * inverse / B^(m+1))
+                const _Ty* t = x + (m - 1);
+                const size_t tn = xn - (m - 1);
+                std::vector<_Ty> product(tn + inv.size());
+                if (tn >= inv.size()) LO::mul(product.data(), t, tn, inv.data(), inv.size());
+                else                  LO::mul(product.data(), inv.data(), inv.size(), t, tn);
+                q.assign(product.begin() + std::min(product.size(), m + 1), product.end());
+                q.resize(LO::normalized_size(q.data(), q.size()));
+
+                // r = x - q * P
+                r.assign(x, x + xn);
+                if (!q.empty()) {
+                    std::vector<_Ty> qp(q.size() + m);
+                    if (q.size() >= m) LO::mul(qp.data(), q.data(), q.size(), p.data(), m);
+                    else               LO::mul(qp.data(), p.data(), m, q.data(), q.size());
+                    LO::sub(r.data(), r.data(), xn, qp.data(), LO::normalized_size(qp.data(), qp.size()));
+                }
+                r.resize(LO::normalized_size(r.data(), r.size()));
+
+                while (r.size() > m || (r.size() == m && LO::cmp_n(r.data(), p.data(), m) >= 0)) {
+                    LO::sub(r.data(), r.data(), r.size(), p.data(), m);
+                    r.resize(LO::normalized_size(r.data(), r.size()));
+                    q.push_back(0);
+                    LO::add_1(q.data(), q.data(), q.size(), _Ty(1));
+                    q.resize(LO::normalized_size(q.data(), q.size()));
+                }
+            }
+
+            // Цифры x пишутся справа налево, заканчивая перед end. При pad != 0 результат
+            // дополняется ведущими нулями ровно до pad цифр, иначе ведущие нули снимаются
+            template<typename _Ty>
+            char* format_basecase(char* end, std::vector<_Ty> x, size_t pad) {
+                constexpr unsigned DIGITS = LO::chunk_digits<_Ty>();
+                constexpr _Ty BASE = LO::chunk_base<_Ty>();
+                char* p = end;
+                size_t n = LO::normalized_size(x.data(), x.size());
+                while (n != 0) {
+                    _Ty chunk = LO::divrem_1(x.data(), x.data(), n, BASE);
+                    n = LO::normalized_size(x.data(), n);
+                    for (unsigned i = 0; i < DIGITS; ++i) {
+                        *--p = static_cast<char>('0' + chunk % 10);
+                        chunk = static_cast<_Ty>(chunk / 10);
+                    }
+                }
+                if (pad != 0) {
+                    while (static_cast<size_t>(end - p) < pad) *--p = '0';
+                }
+                else {
+                    while (end - p > 1 && *p == '0') ++p;
+                }
+                return p;
+            }
+
+            template<typename _Ty>
+            char* format_dc(char* end, const _Ty* x, size_t xn, size_t pad) {
+                xn = LO::normalized_size(x, xn);
+                if (xn < ConversionThresholds::GET_STR_DC) {
+                    NUMSYS_COUNT_ALGORITHM(FormatBasecase);
+                    return format_basecase(end, std::vector<_Ty>(x, x + xn), pad);
+                }
+                NUMSYS_COUNT_ALGORITHM(FormatDivideConquer);
+
+                // Наименьшая степень с 2m >= xn; при этом m < xn, так что частное не нулевое
+                size_t k = 0;
+                while (2 * DecimalPowers<_Ty>::level(k).power.size() < xn) ++k;
+                const DecimalPower<_Ty>& P = DecimalPowers<_Ty>::level(k);
+
+                std::vector<_Ty> q, r;
+                divrem_barrett(q, r, x, xn, P.power, DecimalPowers<_Ty>::inverse(k));
+
+                // Младшая половина всегда дополняется ровно до P.digits цифр, поэтому
+                // граница половин известна заранее и их можно форматировать параллельно
+                char* begin = nullptr;
+                parallel_invoke(xn,
+                    [&] { format_dc(end, r.data(), r.size(), P.digits); },
+                    [&] { begin = format_dc(end - P.digits, q.data(), q.size(), pad != 0 ? pad - P.digits : 0); });
+                return begin;
+            }
+
+            // Потоковый вывод: цифры уходят приёмнику от старших к младшим, а не в общий буфер.
+            // Делимое освобождается сразу после деления, поэтому в памяти живут только
+            // частные и остатки текущей ветви — не больше пары размеров исходного числа
+            template<typename _Ty>
+            void format_stream(LO::DigitWriter write, void* context, std::string& buffer, std::vector<_Ty> x, size_t pad) {
+                const size_t xn = LO::normalized_size(x.data(), x.size());
+                if (xn < ConversionThresholds::GET_STR_DC) {
+                    NUMSYS_COUNT_ALGORITHM(FormatBasecase);
+                    // Ведущие нули дополнения пишутся кусками: их может быть намного больше, чем цифр остатка
+                    char* end = buffer.data() + buffer.size();
+                    x.resize(xn);
+                    const char* begin = (xn == 0 && pad != 0) ? end : format_basecase(end, std::move(x), 0);
+                    static constexpr char ZEROS[64] = { '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0',
+                                                        '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0',
+                                                        '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0',
+                                                        '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0', '0' };
+                    const size_t length = static_cast<size_t>(end - begin);
+                    for (size_t zeros = pad > length ? pad - length : 0; zeros != 0;) {
+                        const size_t step = std::min(zeros, sizeof(ZEROS));
+                        write(context, ZEROS, step);
+                        zeros -= step;
+                    }
+                    if (length != 0) write(context, begin, length);
+                    return;
+                }
+                NUMSYS_COUNT_ALGORITHM(FormatDivideConquer);
+
+                size_t k = 0;
+                while (2 * DecimalPowers<_Ty>::level(k).power.size() < xn) ++k;
+                const DecimalPower<_Ty>& P = DecimalPowers<_Ty>::level(k);
+
+                std::vector<_Ty> q, r;
+                divrem_barrett(q, r, x.data(), xn, P.power, DecimalPowers<_Ty>::inverse(k));
+                std::vector<_Ty>().swap(x);
+                format_stream(write, context, buffer, std::move(q), pad != 0 ? pad - P.digits : 0);
+                format_stream(write, context, buffer, std::move(r), P.digits);
+            }
+
+            template<typename _Ty>
+            std::vector<_Ty> parse_basecase(const char* s, size_t len) {
+                constexpr unsigned DIGITS = LO::chunk_digits<_Ty>();
+                std::vector<_Ty> acc;
+                // Первый кусок короче, чтобы остальные были ровно по DIGITS цифр
+                size_t step = len % DIGITS == 0 ? DIGITS : len % DIGITS;
+                for (size_t pos = 0; pos < len; pos += step, step = DIGITS) {
+                    _Ty chunk = 0;
+                    _Ty radix = 1;
+                    for (size_t i = pos; i < pos + step; ++i) {
+                        chunk = static_cast<_Ty>(chunk * 10 + static_cast<_Ty>(s[i] - '0'));
+                        radix = static_cast<_Ty>(radix * 10);
+                    }
+                    _Ty carry = LO::mul_1(acc.data(), acc.data(), acc.size(), radix);
+                    carry = static_cast<_Ty>(carry + LO::add_1(acc.data(), acc.data(), acc.size(), chunk));
+                    if (carry != 0) acc.push_back(carry);
+                }
+                return acc;
+            }
+
+            template<typename _Ty>
+            std::vector<_Ty> parse_dc(const char* s, size_t len) {
+                if (len <= ConversionThresholds::SET_STR_DC * LO::chunk_digits<_Ty>()) {
+                    NUMSYS_COUNT_ALGORITHM(ParseBasecase);
+                    return parse_basecase<_Ty>(s, len);
+                }
+                NUMSYS_COUNT_ALGORITHM(ParseDivideConquer);
+
+                // Наибольшая степень, короче строки: младшая часть не меньше старшей
+                size_t k = 0;
+                while (DecimalPowers<_Ty>::level(k + 1).digits < len) ++k;
+                const DecimalPower<_Ty>& P = DecimalPowers<_Ty>::level(k);
+
+                std::vector<_Ty> high, low;
+                parallel_invoke(len / LO::chunk_digits<_Ty>(),
+                    [&] { high = parse_dc<_Ty>(s, len - P.digits); },
+                    [&] { low = parse_dc<_Ty>(s + len - P.digits, P.digits); });
+                if (high.empty()) return low;
+
+                // high * 10^digits + low
+                const std::vector<_Ty>& p = P.power;
+                std::vector<_Ty> result(high.size() + p.size());
+                if (high.size() >= p.size()) LO::mul(result.data(), high.data(), high.size(), p.data(), p.size());
+                else                         LO::mul(result.data(), p.data(), p.size(), high.data(), high.size());
+                if (!low.empty()) LO::add(result.data(), result.data(), result.size(), low.data(), low.size());
+                result.resize(LO::normalized_size(result.data(), result.size()));
+                return result;
+            }
+        }
+
+        template<typename _Ty>
+        void LimbOperations::mul(_Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn) {
+            if (bn < MultiplyThresholds::KARATSUBA) {
+                NUMSYS_COUNT_ALGORITHM(MulBasecase);
+                mul_basecase(r, a, an, b, bn);
+            }
+            else if (2 * bn <= an) {
+                NUMSYS_COUNT_ALGORITHM(MulUnbalanced);
+                mul_unbalanced(r, a, an, b, bn);
+            }
+            else if (bn >= MultiplyThresholds::FFT && ntt_pays_off<_Ty>(an, bn)) {
+                NUMSYS_COUNT_ALGORITHM(MulNtt);
+                mul_fft(r, a, an, b, bn);
+            }
+            else if (bn < MultiplyThresholds::TOOM3 || bn <= 2 * ((an + 2) / 3)) {
+                NUMSYS_COUNT_ALGORITHM(MulKaratsuba);
+                mul_karatsuba(r, a, an, b, bn);
+            }
+            else {
+                NUMSYS_COUNT_ALGORITHM(MulToom3);
+                mul_toom3(r, a, an, b, bn);
+            }
+        }
+
+        template<typename _Ty>
+        void LimbOperations::divrem(_Ty* q, _Ty* r, const _Ty* a, size_t an, const _Ty* b, size_t bn) {
+            if (bn == 1) {
+                NUMSYS_COUNT_ALGORITHM(DivSingleLimb);
+                r[0] = divrem_1(q, a, an, b[0]);
+                return;
+            }
+            NUMSYS_COUNT_ALGORITHM(DivKnuth);
+
+            // D1: нормализация — старший бит делителя должен быть установлен
+            const unsigned shift = count_leading_zeros(b[bn - 1]);
+
+            Scratch<_Ty> scratch(an + 1 + bn, current_resource());
+            _Ty* un = scratch.data();
+            _Ty* vn = un + an + 1;
+            if (shift != 0) {
+                lshift(vn, b, bn, shift);
+                un[an] = lshift(un, a, an, shift);
+            }
+            else {
+                std::copy(b, b + bn, vn);
+                std::copy(a, a + an, un);
+                un[an] = 0;
+            }
+
+            const _Ty v1 = vn[bn - 1];
+            const _Ty v2 = vn[bn - 2];
+            for (size_t j = an - bn + 1; j-- > 0;) {
+                // D3: оценка цифры частного по трём старшим словам остатка и двум — делителя
+                _Ty qhat = 0, rhat = 0;
+                bool rhat_overflow = false;
+                if (un[j + bn] >= v1) {
+                    qhat = std::numeric_limits<_Ty>::max();
+                    rhat = static_cast<_Ty>(un[j + bn - 1] + v1);
+                    rhat_overflow = rhat < v1;
+                }
+                else {
+                    qhat = OverflowAwareOps::divide(un[j + bn], un[j + bn - 1], v1, rhat);
+                }
+                while (!rhat_overflow) {
+                    _Ty high = 0;
+                    _Ty low = OverflowAwareOps::multiply(qhat, v2, high);
+                    if (high < rhat || (high == rhat && low <= un[j + bn - 2])) break;
+                    --qhat;
+                    rhat = static_cast<_Ty>(rhat + v1);
+                    rhat_overflow = rhat < v1;
+                }
+
+                // D4: вычитание qhat * v; D6: при отрицательном результате — обратное сложение
+                const _Ty borrow = submul_1(un + j, vn, bn, qhat);
+                const _Ty top = un[j + bn];
+                un[j + bn] = static_cast<_Ty>(top - borrow);
+                if (top < borrow) {
+                    --qhat;
+                    un[j + bn] = static_cast<_Ty>(un[j + bn] + add_n(un + j, un + j, vn, bn));
+                }
+                q[j] = qhat;
+            }
+
+            // D8: денормализация остатка
+            if (shift != 0) rshift(r, un, bn, shift);
+            else            std::copy(un, un + bn, r);
+        }
+
+        template<typename _Ty>
+        std::string LimbOperations::get_str(const _Ty* a, size_t n) {
+            n = normalized_size(a, n);
+            if (n == 0) return "0";
+
+            // Верхняя граница числа цифр: n * digits * log10(2) с запасом на округление
+            // и на старший кусок, который пишется целиком по chunk_digits цифр
+            const size_t bound = n * std::numeric_limits<_Ty>::digits * 30103ULL / 100000ULL + 2 + chunk_digits<_Ty>();
+            std::string buffer(bound, '0');
+            char* end = buffer.data() + buffer.size();
+            char* begin = format_dc(end, a, n, 0);
+            return std::string(begin, end);
+        }
+
+        template<typename _Ty>
+        void LimbOperations::get_str_to(const _Ty* a, size_t n, DigitWriter write, void* context) {
+            n = normalized_size(a, n);
+            if (n == 0) {
+                write(context, "0", 1);
+                return;
+            }
+            // Буфер листа: число короче GET_STR_DC слов без дополнения
+            std::string buffer(ConversionThresholds::GET_STR_DC * std::numeric_limits<_Ty>::digits * 30103ULL / 100000ULL + 2 + chunk_digits<_Ty>(), '0');
+            format_stream(write, context, buffer, std::vector<_Ty>(a, a + n), 0);
+        }
+
+        template<typename _Ty>
+        void LimbOperations::mul_pow10_add(std::vector<_Ty>& high, const std::vector<_Ty>& low, size_t digits) {
+            // Степень из кэша, если digits = chunk_digits * 2^k, иначе — по куску цифр на проход mul_1
+            size_t k = 0;
+            while (DecimalPowers<_Ty>::level(k).digits < digits) ++k;
+            std::vector<_Ty> own;
+            const std::vector<_Ty>* power = &DecimalPowers<_Ty>::level(k).power;
+            if (DecimalPowers<_Ty>::level(k).digits != digits) {
+                own.assign(1, _Ty(1));
+                for (size_t left = digits; left != 0;) {
+                    const size_t step = std::min<size_t>(left, chunk_digits<_Ty>());
+                    _Ty radix = 1;
+                    for (size_t i = 0; i < step; ++i) radix = static_cast<_Ty>(radix * 10);
+                    const _Ty carry = mul_1(own.data(), own.data(), own.size(), radix);
+                    if (carry != 0) own.push_back(carry);
+                    left -= step;
+                }
+                power = &own;
+            }
+
+            const size_t hn = normalized_size(high.data(), high.size());
+            const size_t ln = normalized_size(low.data(), low.size());
+            if (hn == 0) {
+                high.assign(low.begin(), low.begin() + static_cast<std::ptrdiff_t>(ln));
+                return;
+            }
+            // high * P + low < (high + 1) * P, поэтому результат помещается в hn + pn слов
+            const std::vector<_Ty>& p = *power;
+            std::vector<_Ty> result(hn + p.size());
+            if (hn >= p.size()) mul(result.data(), high.data(), hn, p.data(), p.size());
+            else                mul(result.data(), p.data(), p.size(), high.data(), hn);
+            if (ln != 0) add(result.data(), result.data(), result.size(), low.data(), ln);
+            result.resize(normalized_size(result.data(), result.size()));
+            high.swap(result);
+        }
+
+        template<typename _Ty>
+        std::vector<_Ty> LimbOperations::set_str(std::string_view digits) {
+            std::vector<_Ty> result = parse_dc<_Ty>(digits.data(), digits.size());
+            result.resize(normalized_size(result.data(), result.size()));
+            return result;
+        }
+
+        template<typename _Ty>
+        void LimbOperations::preload_powers(size_t digits) {
+            for (size_t k = 0; DecimalPowers<_Ty>::level(k).digits < digits; ++k) (void)DecimalPowers<_Ty>::inverse(k);
+        }
+
+        template void LimbOperations::mul<uint8_t>(uint8_t*, const uint8_t*, size_t, const uint8_t*, size_t);
+        template void LimbOperations::mul<uint16_t>(uint16_t*, const uint16_t*, size_t, const uint16_t*, size_t);
+        template void LimbOperations::mul<uint32_t>(uint32_t*, const uint32_t*, size_t, const uint32_t*, size_t);
+        template void LimbOperations::mul<uint64_t>(uint64_t*, const uint64_t*, size_t, const uint64_t*, size_t);
+
+        template void LimbOperations::divrem<uint8_t>(uint8_t*, uint8_t*, const uint8_t*, size_t, const uint8_t*, size_t);
+        template void LimbOperations::divrem<uint16_t>(uint16_t*, uint16_t*, const uint16_t*, size_t, const uint16_t*, size_t);
+        template void LimbOperations::divrem<uint32_t>(uint32_t*, uint32_t*, const uint32_t*, size_t, const uint32_t*, size_t);
+        template void LimbOperations::divrem<uint64_t>(uint64_t*, uint64_t*, const uint64_t*, size_t, const uint64_t*, size_t);
+
+        template std::string LimbOperations::get_str<uint8_t>(const uint8_t*, size_t);
+        template std::string LimbOperations::get_str<uint16_t>(const uint16_t*, size_t);
+        template std::string LimbOperations::get_str<uint32_t>(const uint32_t*, size_t);
+        template std::string LimbOperations::get_str<uint64_t>(const uint64_t*, size_t);
+
+        template std::vector<uint8_t> LimbOperations::set_str<uint8_t>(std::string_view);
+        template std::vector<uint16_t> LimbOperations::set_str<uint16_t>(std::string_view);
+        template std::vector<uint32_t> LimbOperations::set_str<uint32_t>(std::string_view);
+        template std::vector<uint64_t> LimbOperations::set_str<uint64_t>(std::string_view);
+
+        template void LimbOperations::get_str_to<uint8_t>(const uint8_t*, size_t, DigitWriter, void*);
+        template void LimbOperations::get_str_to<uint16_t>(const uint16_t*, size_t, DigitWriter, void*);
+        template void LimbOperations::get_str_to<uint32_t>(const uint32_t*, size_t, DigitWriter, void*);
+        template void LimbOperations::get_str_to<uint64_t>(const uint64_t*, size_t, DigitWriter, void*);
+
+        template void LimbOperations::mul_pow10_add<uint8_t>(std::vector<uint8_t>&, const std::vector<uint8_t>&, size_t);
+        template void LimbOperations::mul_pow10_add<uint16_t>(std::vector<uint16_t>&, const std::vector<uint16_t>&, size_t);
+        template void LimbOperations::mul_pow10_add<uint32_t>(std::vector<uint32_t>&, const std::vector<uint32_t>&, size_t);
+        template void LimbOperations::mul_pow10_add<uint64_t>(std::vector<uint64_t>&, const std::vector<uint64_t>&, size_t);
+
+        template void LimbOperations::preload_powers<uint8_t>(size_t);
+        template void LimbOperations::preload_powers<uint16_t>(size_t);
+        template void LimbOperations::preload_powers<uint32_t>(size_t);
+        template void LimbOperations::preload_powers<uint64_t>(size_t);
+    }
+}
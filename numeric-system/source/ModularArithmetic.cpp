@@ -0,0 +1,194 @@
+﻿#include "ModularArithmetic.h"
+#include "LimbOperations.h"
+
+namespace numsystem {
+    namespace {
+        using LO = impl::LimbOperations;
+
+        // Рабочие буферы берут память из ресурса текущего потока
+        template<typename _Ty>
+        using Scratch = std::pmr::vector<_Ty>;
+
+        // Ширина окна по длине показателя: минимум умножений на предвычисление и проход
+        constexpr unsigned window_bits(size_t exponent_bits) noexcept {
+            return exponent_bits > 671 ? 6 : exponent_bits > 239 ? 5 : exponent_bits > 79 ? 4 : exponent_bits > 23 ? 3 : exponent_bits > 6 ? 2 : 1;
+        }
+    }
+
+    template<typename Limb>
+    BasicModContext<Limb>::BasicModContext(const number_type& modulus) : _modulus(modulus) {
+        if (modulus.sign() || modulus.is_zero()) {
+            throw std::domain_error("Modulus must be positive");
+        }
+        const auto& data = modulus._storage.data();
+        _m.assign(data.begin(), data.begin() + LO::normalized_size(data.data(), data.size()));
+        const size_t n = _m.size();
+        _montgomery = (_m[0] & 1) != 0;
+        _one.assign(n, 0);
+        _r2.assign(n, 0);
+
+        if (_montgomery) {
+            _minv = static_cast<value_type>(value_type(0) - LO::binvert_limb(_m[0]));
+            // R mod m и R^2 mod m — остатки от деления B^n и B^2n
+            Scratch<value_type> power(2 * n + 1, 0, impl::current_resource());
+            Scratch<value_type> quotient(n + 2, 0, impl::current_resource());
+            power[2 * n] = 1;
+            LO::divrem(quotient.data(), _r2.data(), power.data(), 2 * n + 1, _m.data(), n);
+            std::fill(power.begin(), power.end(), value_type(0));
+            power[n] = 1;
+            LO::divrem(quotient.data(), _one.data(), power.data(), n + 1, _m.data(), n);
+        }
+        else {
+            // Чётный модуль не меньше 2, единица уже приведена
+            _one[0] = 1;
+        }
+    }
+
+    template<typename Limb>
+    void BasicModContext<Limb>::divide_out(value_type* r, value_type* t, size_t tn, value_type* q) const {
+        const size_t n = _m.size();
+        tn = LO::normalized_size(t, tn);
+        if (tn < n || (tn == n && LO::cmp_n(t, _m.data(), n) < 0)) {
+            std::copy(t, t + tn, r);
+            std::fill(r + tn, r + n, value_type(0));
+        }
+        else {
+            LO::divrem(q, r, t, tn, _m.data(), n);
+        }
+    }
+    template<typename Limb>
+    void BasicModContext<Limb>::residue(const number_type& a, value_type* r) const {
+        const size_t n = _m.size();
+        const auto& data = a._storage.data();
+        const size_t an = LO::normalized_size(data.data(), data.size());
+        if (an <= 2 * n) {
+            Scratch<value_type> t(data.begin(), data.begin() + an, impl::current_resource());
+            Scratch<value_type> q(n + 1, 0, impl::current_resource());
+            divide_out(r, t.data(), an, q.data());
+        }
+        else {
+            Scratch<value_type> q(an - n + 1, 0, impl::current_resource());
+            LO::divrem(q.data(), r, data.data(), an, _m.data(), n);
+        }
+        // Отрицательное a: m - (|a| mod m)
+        if (a.sign() && LO::normalized_size(r, n) != 0) {
+            LO::sub_n(r, _m.data(), r, n);
+        }
+    }
+    template<typename Limb>
+    void BasicModContext<Limb>::mul(value_type* r, const value_type* a, const value_type* b, value_type* t, value_type* q) const {
+        const size_t n = _m.size();
+        LO::mul(t, a, n, b, n);
+        if (_montgomery) LO::redc(r, t, _m.data(), n, _minv);
+        else divide_out(r, t, 2 * n, q);
+    }
+    template<typename Limb>
+    typename BasicModContext<Limb>::number_type BasicModContext<Limb>::make(const value_type* r) const {
+        number_type result;
+        result._storage.data().assign(r, r + _m.size());
+        result.trim_leading_zeros();
+        return result;
+    }
+
+    template<typename Limb>
+    typename BasicModContext<Limb>::number_type BasicModContext<Limb>::reduce(const number_type& a) const {
+        Scratch<value_type> r(_m.size(), 0, impl::current_resource());
+        residue(a, r.data());
+        return make(r.data());
+    }
+    template<typename Limb>
+    typename BasicModContext<Limb>::number_type BasicModContext<Limb>::mulmod(const number_type& a, const number_type& b) const {
+        const size_t n = _m.size();
+        Scratch<value_type> x(n, 0, impl::current_resource());
+        Scratch<value_type> y(n, 0, impl::current_resource());
+        Scratch<value_type> t(2 * n, 0, impl::current_resource());
+        Scratch<value_type> q(n + 1, 0, impl::current_resource());
+        residue(a, x.data());
+        residue(b, y.data());
+        // (a * R) * b * R^-1 == a * b: одного перевода в представление Монтгомери достаточно
+        if (_montgomery) mul(x.data(), x.data(), _r2.data(), t.data(), q.data());
+        mul(x.data(), x.data(), y.data(), t.data(), q.data());
+        return make(x.data());
+    }
+    template<typename Limb>
+    typename BasicModContext<Limb>::number_type BasicModContext<Limb>::powmod(const number_type& base, const number_type& exponent) const {
+        if (exponent.sign()) return powmod(modinv(base), -exponent);
+
+        const size_t n = _m.size();
+        const size_t bits = exponent.bit_length();
+        const unsigned window = window_bits(bits);
+        Scratch<value_type> t(2 * n, 0, impl::current_resource());
+        Scratch<value_type> q(n + 1, 0, impl::current_resource());
+        Scratch<value_type> acc(_one.begin(), _one.end(), impl::current_resource());
+
+        // Нечётные степени g, g^3, ..., g^(2^window - 1) в рабочем представлении
+        const size_t entries = size_t(1) << (window - 1);
+        Scratch<value_type> table(n * entries, 0, impl::current_resource());
+        residue(base, table.data());
+        if (_montgomery) mul(table.data(), table.data(), _r2.data(), t.data(), q.data());
+        if (entries > 1) {
+            Scratch<value_type> square(n, 0, impl::current_resource());
+            mul(square.data(), table.data(), table.data(), t.data(), q.data());
+            for (size_t i = 1; i < entries; ++i) {
+                mul(table.data() + i * n, table.data() + (i - 1) * n, square.data(), t.data(), q.data());
+            }
+        }
+
+        // Скользящее окно от старших бит: нули — одно возведение в квадрат,
+        // единица начинает окно до window бит, которое кончается единичным битом
+        bool started = false;
+        for (size_t i = bits; i-- > 0;) {
+            if (!exponent.test_bit(i)) {
+                if (started) mul(acc.data(), acc.data(), acc.data(), t.data(), q.data());
+                continue;
+            }
+            size_t low = (i + 1 >= window) ? i + 1 - window : 0;
+            while (!exponent.test_bit(low)) ++low;
+            size_t digit = 0;
+            for (size_t j = i + 1; j-- > low;) digit = (digit << 1) | (exponent.test_bit(j) ? 1 : 0);
+
+            const value_type* power = table.data() + (digit >> 1) * n;
+            if (started) {
+                for (size_t j = low; j <= i; ++j) mul(acc.data(), acc.data(), acc.data(), t.data(), q.data());
+                mul(acc.data(), acc.data(), power, t.data(), q.data());
+            }
+            else {
+                std::copy(power, power + n, acc.begin());
+                started = true;
+            }
+            i = low;
+        }
+
+        // Из представления Монтгомери: redc(acc)
+        if (_montgomery) {
+            std::copy(acc.begin(), acc.end(), t.begin());
+            std::fill(t.begin() + n, t.end(), value_type(0));
+            LO::redc(acc.data(), t.data(), _m.data(), n, _minv);
+        }
+        return make(acc.data());
+    }
+    template<typename Limb>
+    typename BasicModContext<Limb>::number_type BasicModContext<Limb>::modinv(const number_type& a) const {
+        // Расширенный алгоритм Евклида: t_i * a == r_i (mod m)
+        number_type r0 = _modulus;
+        number_type r1 = reduce(a);
+        number_type t0(0), t1(1);
+        while (!r1.is_zero()) {
+            auto [quotient, remainder] = r0.divmod(r1);
+            r0 = std::move(r1);
+            r1 = std::move(remainder);
+            quotient.multiply_assign(t1);
+            t0.subtract_assign(quotient);
+            std::swap(t0, t1);
+        }
+        if (r0 != number_type(1)) {
+            throw std::domain_error("Value is not invertible modulo m");
+        }
+        return reduce(t0);
+    }
+
+    template class BasicModContext<uint8_t>;
+    template class BasicModContext<uint16_t>;
+    template class BasicModContext<uint32_t>;
+    template class BasicModContext<uint64_t>;
+}
@@ -0,0 +1,108 @@
+﻿#include "Parallel.h"
+#include <algorithm>
+
+namespace numsystem {
+    namespace {
+        // Пул и номер очереди рабочего потока; у внешних потоков owner == nullptr
+        struct WorkerIdentity {
+            const ThreadPool* owner = nullptr;
+            size_t index = 0;
+        };
+        thread_local WorkerIdentity worker;
+    }
+
+    ThreadPool::ThreadPool(size_t threads, size_t threshold) : _queues(std::max<size_t>(threads, 1) + 1), _threshold(threshold) {
+        const size_t count = std::max<size_t>(threads, 1);
+        _workers.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            _workers.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(_sleep_mutex);
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (std::thread& thread : _workers) thread.join();
+    }
+
+    void ThreadPool::push(impl::ParallelTask* task) {
+        Queue& queue = (worker.owner == this) ? _queues[worker.index] : _queues.back();
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(task);
+        }
+        _pending.fetch_add(1, std::memory_order_release);
+        // Пустой захват мьютекса сна: рабочий либо ещё не проверил _pending, либо уже ждёт уведомления
+        { std::lock_guard<std::mutex> lock(_sleep_mutex); }
+        _wake.notify_one();
+    }
+
+    impl::ParallelTask* ThreadPool::find_task() {
+        const auto take = [this](Queue& queue, bool back) -> impl::ParallelTask* {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) return nullptr;
+            impl::ParallelTask* task = back ? queue.tasks.back() : queue.tasks.front();
+            if (back) queue.tasks.pop_back();
+            else      queue.tasks.pop_front();
+            _pending.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        };
+
+        const bool own = worker.owner == this;
+        if (own) {
+            if (impl::ParallelTask* task = take(_queues[worker.index], true)) return task;
+        }
+        if (impl::ParallelTask* task = take(_queues.back(), false)) return task;
+        // Перехват начинаем с соседа, чтобы потоки не толпились у первой очереди
+        // (число очередей задано до запуска потоков, в отличие от _workers)
+        const size_t workers = _queues.size() - 1;
+        const size_t first = own ? worker.index + 1 : 0;
+        for (size_t i = 0; i < workers; ++i) {
+            const size_t victim = (first + i) % workers;
+            if (own && victim == worker.index) continue;
+            if (impl::ParallelTask* task = take(_queues[victim], false)) return task;
+        }
+        return nullptr;
+    }
+
+    void ThreadPool::join(impl::ParallelTask* task) {
+        // Если задачу ещё никто не забрал, она выполняется здесь же
+        Queue& queue = (worker.owner == this) ? _queues[worker.index] : _queues.back();
+        bool reclaimed = false;
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            const auto it = std::find(queue.tasks.rbegin(), queue.tasks.rend(), task);
+            if (it != queue.tasks.rend()) {
+                queue.tasks.erase(std::next(it).base());
+                _pending.fetch_sub(1, std::memory_order_relaxed);
+                reclaimed = true;
+            }
+        }
+        if (reclaimed) {
+            task->run();
+            return;
+        }
+        // Задачу перехватили: пока она выполняется, помогаем с остальными
+        while (!task->done.load(std::memory_order_acquire)) {
+            if (impl::ParallelTask* other = find_task()) other->run();
+            else std::this_thread::yield();
+        }
+    }
+
+    void ThreadPool::work(size_t index) {
+        worker = { this, index };
+        impl::current_pool_slot() = this;
+        for (;;) {
+            if (impl::ParallelTask* task = find_task()) {
+                task->run();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(_sleep_mutex);
+            _wake.wait(lock, [this] { return _stop || _pending.load(std::memory_order_acquire) > 0; });
+            if (_stop && _pending.load(std::memory_order_acquire) == 0) return;
+        }
+    }
+}
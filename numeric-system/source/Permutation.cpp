@@ -0,0 +1,128 @@
+#include "Permutation.h"
+#include <algorithm>
+
+namespace numsystem {
+    namespace impl {
+        // Прямой доступ к упакованным коэффициентам номера перестановки
+        struct PermutationAccess {
+            static Storage<uint64_t>& storage(FactorialArithmetic& value) noexcept { return value._storage; }
+            static const Storage<uint64_t>& storage(const FactorialArithmetic& value) noexcept { return value._storage; }
+        };
+    }
+
+    namespace {
+        using Access = impl::PermutationAccess;
+
+        // Дерево Фенвика над множеством ещё не использованных элементов 0..n-1 (изначально все)
+        class RemainingSet {
+        public:
+            // Для множества из одних единиц узел i хранит длину своего отрезка — младший бит i
+            explicit RemainingSet(size_t n) : _tree(n + 1) {
+                for (size_t i = 1; i <= n; ++i) _tree[i] = i & (~i + 1);
+                _top = 1;
+                while (_top * 2 <= n) _top *= 2;
+            }
+
+            // Сколько оставшихся элементов меньше x
+            [[nodiscard]] size_t count_less(size_t x) const noexcept {
+                size_t count = 0;
+                for (size_t i = x; i > 0; i &= i - 1) count += _tree[i];
+                return count;
+            }
+            [[nodiscard]] bool contains(size_t x) const noexcept { return count_less(x + 1) != count_less(x); }
+
+            void erase(size_t x) noexcept {
+                for (size_t i = x + 1; i < _tree.size(); i += i & (~i + 1)) --_tree[i];
+            }
+
+            // k-й по возрастанию (с нуля) из оставшихся: спуск по степеням двойки
+            [[nodiscard]] size_t select(size_t k) const noexcept {
+                size_t pos = 0;
+                for (size_t step = _top; step != 0; step /= 2) {
+                    if (pos + step < _tree.size() && _tree[pos + step] <= k) {
+                        pos += step;
+                        k -= _tree[pos];
+                    }
+                }
+                return pos;
+            }
+        private:
+            std::vector<size_t> _tree;
+            size_t _top = 0;
+        };
+
+        // Номер должен быть неотрицательным и меньше n!: коэффициенты с индексом >= n равны нулю
+        void check_rank(const FactorialArithmetic& rank, size_t n) {
+            const impl::Storage<uint64_t>& data = Access::storage(rank);
+            bool in_range = !rank.sign() || !rank;
+            for (internal::FactorCursor cursor(data, n); in_range && cursor.valid(); ++cursor) {
+                in_range = *cursor == 0;
+            }
+            if (!in_range) throw std::out_of_range("unrank_permutation: rank must be in [0, n!)");
+        }
+    }
+
+    FactorialArithmetic rank_permutation(const size_t* permutation, size_t n) {
+        // Код Лемера: коэффициент при (n-1-i)! — сколько элементов правее позиции i меньше permutation[i]
+        std::vector<uint64_t> coefficients(n);
+        RemainingSet remaining(n);
+        for (size_t i = 0; i < n; ++i) {
+            const size_t x = permutation[i];
+            if (x >= n || !remaining.contains(x)) {
+                throw std::invalid_argument("rank_permutation: input is not a permutation of 0..n-1");
+            }
+            coefficients[n - 1 - i] = remaining.count_less(x);
+            remaining.erase(x);
+        }
+        // Упаковка в хранилище за один проход
+        return FactorialArithmetic::from_coefficients(coefficients);
+    }
+
+    void unrank_permutation(const FactorialArithmetic& rank, size_t* permutation, size_t n) {
+        check_rank(rank, n);
+        if (n == 0) return;
+
+        // Коэффициенты от старшего (n-1)! к младшему выбирают элементы слева направо
+        RemainingSet remaining(n);
+        internal::FactorCursor cursor(Access::storage(rank), n - 1);
+        for (size_t i = 0; i < n; ++i, --cursor) {
+            const size_t x = remaining.select(static_cast<size_t>(*cursor));
+            permutation[i] = x;
+            remaining.erase(x);
+            if (i + 1 == n) break;  // курсор не уходит ниже индекса 0
+        }
+    }
+
+    PermutationEnumerator::PermutationEnumerator(size_t n) : _permutation(n), _rank(0) {
+        for (size_t i = 0; i < n; ++i) _permutation[i] = i;
+    }
+    PermutationEnumerator::PermutationEnumerator(size_t n, const FactorialArithmetic& start)
+        : _permutation(unrank_permutation(start, n)), _rank(start) {}
+
+    bool PermutationEnumerator::next() {
+        const size_t n = _permutation.size();
+        impl::Storage<uint64_t>& data = Access::storage(_rank);
+
+        // Перенос проходит через младшие коэффициенты, равные своему индексу: d_k == k
+        internal::FactorCursor cursor(data, 1);
+        while (cursor.index() < n && *cursor == cursor.index()) ++cursor;
+        const size_t carry = static_cast<size_t>(cursor.index());
+        if (carry >= n) return false;  // все коэффициенты на максимуме — последняя перестановка
+
+        // +1 на месте: d_1..d_{carry-1} обнуляются, d_carry увеличивается
+        const uint64_t digit = *cursor;
+        internal::FactorWriter writer(data, 1);
+        for (size_t k = 1; k < carry; ++k) writer.push(0);
+        writer.push(digit + 1);
+
+        // Хвост после позиции pivot убывает (его коэффициенты были максимальны):
+        // на pivot встаёт наименьший больший элемент хвоста, хвост разворачивается
+        const size_t pivot = n - 1 - carry;
+        auto tail = _permutation.begin() + static_cast<std::ptrdiff_t>(pivot) + 1;
+        auto successor = std::find_if(_permutation.rbegin(), std::make_reverse_iterator(tail),
+            [&](size_t x) { return x > _permutation[pivot]; });
+        std::iter_swap(_permutation.begin() + static_cast<std::ptrdiff_t>(pivot), successor);
+        std::reverse(tail, _permutation.end());
+        return true;
+    }
+}
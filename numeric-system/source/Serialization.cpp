@@ -0,0 +1,272 @@
+#include "Serialization.h"
+#include "LimbOperations.h"
+#include <cstring>
+
+namespace numsystem {
+    namespace impl {
+        // Прямой доступ к хранилищу и внутренним операциям чисел для формата и представления
+        struct SerializationAccess {
+            static Storage<uint64_t>& storage(BinaryArithmetic& value) noexcept { return value._storage; }
+            static const Storage<uint64_t>& storage(const BinaryArithmetic& value) noexcept { return value._storage; }
+            static Storage<uint64_t>& storage(FactorialArithmetic& value) noexcept { return value._storage; }
+            static const Storage<uint64_t>& storage(const FactorialArithmetic& value) noexcept { return value._storage; }
+            static void trim(BinaryArithmetic& value) noexcept { value.trim_leading_zeros(); }
+            static void trim(FactorialArithmetic& value) noexcept { value.trim_leading_zeros(); }
+            static void add_limbs(BinaryArithmetic& value, const uint64_t* rhs, size_t rhs_size, bool rhs_sign) {
+                value.add_limbs(rhs, rhs_size, rhs_sign);
+            }
+        };
+    }
+
+    namespace {
+        using LO = impl::LimbOperations;
+        using Access = impl::SerializationAccess;
+        using Limb = BinaryArithmeticView::limb_type;
+
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        constexpr bool LITTLE_ENDIAN_HOST = true;
+#else
+        constexpr bool LITTLE_ENDIAN_HOST = false;
+#endif
+
+        constexpr size_t HEADER_SIZE = 16;
+        constexpr size_t WORD_SIZE = sizeof(uint64_t);
+        constexpr uint64_t SIGN_BIT = 1ULL << 63;
+        enum class Kind : uint8_t { Binary = 1, Factorial = 2 };
+
+        struct Header {
+            Kind kind;
+            size_t count;       // число слов
+            uint64_t state;     // слово StateInfo
+        };
+
+        void store_le(std::byte* out, uint64_t value, size_t bytes) noexcept {
+            for (size_t i = 0; i < bytes; ++i) out[i] = static_cast<std::byte>(value >> (8 * i));
+        }
+        uint64_t load_le(const std::byte* in, size_t bytes) noexcept {
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(in[i]) << (8 * i);
+            return value;
+        }
+
+        // На little-endian платформах слова копируются одним memcpy
+        void store_words(std::byte* out, const uint64_t* words, size_t count) noexcept {
+            if constexpr (LITTLE_ENDIAN_HOST) {
+                if (count != 0) std::memcpy(out, words, count * WORD_SIZE);
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) store_le(out + i * WORD_SIZE, words[i], WORD_SIZE);
+            }
+        }
+        void load_words(uint64_t* words, const std::byte* in, size_t count) noexcept {
+            if constexpr (LITTLE_ENDIAN_HOST) {
+                if (count != 0) std::memcpy(words, in, count * WORD_SIZE);
+            }
+            else {
+                for (size_t i = 0; i < count; ++i) words[i] = load_le(in + i * WORD_SIZE, WORD_SIZE);
+            }
+        }
+
+        size_t write_record(Kind kind, const uint64_t* words, size_t count, uint64_t state, std::byte* buffer, size_t size) {
+            if (count > std::numeric_limits<uint32_t>::max()) throw std::length_error("Number is too large to serialize");
+            const size_t total = HEADER_SIZE + count * WORD_SIZE;
+            if (size < total) throw std::length_error("Buffer is too small for the serialized number");
+            buffer[0] = std::byte{ 'N' };
+            buffer[1] = std::byte{ 'S' };
+            buffer[2] = std::byte{ SERIALIZATION_VERSION };
+            buffer[3] = static_cast<std::byte>(kind);
+            store_le(buffer + 4, count, 4);
+            store_le(buffer + 8, state, 8);
+            store_words(buffer + HEADER_SIZE, words, count);
+            return total;
+        }
+
+        Header read_header(const std::byte* buffer, size_t size, Kind expected) {
+            if (buffer == nullptr || size < HEADER_SIZE) throw std::invalid_argument("Serialized number is truncated");
+            if (buffer[0] != std::byte{ 'N' } || buffer[1] != std::byte{ 'S' }) throw std::invalid_argument("Not a serialized number");
+            if (buffer[2] != std::byte{ SERIALIZATION_VERSION }) throw std::invalid_argument("Unsupported serialization version");
+            if (buffer[3] != static_cast<std::byte>(expected)) throw std::invalid_argument("Serialized number has a different type");
+            Header header{ expected, static_cast<size_t>(load_le(buffer + 4, 4)), load_le(buffer + 8, 8) };
+            if ((size - HEADER_SIZE) / WORD_SIZE < header.count) throw std::invalid_argument("Serialized number is truncated");
+            return header;
+        }
+
+        // Двоичная запись: слова без ведущих нулей, у нуля нет знака, вспомогательное значение равно 0
+        Header read_binary_header(const std::byte* buffer, size_t size) {
+            const Header header = read_header(buffer, size, Kind::Binary);
+            const bool normalized = header.count == 0
+                ? header.state == 0
+                : load_le(buffer + HEADER_SIZE + (header.count - 1) * WORD_SIZE, WORD_SIZE) != 0;
+            if (!normalized || (header.state & ~SIGN_BIT) != 0) throw std::invalid_argument("Serialized binary number is not normalized");
+            return header;
+        }
+
+        BinaryArithmetic from_limbs(const Limb* limbs, size_t size, bool negative) {
+            BinaryArithmetic result;
+            auto& data = Access::storage(result).data();
+            data.assign(limbs, limbs + size);
+            if (data.empty()) data.push_back(0);
+            result.sign(negative && size != 0);
+            return result;
+        }
+    }
+
+    size_t serialized_size(const BinaryArithmetic& value) noexcept {
+        const auto& storage = Access::storage(value);
+        return HEADER_SIZE + LO::normalized_size(storage.data().data(), storage.size()) * WORD_SIZE;
+    }
+    size_t serialized_size(const FactorialArithmetic& value) noexcept {
+        return HEADER_SIZE + (value ? Access::storage(value).size() : 0) * WORD_SIZE;
+    }
+
+    size_t serialize_to(const BinaryArithmetic& value, std::byte* buffer, size_t size) {
+        const auto& storage = Access::storage(value);
+        const size_t count = LO::normalized_size(storage.data().data(), storage.size());
+        const uint64_t state = (count != 0 && storage.sign()) ? SIGN_BIT : 0;
+        return write_record(Kind::Binary, storage.data().data(), count, state, buffer, size);
+    }
+    size_t serialize_to(const FactorialArithmetic& value, std::byte* buffer, size_t size) {
+        const auto& storage = Access::storage(value);
+        if (!value) return write_record(Kind::Factorial, nullptr, 0, 0, buffer, size);
+        const uint64_t state = (storage.sign() ? SIGN_BIT : 0) | storage.value();
+        return write_record(Kind::Factorial, storage.data().data(), storage.size(), state, buffer, size);
+    }
+
+    size_t deserialize(const std::byte* buffer, size_t size, BinaryArithmetic& value) {
+        const Header header = read_binary_header(buffer, size);
+        BinaryArithmetic result;
+        auto& data = Access::storage(result).data();
+        if (header.count != 0) {
+            data.resize(header.count);
+            load_words(data.data(), buffer + HEADER_SIZE, header.count);
+            result.sign((header.state & SIGN_BIT) != 0);
+        }
+        value = std::move(result);
+        return HEADER_SIZE + header.count * WORD_SIZE;
+    }
+
+    size_t deserialize(const std::byte* buffer, size_t size, FactorialArithmetic& value) {
+        const Header header = read_header(buffer, size, Kind::Factorial);
+        FactorialArithmetic result;
+        auto& storage = Access::storage(result);
+        if (header.count == 0) {
+            if (header.state != 0) throw std::invalid_argument("Serialized factorial number is not normalized");
+        }
+        else {
+            storage.data().resize(header.count);
+            load_words(storage.data().data(), buffer + HEADER_SIZE, header.count);
+            // Нормализация не должна ничего менять: та же длина и тот же старший индекс
+            Access::trim(result);
+            const uint64_t top = header.state & ~SIGN_BIT;
+            if (storage.size() != header.count || storage.value() != top || !result) {
+                throw std::invalid_argument("Serialized factorial number is not normalized");
+            }
+            for (internal::FactorCursor<uint64_t> cursor(storage); cursor.index() <= top; ++cursor) {
+                if (*cursor > cursor.index()) throw std::invalid_argument("Serialized factorial coefficient exceeds its index");
+            }
+            result.sign((header.state & SIGN_BIT) != 0);
+        }
+        value = std::move(result);
+        return HEADER_SIZE + header.count * WORD_SIZE;
+    }
+
+    BinaryArithmeticView::BinaryArithmeticView(const limb_type* limbs, size_t size, bool negative) noexcept
+        : _limbs(limbs), _size(LO::normalized_size(limbs, size)), _negative(negative && _size != 0) {}
+
+    BinaryArithmeticView::BinaryArithmeticView(const BinaryArithmetic& value) noexcept
+        : BinaryArithmeticView(Access::storage(value).data().data(), Access::storage(value).size(), value.sign()) {}
+
+    BinaryArithmeticView BinaryArithmeticView::from_bytes(const std::byte* buffer, size_t size, size_t* consumed) {
+        if constexpr (!LITTLE_ENDIAN_HOST) {
+            throw std::invalid_argument("Serialized numbers can be viewed in place only on little-endian targets");
+        }
+        const Header header = read_binary_header(buffer, size);
+        const std::byte* words = buffer + HEADER_SIZE;
+        if (reinterpret_cast<uintptr_t>(words) % alignof(limb_type) != 0) {
+            throw std::invalid_argument("Serialized number is not aligned for an in-place view");
+        }
+        if (consumed != nullptr) *consumed = HEADER_SIZE + header.count * WORD_SIZE;
+        return BinaryArithmeticView(reinterpret_cast<const limb_type*>(words), header.count, (header.state & SIGN_BIT) != 0);
+    }
+
+    size_t BinaryArithmeticView::bit_length() const noexcept {
+        if (_size == 0) return 0;
+        return (_size - 1) * std::numeric_limits<limb_type>::digits + LO::bit_width(_limbs[_size - 1]);
+    }
+
+    int BinaryArithmeticView::compare(const BinaryArithmeticView& other) const noexcept {
+        if (_negative != other._negative) return _negative ? -1 : 1;
+        int order = (_size != other._size) ? (_size < other._size ? -1 : 1) : LO::cmp_n(_limbs, other._limbs, _size);
+        // У отрицательных больший модуль — меньшее число
+        return _negative ? -order : order;
+    }
+
+    uint64_t BinaryArithmeticView::mod_small(uint64_t divisor) const {
+        if (divisor == 0) throw std::overflow_error("Division by zero");
+        return _size != 0 ? LO::mod_1(_limbs, _size, divisor) : 0;
+    }
+
+    BinaryArithmeticView::operator BinaryArithmetic() const {
+        return from_limbs(_limbs, _size, _negative);
+    }
+
+    BinaryArithmetic operator+(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs) {
+        BinaryArithmetic result = from_limbs(lhs._limbs, lhs._size, lhs._negative);
+        Access::add_limbs(result, rhs._limbs, rhs._size, rhs._negative);
+        return result;
+    }
+    BinaryArithmetic operator-(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs) {
+        BinaryArithmetic result = from_limbs(lhs._limbs, lhs._size, lhs._negative);
+        Access::add_limbs(result, rhs._limbs, rhs._size, !rhs._negative);
+        return result;
+    }
+    BinaryArithmetic operator*(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs) {
+        if (lhs._size == 0 || rhs._size == 0) return BinaryArithmetic(0);
+        // Больший операнд идёт первым, как того требует LO::mul
+        const BinaryArithmeticView& longer = lhs._size >= rhs._size ? lhs : rhs;
+        const BinaryArithmeticView& shorter = lhs._size >= rhs._size ? rhs : lhs;
+
+        BinaryArithmetic result;
+        auto& data = Access::storage(result).data();
+        data.resize(longer._size + shorter._size, 0);
+        LO::mul(data.data(), longer._limbs, longer._size, shorter._limbs, shorter._size);
+        result.sign(lhs._negative != rhs._negative);
+        Access::trim(result);
+        return result;
+    }
+
+    std::pair<BinaryArithmetic, BinaryArithmetic> divmod(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs) {
+        if (rhs._size == 0) throw std::overflow_error("Division by zero");
+        // |lhs| < |rhs|: частное 0, остаток — само делимое
+        if (lhs._size < rhs._size || (lhs._size == rhs._size && LO::cmp_n(lhs._limbs, rhs._limbs, lhs._size) < 0)) {
+            return { BinaryArithmetic(0), static_cast<BinaryArithmetic>(lhs) };
+        }
+
+        BinaryArithmetic quotient;
+        BinaryArithmetic remainder;
+        Access::storage(quotient).data().resize(lhs._size - rhs._size + 1, 0);
+        Access::storage(remainder).data().resize(rhs._size, 0);
+        LO::divrem(Access::storage(quotient).data().data(), Access::storage(remainder).data().data(),
+            lhs._limbs, lhs._size, rhs._limbs, rhs._size);
+
+        // Деление с усечением к нулю: остаток всегда имеет знак lhs
+        quotient.sign(lhs._negative != rhs._negative);
+        remainder.sign(lhs._negative);
+        Access::trim(quotient);
+        Access::trim(remainder);
+        return { quotient, remainder };
+    }
+    BinaryArithmetic operator/(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs) {
+        return divmod(lhs, rhs).first;
+    }
+    BinaryArithmetic operator%(const BinaryArithmeticView& lhs, const BinaryArithmeticView& rhs) {
+        return divmod(lhs, rhs).second;
+    }
+
+    std::string to_string(const BinaryArithmeticView& value) {
+        if (value._size == 0) return "0";
+        std::string digits = value._size == 1 ? std::to_string(value._limbs[0]) : LO::get_str(value._limbs, value._size);
+        if (value._negative) digits.insert(digits.begin(), '-');
+        return digits;
+    }
+}
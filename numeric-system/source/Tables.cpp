@@ -0,0 +1,73 @@
+#include "Tables.h"
+
+namespace numsystem {
+    namespace {
+        using LO = impl::LimbOperations;
+        using Limbs = std::vector<uint64_t>;
+
+        constexpr uint64_t WORD_MAX = std::numeric_limits<uint64_t>::max();
+
+        Limbs multiply(ConstSpan<uint64_t> a, ConstSpan<uint64_t> b) {
+            if (a.size() < b.size()) std::swap(a, b);
+            Limbs product(a.size() + b.size(), 0);
+            LO::mul(product.data(), a.data(), a.size(), b.data(), b.size());
+            product.resize(LO::normalized_size(product.data(), product.size()));
+            return product;
+        }
+
+        // (s + 1)(s + 2)...e: соседние сомножители склеиваются в одно слово на проход mul_1
+        Limbs product_basecase(uint64_t s, uint64_t e) {
+            Limbs acc(1, 1);
+            for (uint64_t k = s + 1; k <= e;) {
+                uint64_t chunk = 1;
+                for (; k <= e && chunk <= WORD_MAX / k; ++k) chunk *= k;
+                const uint64_t carry = LO::mul_1(acc.data(), acc.data(), acc.size(), chunk);
+                if (carry != 0) acc.push_back(carry);
+            }
+            return acc;
+        }
+
+        // Уровни растут независимо; блок уровня L строится из блоков уровня L - 1,
+        // поэтому мьютексы берутся только сверху вниз
+        std::array<impl::GrowOnlyTable<Limbs>, impl::RADIX_BLOCK_LEVELS>& radix_tables() {
+            static std::array<impl::GrowOnlyTable<Limbs>, impl::RADIX_BLOCK_LEVELS> tables;
+            return tables;
+        }
+    }
+
+    namespace impl {
+        const std::vector<uint64_t>& radix_block(unsigned level, uint64_t index) {
+            return radix_tables()[level].get(static_cast<size_t>(index), [level](size_t j) {
+                if (level == 0) return product_basecase(j * RADIX_BLOCK, (j + 1) * RADIX_BLOCK);
+                return multiply(radix_block(level - 1, 2 * j), radix_block(level - 1, 2 * j + 1));
+            });
+        }
+    }
+
+    BinaryArithmetic factorial(uint64_t n) {
+        // Двоичное разложение [0, n) на выровненные блоки от крупных к мелким
+        Limbs acc(1, 1);
+        uint64_t pos = 0;
+        for (unsigned level = impl::RADIX_BLOCK_LEVELS; level-- > 0;) {
+            const uint64_t width = impl::RADIX_BLOCK << level;
+            if (n - pos < width) continue;
+            acc = multiply(acc, impl::radix_block(level, pos / width));
+            pos += width;
+        }
+        if (pos < n) acc = multiply(acc, product_basecase(pos, n));
+        return BinaryArithmetic::from_limbs(acc);
+    }
+
+    void preload_factorial_tables(uint64_t max_index) {
+        // На каждом уровне — последний блок, начинающийся ниже max_index, вместе со всеми предыдущими
+        for (unsigned level = 0; level < impl::RADIX_BLOCK_LEVELS; ++level) {
+            const uint64_t width = impl::RADIX_BLOCK << level;
+            if (width >= max_index) break;
+            (void)impl::radix_block(level, (max_index - 1) / width);
+        }
+    }
+
+    void preload_decimal_tables(size_t digits) {
+        LO::preload_powers<uint64_t>(digits);
+    }
+}
@@ -178,6 +178,132 @@ namespace numsystem {
         EXPECT_EQ(b[0], 1);
     }
 
+    TEST(SmallBufferTest, StaysInlineUntilCapacity) {
+        impl::SmallBuffer<uint64_t, 4> buf;
+        EXPECT_EQ(buf.capacity(), 4u);
+        for (uint64_t i = 0; i < 4; ++i) buf.push_back(i);
+        EXPECT_FALSE(buf.on_heap());
+
+        buf.push_back(4); // переход в кучу
+        EXPECT_TRUE(buf.on_heap());
+        EXPECT_GE(buf.capacity(), 5u);
+        for (uint64_t i = 0; i < 5; ++i) EXPECT_EQ(buf[i], i);
+
+        buf.resize(2);
+        EXPECT_TRUE(buf.on_heap()); // уменьшение память не освобождает
+        EXPECT_EQ(buf.size(), 2u);
+        buf.resize(6);
+        EXPECT_EQ(buf[5], 0u);
+    }
+    TEST(SmallBufferTest, CopyMoveAcrossModes) {
+        impl::SmallBuffer<uint32_t, 2> small{ 1, 2 }, large{ 1, 2, 3, 4, 5 };
+        EXPECT_FALSE(small.on_heap());
+        EXPECT_TRUE(large.on_heap());
+
+        impl::SmallBuffer<uint32_t, 2> copy = large;
+        EXPECT_EQ(copy, large);
+        const uint32_t* heap = large.data();
+        impl::SmallBuffer<uint32_t, 2> moved = std::move(large);
+        EXPECT_EQ(moved.data(), heap); // память из кучи просто передаётся
+        EXPECT_TRUE(large.empty());
+
+        moved = small; // присваивание маленького значения переиспользует кучу
+        EXPECT_EQ(moved, small);
+        EXPECT_EQ(moved.data(), heap);
+
+        swap(small, copy);
+        EXPECT_EQ(small.size(), 5u);
+        EXPECT_EQ(copy.size(), 2u);
+        EXPECT_EQ(copy[1], 2u);
+
+        small.erase(small.begin(), small.begin() + 3);
+        EXPECT_EQ(small, (impl::SmallBuffer<uint32_t, 2>{ 4, 5 }));
+    }
+    TEST(SmallBufferTest, SharedCopyOnWrite) {
+        impl::SmallBuffer<uint32_t, 2> small{ 1, 2 }, large{ 1, 2, 3, 4, 5 };
+        small.share();
+        EXPECT_FALSE(small.shared()); // встроенные значения и так копируются дёшево
+        large.share();
+        ASSERT_TRUE(large.shared());
+
+        // Копии указывают на тот же блок, пока их не меняют
+        using Buffer = impl::SmallBuffer<uint32_t, 2>;
+        const Buffer& view = large;
+        Buffer copy = large;
+        Buffer assigned;
+        assigned = copy;
+        EXPECT_TRUE(copy.shared());
+        EXPECT_EQ(std::as_const(copy).data(), view.data());
+        EXPECT_EQ(std::as_const(assigned).data(), view.data());
+
+        // Запись отделяет только изменяемую копию
+        copy[0] = 9;
+        EXPECT_FALSE(copy.shared());
+        EXPECT_EQ(copy, (impl::SmallBuffer<uint32_t, 2>{ 9, 2, 3, 4, 5 }));
+        EXPECT_EQ(view, (impl::SmallBuffer<uint32_t, 2>{ 1, 2, 3, 4, 5 }));
+        assigned.push_back(6);
+        EXPECT_EQ(assigned.size(), 6u);
+        EXPECT_EQ(view.size(), 5u);
+
+        // Уменьшение не копирует, отделение маленького остатка уходит во встроенный буфер
+        impl::SmallBuffer<uint32_t, 2> shrunk = large;
+        shrunk.resize(2);
+        EXPECT_TRUE(shrunk.shared());
+        shrunk[1] = 7;
+        EXPECT_FALSE(shrunk.on_heap());
+        EXPECT_EQ(shrunk, (impl::SmallBuffer<uint32_t, 2>{ 1, 7 }));
+
+        // Перемещение передаёт ссылку, clear отпускает её
+        impl::SmallBuffer<uint32_t, 2> moved = std::move(large);
+        EXPECT_TRUE(moved.shared());
+        EXPECT_TRUE(large.empty());
+        moved.clear();
+        EXPECT_FALSE(moved.shared());
+        moved = impl::SmallBuffer<uint32_t, 2>{ 3, 4, 5 };
+        EXPECT_EQ(moved.size(), 3u);
+    }
+    TEST(StorageTest, WithoutInlineBuffer) {
+        impl::Storage<uint64_t, 0> store;
+        store.push_back(7);
+        EXPECT_TRUE(store.data().on_heap());
+        impl::Storage<uint64_t, 0> copy = store;
+        EXPECT_EQ(copy[0], 7u);
+    }
+    TEST(StorageTest, WithoutInlineBufferSharedCopyOnWrite) {
+        // Без встроенного буфера пустое хранилище не должно выглядеть общим
+        using Store = impl::Storage<uint64_t, 0>;
+        Store empty;
+        EXPECT_FALSE(empty.shared());
+        Store empty_copy = empty;
+        EXPECT_FALSE(empty_copy.shared());
+        EXPECT_TRUE(empty_copy.data().empty());
+
+        Store store;
+        for (uint64_t v : { 1, 2, 3 }) store.push_back(v);
+        store.share();
+        ASSERT_TRUE(store.shared());
+        const Store& view = store;
+        Store copy = store;
+        EXPECT_TRUE(copy.shared());
+        EXPECT_EQ(std::as_const(copy).data().data(), view.data().data());
+
+        // Запись отделяет копию, общий блок не меняется
+        copy.push_back(4);
+        EXPECT_FALSE(copy.shared());
+        EXPECT_EQ(copy.data().size(), 4u);
+        copy[0] = 9;
+        EXPECT_EQ(copy[0], 9u);
+        EXPECT_EQ(view.data().size(), 3u);
+        EXPECT_EQ(view.data()[0], 1u);
+
+        Store moved = std::move(store);
+        EXPECT_TRUE(moved.shared());
+        moved.data().clear();
+        EXPECT_FALSE(moved.shared());
+        moved.push_back(5);
+        EXPECT_EQ(moved[0], 5u);
+    }
+
 
     TEST(OverflowAwareOpsTest, SumNoCarry) {
         constexpr auto res = constexpr_sum<unsigned int>(10, 20, 0);
@@ -237,6 +363,16 @@ namespace numsystem {
         EXPECT_EQ(result, std::numeric_limits<unsigned int>::max());
         EXPECT_EQ(borrow, 1u);
     }
+    TEST(OverflowAwareOpsTest, SubtractMaxWithPreviousBorrow) {
+        constexpr uint64_t max = std::numeric_limits<uint64_t>::max();
+        constexpr auto res = constexpr_subtract<uint64_t>(max, max, 1);
+        EXPECT_EQ(res.first, max);
+        EXPECT_EQ(res.second, 1u);
+
+        constexpr auto res2 = constexpr_subtract<uint64_t>(0, max, 1);
+        EXPECT_EQ(res2.first, 0u);
+        EXPECT_EQ(res2.second, 1u);
+    }
 
 
     TEST(BigNumberOperationsTest, IsIntegralValidString) {
@@ -1,6 +1,20 @@
 #include "gtest/gtest.h"
 #include "BinaryArithmetic.h"
+#include "BinaryArithmeticBatch.h"
 #include "FactorialArithmetic.h"
+#include "Expression.h"
+#include "FixedArithmetic.h"
+#include "Instrumentation.h"
+#include "MemoryResource.h"
+#include "ModularArithmetic.h"
+#include "Parallel.h"
+#include "Permutation.h"
+#include "Serialization.h"
+#include "Tables.h"
+#include "DecimalStream.h"
+#include "LimbOperations.h"
+#include "CpuDispatch.h"
+#include <sstream>
 
 
 namespace numsystem {
@@ -28,10 +42,22 @@ namespace numsystem {
     template<typename T>
     inline constexpr bool always_false = false;
 
+    // Линейный конгруэнтный генератор: воспроизводимые данные без <random>
+    inline uint64_t next_random(uint64_t& state) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state;
+    }
+    // count десятичных цифр из старших бит генератора; state продолжается дальше
+    inline std::string random_digits(size_t count, uint64_t& state) {
+        std::string text(count, '0');
+        for (char& c : text) c = static_cast<char>('0' + (next_random(state) >> 33) % 10);
+        return text;
+    }
+
     template <typename T>
     class INumericTest : public ::testing::Test {};
 
-    using AllTypes = ::testing::Types<BinaryArithmetic , FactorialArithmetic>;
+    using AllTypes = ::testing::Types<BinaryArithmetic, BasicBinaryArithmetic<uint8_t>, BasicBinaryArithmetic<uint32_t>, FactorialArithmetic>;
     TYPED_TEST_SUITE(INumericTest, AllTypes);
 
     TYPED_TEST(INumericTest, ConstructionAndRepresentation) {
@@ -294,6 +320,122 @@ namespace numsystem {
         EXPECT_THROW((a_str % zero_str), std::overflow_error);
     } 
 
+    TYPED_TEST(INumericTest, DivMod) {
+        // divmod должен совпадать с парой / и % для всех комбинаций знаков
+        for (int a : { 0, 1, 7, 42, 1000, -1, -7, -42, -1000 }) {
+            for (int b : { 1, 2, 7, 13, 1001, -1, -3, -13, -1001 }) {
+                const auto [q, r] = divmod(TypeParam(a), TypeParam(b));
+                EXPECT_EQ(q, TypeParam(a / b)) << a << " / " << b;
+                EXPECT_EQ(r, TypeParam(a % b)) << a << " % " << b;
+                EXPECT_EQ(r, TypeParam(a) % TypeParam(b)) << a << " % " << b;
+            }
+        }
+        EXPECT_THROW((void)divmod(TypeParam(42), TypeParam(0)), std::overflow_error);
+    }
+
+    TYPED_TEST(INumericTest, CompoundAssignInPlace) {
+        // Операции на месте, в том числе с самим собой и со сменой знака
+        for (int a : { 0, 1, 5, 1000, -1, -5, -1000 }) {
+            for (int b : { 0, 1, 5, 999, 1000, -1, -5, -1000 }) {
+                TypeParam x(a);
+                x += TypeParam(b);
+                EXPECT_EQ(x, TypeParam(a + b)) << a << " += " << b;
+                x = TypeParam(a);
+                x -= TypeParam(b);
+                EXPECT_EQ(x, TypeParam(a - b)) << a << " -= " << b;
+                x = TypeParam(a);
+                x *= TypeParam(b);
+                EXPECT_EQ(x, TypeParam(a * b)) << a << " *= " << b;
+            }
+            TypeParam x(a);
+            x += x;
+            EXPECT_EQ(x, TypeParam(a + a)) << a;
+            x = TypeParam(a);
+            x -= x;
+            EXPECT_EQ(x, TypeParam(0)) << a;
+            x = TypeParam(a);
+            x *= x;
+            EXPECT_EQ(x, TypeParam(a * a)) << a;
+        }
+    }
+
+    TYPED_TEST(INumericTest, ScalarOperators) {
+        // Смешанные операции со встроенным целым должны совпадать с операциями над числами
+        const std::vector<TypeParam> values = { TypeParam(0), TypeParam(1), TypeParam(-7), TypeParam(1000),
+            TypeParam("18446744073709551615"), TypeParam("-123456789012345678901234567890") };
+        const std::vector<int64_t> scalars = { 0, 1, -1, 7, -13, 1000003, std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::min() };
+        for (const TypeParam& x : values) {
+            for (int64_t s : scalars) {
+                const TypeParam big(s);
+                EXPECT_EQ(x + s, x + big) << to_string(x) << " + " << s;
+                EXPECT_EQ(s + x, big + x) << s << " + " << to_string(x);
+                EXPECT_EQ(x - s, x - big) << to_string(x) << " - " << s;
+                EXPECT_EQ(s - x, big - x) << s << " - " << to_string(x);
+                EXPECT_EQ(x * s, x * big) << to_string(x) << " * " << s;
+                EXPECT_EQ(s * x, big * x) << s << " * " << to_string(x);
+                TypeParam y(x);
+                y += s;
+                y -= s;
+                y *= s;
+                EXPECT_EQ(y, x * big) << to_string(x) << " , " << s;
+                if (s == 0) {
+                    EXPECT_THROW((void)(x / s), std::overflow_error);
+                    EXPECT_THROW((void)(x % s), std::overflow_error);
+                    continue;
+                }
+                EXPECT_EQ(x / s, x / big) << to_string(x) << " / " << s;
+                EXPECT_EQ(x % s, x % big) << to_string(x) << " % " << s;
+                y = x;
+                y /= s;
+                EXPECT_EQ(y, x / big) << to_string(x) << " /= " << s;
+                y = x;
+                y %= s;
+                EXPECT_EQ(y, x % big) << to_string(x) << " %= " << s;
+            }
+            const uint64_t umax = std::numeric_limits<uint64_t>::max();
+            const TypeParam big(umax);
+            EXPECT_EQ(x + umax, x + big) << to_string(x);
+            EXPECT_EQ(x - umax, x - big) << to_string(x);
+            EXPECT_EQ(x * umax, x * big) << to_string(x);
+            EXPECT_EQ(x / umax, x / big) << to_string(x);
+            EXPECT_EQ(x % umax, x % big) << to_string(x);
+        }
+
+        // ++ и -- через длинные цепочки переносов: 15! - 1, 2^64 - 1, 2^128 - 1
+        for (const char* raw : { "1307674367999", "18446744073709551615", "340282366920938463463374607431768211455" }) {
+            TypeParam x(raw);
+            const TypeParam next = TypeParam(raw) + TypeParam(1);
+            EXPECT_EQ(++x, next) << raw;
+            EXPECT_EQ(x--, next) << raw;
+            EXPECT_EQ(x, TypeParam(raw)) << raw;
+            x = -x;
+            --x;
+            EXPECT_EQ(x, -next) << raw;
+        }
+        TypeParam x(-1);
+        EXPECT_EQ(++x, TypeParam(0));
+        EXPECT_EQ(--x, TypeParam(-1));
+    }
+
+    TYPED_TEST(INumericTest, LazyExpression) {
+        using numsystem::expr::lazy;
+        const TypeParam a(-37), b(1234), c(56), d(-78), e(9001);
+        const TypeParam eager = a * b + c * d - e;
+
+        TypeParam r(123456789);
+        numsystem::expr::assign(r, lazy(a) * b + lazy(c) * d - e);
+        EXPECT_EQ(r, eager);
+
+        const TypeParam converted = lazy(e) - a * lazy(b) + (lazy(c) - d) * (lazy(a) + e);
+        EXPECT_EQ(converted, e - a * b + (c - d) * (a + e));
+        EXPECT_EQ(TypeParam(lazy(b) / c % d), b / c % d);
+
+        // Приёмник входит в выражение
+        TypeParam x(17);
+        numsystem::expr::assign(x, lazy(a) * x + x * lazy(x));
+        EXPECT_EQ(x, a * TypeParam(17) + TypeParam(17 * 17));
+    }
+
     TYPED_TEST(INumericTest, ArithmeticOperators) {
         //SKIPPING(FactorialArithmetic)
         const auto test_arithmetic_small = [](auto raw_a, auto raw_b) {
@@ -524,6 +666,38 @@ namespace numsystem {
         EXPECT_THROW(sqrt(negative_value), std::domain_error);
         EXPECT_THROW(sqrt(TypeParam("-123")), std::domain_error);
     }
+    TYPED_TEST(INumericTest, RootsAndRemainder) {
+        // Корень и остаток на границах точных квадратов, включая числа в сотни бит
+        for (const TypeParam& r : { TypeParam(1), TypeParam(7), TypeParam(4294967296LL), TypeParam("340282366920938463463374607431768211457") }) {
+            const TypeParam square = r * r;
+            EXPECT_EQ(sqrtrem(square), std::make_pair(r, TypeParam(0)));
+            EXPECT_EQ(sqrtrem(square - TypeParam(1)), std::make_pair(r - TypeParam(1), r + r - TypeParam(2)));
+            EXPECT_EQ(sqrtrem(square + r + r), std::make_pair(r, r + r));
+            EXPECT_EQ(sqrt(square + r + r + TypeParam(1)), r + TypeParam(1));
+        }
+        EXPECT_EQ(sqrtrem(TypeParam(0)), std::make_pair(TypeParam(0), TypeParam(0)));
+        EXPECT_THROW((void)sqrtrem(TypeParam(-4)), std::domain_error);
+
+        // Корни степени n
+        EXPECT_EQ(iroot(TypeParam(0), 3), TypeParam(0));
+        EXPECT_EQ(iroot(TypeParam(26), 3), TypeParam(2));
+        EXPECT_EQ(iroot(TypeParam(27), 3), TypeParam(3));
+        EXPECT_EQ(iroot(TypeParam(-27), 3), TypeParam(-3));
+        EXPECT_EQ(iroot(TypeParam(-28), 3), TypeParam(-3));
+        EXPECT_EQ(iroot(TypeParam(12345), 1), TypeParam(12345));
+        EXPECT_EQ(iroot(TypeParam(1023), 10), TypeParam(1));
+        EXPECT_EQ(iroot(TypeParam(1024), 10), TypeParam(2));
+        EXPECT_EQ(iroot(TypeParam(1000), 100), TypeParam(1));
+        const TypeParam base("123456789012345678901");
+        for (unsigned int n : { 2u, 3u, 5u, 7u }) {
+            const TypeParam power = pow(base, n);
+            EXPECT_EQ(iroot(power, n), base) << n;
+            EXPECT_EQ(iroot(power - TypeParam(1), n), base - TypeParam(1)) << n;
+            EXPECT_EQ(iroot(power + base, n), base) << n;
+        }
+        EXPECT_THROW((void)iroot(TypeParam(8), 0), std::domain_error);
+        EXPECT_THROW((void)iroot(TypeParam(-16), 4), std::domain_error);
+    }
 
     // Тест-кейс для проверки конкретного шага деления в факториальной конвертации
     TEST(BinaryArithmeticTest, DivisionForFactorialConversionStep3) {
@@ -579,6 +753,306 @@ namespace numsystem {
             << "Error: Incorrect quotient when dividing 21850 % 4";
     }
 
+    TEST(BinaryArithmeticTest, LimbWidthsAgree) {
+        // Одно и то же значение, разложенное на слова разной ширины, должно давать одинаковые результаты
+        const std::string a_str = "340282366920938463463374607431768211455123456789";   // > 2^128
+        const std::string b_str = "-18446744073709551617987654321";
+        const auto check = [&](auto a, auto b) {
+            EXPECT_EQ(to_string(a * b), to_string(BinaryArithmetic(a_str) * BinaryArithmetic(b_str)));
+            EXPECT_EQ(to_string(a / b), to_string(BinaryArithmetic(a_str) / BinaryArithmetic(b_str)));
+            EXPECT_EQ(to_string(a % b), to_string(BinaryArithmetic(a_str) % BinaryArithmetic(b_str)));
+            EXPECT_EQ(to_string(a + b), to_string(BinaryArithmetic(a_str) + BinaryArithmetic(b_str)));
+        };
+        check(BasicBinaryArithmetic<uint8_t>(a_str), BasicBinaryArithmetic<uint8_t>(b_str));
+        check(BasicBinaryArithmetic<uint16_t>(a_str), BasicBinaryArithmetic<uint16_t>(b_str));
+        check(BasicBinaryArithmetic<uint32_t>(a_str), BasicBinaryArithmetic<uint32_t>(b_str));
+
+        EXPECT_EQ(to_string(BinaryArithmetic("18446744073709551615") * BinaryArithmetic("18446744073709551615")),
+            "340282366920938463426481119284349108225");
+        EXPECT_EQ(static_cast<int>(BinaryArithmetic(-7)), -7);
+        EXPECT_EQ(static_cast<int64_t>(BinaryArithmetic(type_info<int64_t>::min)), type_info<int64_t>::min);
+        EXPECT_THROW((void)static_cast<uint32_t>(BinaryArithmetic("4294967296")), std::overflow_error);
+    }
+
+    TEST(BinaryArithmeticTest, MultiplicationTiers) {
+        // Размеры подобраны так, чтобы пройти «столбик», Карацубу, Тоома-3 и несбалансированное умножение
+        const auto digits = [](size_t n, uint64_t seed) {
+            std::string s = random_digits(n, seed);
+            s[0] = '7';
+            return s;
+        };
+        for (size_t len : { 40, 300, 1200, 4000 }) {
+            const std::string a_str = digits(len, len);
+            const std::string b_str = digits(len * 2 / 3 + 1, len + 1);
+            const std::string c_str = digits(len / 5 + 1, len + 2);
+
+            BinaryArithmetic a(a_str), b(b_str), c(c_str);
+            const BinaryArithmetic ab = a * b;
+
+            // (a + b)^2 == a^2 + 2ab + b^2
+            EXPECT_EQ((a + b) * (a + b), a * a + ab + ab + b * b) << "len=" << len;
+            // a * (b + c) == ab + ac, включая несбалансированное a * c
+            EXPECT_EQ(a * (b + c), ab + a * c) << "len=" << len;
+            EXPECT_EQ(ab / b, a) << "len=" << len;
+
+            // Другие ширины слов переключают алгоритмы на других размерах
+            EXPECT_EQ(to_string(BasicBinaryArithmetic<uint8_t>(a_str) * BasicBinaryArithmetic<uint8_t>(b_str)), to_string(ab)) << "len=" << len;
+            EXPECT_EQ(to_string(BasicBinaryArithmetic<uint32_t>(a_str) * BasicBinaryArithmetic<uint32_t>(b_str)), to_string(ab)) << "len=" << len;
+        }
+    }
+
+    TEST(BinaryArithmeticTest, MultiplicationNtt) {
+        // Операнды от порога NTT и выше (в словах, поэтому узкие слова доходят до него раньше);
+        // проверки не опираются на умножение тех же размеров
+        const auto check = [](auto tag, unsigned bits, bool full) {
+            using T = decltype(tag);
+            const T one(1), two(2);
+            const T ones = pow(two, bits) - one;
+            // (2^k - 1)^2 == 2^2k - 2^(k+1) + 1, через возведение в квадрат и через обычное произведение
+            const T expected = pow(two, 2 * bits) - pow(two, bits + 1) + one;
+            const T copy = ones + T(0);
+            EXPECT_EQ(ones * ones, expected) << bits;
+            EXPECT_EQ(ones * copy, expected) << bits;
+            if (!full) return;
+
+            // Значения, в которых слова заняты полностью и вразнобой
+            const T a = ones / T(7) + T("123456789123456789123456789");
+            const T b = (ones >> (bits / 4)) / T(3) + one;
+            const T ab = a * b;
+            const T m("340282366920938463463374607431768211297");   // простое 2^128 - 159
+            EXPECT_EQ(ab % m, (a % m) * (b % m) % m) << bits;
+            EXPECT_EQ(a * a % m, (a % m) * (a % m) % m) << bits;
+            const uint64_t small = 2305843009213693951ULL;                 // простое 2^61 - 1, остаток через mod_small
+            EXPECT_EQ(ab % small, (a % small) * (b % small) % small) << bits;
+        };
+        check(BasicBinaryArithmetic<uint8_t>{}, 64000, true);
+        check(BasicBinaryArithmetic<uint8_t>{}, 65536 * 2 + 17, true);
+        check(BasicBinaryArithmetic<uint16_t>{}, 65536 * 2 + 17, true);
+        check(BinaryArithmetic{}, 64 * impl::MultiplyThresholds::FFT, false);
+    }
+
+    TEST(BinaryArithmeticTest, KnuthDivision) {
+        // Делители на границах слов: старший бит слова, все единицы, одно слово
+        const auto check = [](const BinaryArithmetic& a, const BinaryArithmetic& b) {
+            const auto [q, r] = divmod(a, b);
+            EXPECT_EQ(q * b + r, a) << to_string(a) << " / " << to_string(b);
+            EXPECT_LT(abs(r), abs(b)) << to_string(a) << " / " << to_string(b);
+            EXPECT_EQ(r.sign(), r != BinaryArithmetic(0) && a.sign());
+        };
+        const BinaryArithmetic two(2), one(1);
+        for (int limbs : { 1, 2, 3, 5, 9 }) {
+            const BinaryArithmetic top_bit = pow(two, 64 * limbs - 1);
+            const BinaryArithmetic all_ones = pow(two, 64 * limbs) - one;
+            const BinaryArithmetic dividend = pow(all_ones, 3) + BinaryArithmetic("123456789123456789");
+            for (const BinaryArithmetic& divisor : { top_bit, top_bit + one, all_ones, all_ones - top_bit, BinaryArithmetic(3) }) {
+                check(dividend, divisor);
+                check(-dividend, divisor);
+                check(dividend, -divisor);
+                check(all_ones, divisor);
+                check(divisor * divisor, divisor);
+            }
+        }
+
+        // Случай qhat = B - 1 с коррекцией при вычитании
+        const BinaryArithmetic b = pow(two, 127) + one;
+        check(b * pow(two, 64) - one, b);
+        EXPECT_EQ(to_string(BinaryArithmetic("340282366920938463463374607431768211456") / BinaryArithmetic("18446744073709551617")),
+            "18446744073709551615");
+    }
+
+    TEST(BinaryArithmeticTest, Shifts) {
+        // Сдвиг влево — умножение на 2^k, вправо — деление с округлением вниз
+        const auto check = [](auto tag) {
+            using T = decltype(tag);
+            const T two(2);
+            const T base = T("98765432109876543210987654321") * T("1234567890123456789");
+            for (const T& value : { base, -base, T(1), T(-1), T(-5), T(0), pow(two, 200) }) {
+                for (size_t bits : { 0, 1, 7, 8, 31, 32, 63, 64, 65, 130, 300 }) {
+                    const T p = pow(two, static_cast<int>(bits));
+                    EXPECT_EQ(value << bits, value * p) << to_string(value) << " << " << bits;
+
+                    T floor = value / p;
+                    if (value.sign() && floor * p != value) floor -= T(1);
+                    EXPECT_EQ(value >> bits, floor) << to_string(value) << " >> " << bits;
+
+                    T x = value;
+                    x <<= bits;
+                    x >>= bits;
+                    EXPECT_EQ(x, value) << to_string(value) << " <<= >>= " << bits;
+                }
+            }
+            EXPECT_EQ(to_string(T(-5) >> 1), "-3");
+            EXPECT_EQ(to_string(T(-1) >> 100), "-1");
+            EXPECT_EQ(to_string(T(1) >> 100), "0");
+            EXPECT_FALSE((T(1) >> 100).sign());
+        };
+        check(BinaryArithmetic{});
+        check(BasicBinaryArithmetic<uint8_t>{});
+        check(BasicBinaryArithmetic<uint32_t>{});
+    }
+
+    TEST(BinaryArithmeticTest, BitwiseOperations) {
+        const auto check = [](auto tag) {
+            using T = decltype(tag);
+            // Малые значения сверяем со встроенным дополнительным кодом int64_t
+            const int64_t values[] = { 0, 1, 2, 5, 255, 256, 65535, 1LL << 40, 123456789012345LL,
+                -1, -2, -5, -255, -256, -65536, -(1LL << 40), -123456789012345LL };
+            for (int64_t a : values) {
+                for (int64_t b : values) {
+                    EXPECT_EQ(T(a) & T(b), T(a & b)) << a << " & " << b;
+                    EXPECT_EQ(T(a) | T(b), T(a | b)) << a << " | " << b;
+                    EXPECT_EQ(T(a) ^ T(b), T(a ^ b)) << a << " ^ " << b;
+                }
+                EXPECT_EQ(~T(a), T(~a)) << "~" << a;
+                for (size_t bit = 0; bit < 63; ++bit) {
+                    EXPECT_EQ(T(a).test_bit(bit), ((a >> bit) & 1) != 0) << a << " bit " << bit;
+                }
+                EXPECT_EQ(T(a).test_bit(200), a < 0) << a;
+            }
+
+            // Большие значения: тождества и согласованность со сдвигами
+            const T two(2);
+            const T x = T("123456789012345678901234567890123456789") * T("98765432109876543210");
+            const T y = pow(two, 150) - T("777777777777777777777");
+            for (const T& a : { x, -x, y, -y }) {
+                for (const T& b : { x, -x, y, -y, T(0), T(-1) }) {
+                    EXPECT_EQ((a & b) + (a | b), a + b) << to_string(a) << ", " << to_string(b);
+                    EXPECT_EQ(a ^ b, (a | b) - (a & b)) << to_string(a) << ", " << to_string(b);
+                }
+                EXPECT_EQ(a & T(-1), a);
+                EXPECT_EQ(a | T(0), a);
+                EXPECT_EQ(a ^ a, T(0));
+                EXPECT_EQ(a & ~a, T(0));
+                EXPECT_EQ(a & -a, pow(two, static_cast<int>(a.countr_zero())));
+                for (size_t bit : { 0, 1, 63, 64, 100, 149, 150, 300 }) {
+                    EXPECT_EQ(a.test_bit(bit), ((a >> bit) & T(1)) == T(1)) << to_string(a) << " bit " << bit;
+                }
+                T self = a;
+                self &= self;
+                EXPECT_EQ(self, a);
+            }
+
+            EXPECT_EQ(T(0).bit_length(), 0u);
+            EXPECT_EQ(T(1).bit_length(), 1u);
+            EXPECT_EQ(T(-255).bit_length(), 8u);
+            EXPECT_EQ(pow(two, 150).bit_length(), 151u);
+            EXPECT_EQ((pow(two, 150) - T(1)).bit_length(), 150u);
+            EXPECT_EQ((pow(two, 150) - T(1)).popcount(), 150u);
+            EXPECT_EQ(T(-0b1011).popcount(), 3u);
+            EXPECT_EQ(pow(two, 150).countr_zero(), 150u);
+            EXPECT_EQ(T(0).countr_zero(), 0u);
+        };
+        check(BinaryArithmetic{});
+        check(BasicBinaryArithmetic<uint8_t>{});
+        check(BasicBinaryArithmetic<uint32_t>{});
+    }
+
+    TEST(BinaryArithmeticTest, ModularArithmetic) {
+        const auto check = [](auto tag) {
+            using T = decltype(tag);
+            using Context = BasicModContext<typename T::limb_type>;
+            // Малые модули (нечётные — Монтгомери, чётные — деление) сверяем с наивным счётом
+            for (int64_t m : { 1LL, 2LL, 3LL, 10LL, 97LL, 256LL, 1000003LL, 4294967296LL, 4294967311LL }) {
+                const Context ctx{ T(m) };
+                EXPECT_EQ(ctx.montgomery(), m % 2 == 1) << m;
+                for (int64_t a : { 0, 1, 2, 12345, -7, 987654321 }) {
+                    const T ra(((a % m) + m) % m);
+                    EXPECT_EQ(ctx.reduce(T(a)), ra) << a << " mod " << m;
+                    EXPECT_EQ(ctx.mulmod(T(a), T(a) * T(a)), ra * ra * ra % T(m)) << a << "^3 mod " << m;
+                    for (int e : { 0, 1, 2, 3, 17, 100, 1001 }) {
+                        T expected = T(1) % T(m);
+                        for (int i = 0; i < e; ++i) expected = expected * ra % T(m);
+                        EXPECT_EQ(ctx.powmod(T(a), T(e)), expected) << a << "^" << e << " mod " << m;
+                    }
+                    if (gcd(T(a), T(m)) == T(1)) {
+                        EXPECT_EQ(ctx.mulmod(ctx.modinv(T(a)), T(a)), T(1 % m)) << a << " mod " << m;
+                        EXPECT_EQ(ctx.mulmod(ctx.powmod(T(a), T(-5)), ctx.powmod(T(a), T(5))), T(1 % m)) << a << " mod " << m;
+                    }
+                    else {
+                        EXPECT_THROW((void)ctx.modinv(T(a)), std::domain_error) << a << " mod " << m;
+                    }
+                }
+            }
+            EXPECT_THROW(Context{ T(0) }, std::domain_error);
+            EXPECT_THROW(Context{ T(-5) }, std::domain_error);
+
+            // Малая теорема Ферма для простых Мерсенна 2^127 - 1 и 2^521 - 1, и для составного модуля
+            const T two(2);
+            for (unsigned p : { 127u, 521u }) {
+                const T prime = pow(two, p) - T(1);
+                const Context ctx(prime);
+                for (const T& a : { T(3), T("123456789012345678901234567890"), prime - T(2), pow(two, p + 40) + T(11) }) {
+                    EXPECT_EQ(ctx.powmod(a, prime - T(1)), T(1)) << p;
+                    EXPECT_EQ(ctx.powmod(a, prime), ctx.reduce(a)) << p;
+                    EXPECT_EQ(ctx.mulmod(a, ctx.modinv(a)), T(1)) << p;
+                }
+                const T even = prime + T(1);
+                const T base("98765432109876543210987654321");
+                EXPECT_EQ(powmod(base, T(3), even), base * base * base % even) << p;
+                EXPECT_EQ(powmod(base, T(1000), even), pow(base, 1000) % even) << p;
+            }
+
+            EXPECT_EQ(gcd(T(0), T(0)), T(0));
+            EXPECT_EQ(gcd(T(0), T(-12)), T(12));
+            EXPECT_EQ(gcd(T(-48), T(36)), T(12));
+            EXPECT_EQ(gcd(T(17), T(5)), T(1));
+            const T x = pow(two, 200) * T(3) * T(1000003);
+            const T y = pow(two, 150) * T(5) * T(1000003);
+            EXPECT_EQ(gcd(x, y), pow(two, 150) * T(1000003));
+            EXPECT_EQ(gcd(y, x), gcd(x, y));
+        };
+        check(BinaryArithmetic{});
+        check(BasicBinaryArithmetic<uint8_t>{});
+        check(BasicBinaryArithmetic<uint16_t>{});
+        check(BasicBinaryArithmetic<uint32_t>{});
+    }
+
+    TEST(BinaryArithmeticTest, DecimalConversionRoundTrip) {
+        // Длины подобраны так, чтобы пройти и разбор по кускам, и деление пополам по степеням 10
+        const auto check = [](const std::string& digits) {
+            EXPECT_EQ(to_string(BinaryArithmetic(digits)), digits) << "len=" << digits.size();
+            EXPECT_EQ(to_string(BasicBinaryArithmetic<uint8_t>(digits)), digits) << "len=" << digits.size();
+            EXPECT_EQ(to_string(BasicBinaryArithmetic<uint32_t>(digits)), digits) << "len=" << digits.size();
+            EXPECT_EQ(to_string(FactorialArithmetic(digits)), digits) << "len=" << digits.size();
+            EXPECT_EQ(to_string(BinaryArithmetic("-" + digits)), "-" + digits) << "len=" << digits.size();
+        };
+        for (size_t len : { 1, 19, 20, 39, 400, 1000, 5000 }) {
+            std::string digits(len, '0');
+            unsigned seed = static_cast<unsigned>(len);
+            for (auto& ch : digits) {
+                seed = seed * 1103515245u + 12345u;
+                ch = static_cast<char>('0' + (seed >> 16) % 10);
+            }
+            digits[0] = '9';
+            check(digits);
+            check(std::string(len, '9'));                   // 10^len - 1
+            check("1" + std::string(len, '0'));             // 10^len: граница степени
+            check("1" + std::string(len, '0') + "1");       // нули внутри младшей половины
+        }
+
+        // Разбор и вывод согласованы с арифметикой
+        const BinaryArithmetic big("1" + std::string(3000, '0'));
+        EXPECT_EQ(big / BinaryArithmetic("1" + std::string(1500, '0')), BinaryArithmetic("1" + std::string(1500, '0')));
+        EXPECT_EQ(to_string(big - BinaryArithmetic(1)), std::string(3000, '9'));
+    }
+
+    TEST(FactorialArithmetic, MulDivMatchBinary) {
+        // Умножение и деление идут через двоичные слова; результат должен совпадать с BinaryArithmetic
+        const std::string a_str = "-9876543210987654321098765432109876543210987654321098765432109876543210";
+        const std::string b_str = "123456789012345678901234567890123";
+        const std::string c_str = "18446744073709551617";
+        for (const auto& [x, y] : { std::pair{ a_str, b_str }, std::pair{ a_str, c_str }, std::pair{ b_str, a_str }, std::pair{ c_str, std::string("-7") } }) {
+            const FactorialArithmetic fx(x), fy(y);
+            const BinaryArithmetic bx(x), by(y);
+            EXPECT_EQ(to_string(fx * fy), to_string(bx * by)) << x << " * " << y;
+            EXPECT_EQ(to_string(fx / fy), to_string(bx / by)) << x << " / " << y;
+            EXPECT_EQ(to_string(fx % fy), to_string(bx % by)) << x << " % " << y;
+        }
+        const FactorialArithmetic f(a_str);
+        EXPECT_EQ(f * f / f, f);
+        EXPECT_EQ(to_string(f % f), "0");
+    }
+
     TEST(FactorAccess, CountBits) {
         using FA = internal::FactorAccess;
         EXPECT_EQ(FA::count_bits(0), 0);
@@ -668,4 +1142,1054 @@ namespace numsystem {
             EXPECT_EQ(result.value(), value) << "Index: " << index;
         }
     }
+    TEST(FactorAccess, CursorMatchesExtract) {
+        using FA = internal::FactorAccess;
+
+        // Курсор и последовательная запись должны совпадать с extract/put на любых ширинах слов
+        const auto check = [](auto storage) {
+            internal::FactorWriter writer(storage);
+            for (uint64_t index = 0; index <= 300; ++index) {
+                writer.push((index * 7919) % (index + 1));
+            }
+            EXPECT_EQ(storage.value(), 300u);
+
+            internal::FactorCursor forward(storage);
+            for (uint64_t index = 0; index <= 300; ++index, ++forward) {
+                ASSERT_TRUE(forward.valid()) << "Index: " << index;
+                EXPECT_EQ(forward.index(), index);
+                EXPECT_EQ(*forward, FA::extract(storage, index).value()) << "Index: " << index;
+                EXPECT_EQ(*forward, (index * 7919) % (index + 1)) << "Index: " << index;
+            }
+
+            internal::FactorCursor backward(storage, 300);
+            for (uint64_t index = 300; index > 0; --index, --backward) {
+                EXPECT_EQ(backward.index(), index);
+                EXPECT_EQ(*backward, FA::extract(storage, index).value()) << "Index: " << index;
+            }
+
+            // За пределами хранилища коэффициенты читаются как 0
+            internal::FactorCursor outside(storage, 100000);
+            EXPECT_FALSE(outside.valid());
+            EXPECT_EQ(*outside, 0u);
+        };
+        check(impl::Storage<uint8_t>{});
+        check(impl::Storage<uint32_t>{});
+        check(impl::Storage<uint64_t>{});
+
+        EXPECT_EQ(FA::index_at_bit(0), 1u);
+        EXPECT_EQ(FA::index_at_bit(1), 2u);
+        EXPECT_EQ(FA::index_at_bit(4), 3u);
+        EXPECT_EQ(FA::index_at_bit(5), 4u);
+    }
+    // Ресурс-обёртка, считающий выделения
+    class CountingResource : public std::pmr::memory_resource {
+    public:
+        explicit CountingResource(std::pmr::memory_resource* upstream) : _upstream(upstream) {}
+        size_t allocations = 0;
+        size_t live = 0;
+    private:
+        void* do_allocate(size_t bytes, size_t align) override { ++allocations; ++live; return _upstream->allocate(bytes, align); }
+        void do_deallocate(void* p, size_t bytes, size_t align) override { --live; _upstream->deallocate(p, bytes, align); }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+        std::pmr::memory_resource* _upstream;
+    };
+
+    TYPED_TEST(INumericTest, ScopedMemoryResource) {
+        const TypeParam a("123456789012345678901234567890123456789012345678901234567890");
+        const TypeParam b("-98765432109876543210987654321098765432109876543210");
+        const TypeParam expected = (a * b + a) / b % a;
+
+        Arena arena;
+        CountingResource counter(&arena);
+        TypeParam kept;
+        {
+            ScopedMemoryResource scope(&counter);
+            TypeParam x = a * b;
+            x += a;
+            TypeParam result = x / b % a;
+            EXPECT_EQ(result, expected);
+            kept = result; // копия во внешнее значение не держит память арены
+        }
+        EXPECT_GT(counter.allocations, 0u);
+        EXPECT_EQ(counter.live, 0u);
+        arena.reset();
+        EXPECT_EQ(kept, expected);
+
+        // Вне области видимости арена больше не используется
+        const size_t before = counter.allocations;
+        TypeParam y = a * b;
+        EXPECT_EQ(counter.allocations, before);
+        EXPECT_EQ(y, a * b);
+    }
+
+    TYPED_TEST(INumericTest, RvalueOperatorsAndOutputParameters) {
+        const TypeParam a("123456789012345678901234567890123456789");
+        const TypeParam b("-98765432109876543210987654321");
+        auto copy = [](const TypeParam& v) { return TypeParam(v); };
+
+        // Временный операнд слева, справа и с обеих сторон даёт тот же результат, что и копирующая форма
+        EXPECT_EQ(copy(a) + b, a + b);
+        EXPECT_EQ(a + copy(b), a + b);
+        EXPECT_EQ(copy(a) + copy(b), a + b);
+        EXPECT_EQ(copy(a) - b, a - b);
+        EXPECT_EQ(a - copy(b), a - b);
+        EXPECT_EQ(copy(b) - copy(a), b - a);
+        EXPECT_EQ(copy(a) * b, a * b);
+        EXPECT_EQ(a * copy(b), a * b);
+        EXPECT_EQ(copy(a) * copy(b), a * b);
+        EXPECT_EQ(copy(a) + 7, a + 7);
+        EXPECT_EQ(-7 + copy(a), a - 7);
+        EXPECT_EQ(copy(a) - 7, a - 7);
+        EXPECT_EQ(7 - copy(a), -a + 7);
+        EXPECT_EQ(copy(b) * -3, b * -3);
+        EXPECT_EQ(3 * copy(b), b * 3);
+        EXPECT_EQ(copy(a) / 10, a / 10);
+        EXPECT_EQ(-copy(b), -b);
+        EXPECT_EQ(abs(copy(b)), abs(b));
+        EXPECT_EQ(abs(copy(a)), a);
+
+        // Нулевая разность с временным справа остаётся неотрицательной
+        EXPECT_EQ(a - copy(a), TypeParam(0));
+        EXPECT_FALSE((a - copy(a)).sign());
+        EXPECT_EQ((-copy(b)).sign(), (-b).sign());
+
+        // Выходной параметр, в том числе совпадающий с операндом
+        TypeParam r;
+        EXPECT_EQ(add(r, a, b), a + b);
+        EXPECT_EQ(subtract(r, a, b), a - b);
+        EXPECT_EQ(multiply(r, a, b), a * b);
+        TypeParam x = a;
+        EXPECT_EQ(add(x, x, b), a + b);
+        x = b;
+        EXPECT_EQ(subtract(x, a, x), a - b);
+        x = b;
+        EXPECT_EQ(multiply(x, a, x), a * b);
+        x = a;
+        EXPECT_EQ(multiply(x, x, x), a * a);
+        EXPECT_EQ(multiply(r, a, TypeParam(0)), TypeParam(0));
+        EXPECT_FALSE(r.sign());
+    }
+
+    TYPED_TEST(INumericTest, SharedValuesCopyOnWrite) {
+        const std::string text = "-" + std::string(400, '9');
+        const TypeParam expected(text);
+        TypeParam constant = expected;
+        constant.share();
+        ASSERT_TRUE(constant.is_shared());
+        EXPECT_EQ(constant, expected);
+        // Маленькие значения остаются во встроенном буфере, а без него тоже становятся общими
+        EXPECT_EQ(TypeParam(5).share().is_shared(), NUMSYS_STORAGE_INLINE_BYTES == 0);
+
+        // Копия общего значения не выделяет память; первое изменение отделяет только её
+        {
+            Arena arena;
+            CountingResource counter(&arena);
+            ScopedMemoryResource scope(&counter);
+            TypeParam copy = constant;
+            EXPECT_EQ(counter.allocations, 0u);
+            EXPECT_TRUE(copy.is_shared());
+            copy += TypeParam(1);
+            EXPECT_FALSE(copy.is_shared());
+            EXPECT_EQ(copy, expected + TypeParam(1));
+        }
+        EXPECT_TRUE(constant.is_shared());
+        EXPECT_EQ(to_string(constant), text);
+
+        // Одна константа на несколько потоков: чтение и копии без блокировок, каждый поток меняет свои копии
+        std::vector<std::thread> threads;
+        std::atomic<int> mismatches{ 0 };
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 20; ++i) {
+                    TypeParam local = constant;
+                    if (local != expected || to_string(constant) != text) ++mismatches;
+                    local *= TypeParam(t + i + 2);
+                    if (local / TypeParam(t + i + 2) != constant) ++mismatches;
+                    TypeParam sum = constant + local;
+                    if (sum != expected * TypeParam(t + i + 3)) ++mismatches;
+                }
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        EXPECT_EQ(mismatches.load(), 0);
+        EXPECT_EQ(constant, expected);
+    }
+
+    TEST(MemoryResourceTest, RvalueOperatorsReuseOperandStorage) {
+        // Меньший множитель короче порога Карацубы (19 цифр помещаются в слово):
+        // умножение идёт «столбиком» и не берёт временной памяти
+        const size_t digits = 19 * std::min<size_t>(8, impl::MultiplyThresholds::KARATSUBA - 1);
+        const BinaryArithmetic a("1" + std::string(2 * digits, '7'));
+        const BinaryArithmetic b("-" + std::string(digits, '3'));
+        LimbPool pool;
+        CountingResource counter(&pool);
+        ScopedMemoryResource scope(&counter);
+
+        // Результат забирает хранилище временного операнда: новых блоков нет
+        BinaryArithmetic x = a;
+        size_t before = counter.allocations;
+        BinaryArithmetic y = std::move(x) + b;
+        y = -std::move(y);
+        y = abs(std::move(y));
+        y = std::move(y) * 3;
+        EXPECT_EQ(counter.allocations, before);
+        EXPECT_EQ(y, abs(a + b) * 3);
+
+        // Выходной объект нужной ёмкости используется повторно без новых выделений
+        BinaryArithmetic r;
+        multiply(r, a, b);
+        before = counter.allocations;
+        for (int i = 0; i < 10; ++i) {
+            multiply(r, a, b);
+            add(r, a, b);
+            subtract(r, b, a);
+        }
+        EXPECT_EQ(counter.allocations, before);
+        EXPECT_EQ(r, b - a);
+        EXPECT_EQ(multiply(r, a, b), a * b);
+    }
+
+    TEST(MemoryResourceTest, PoolReusesFreedBlocks) {
+        LimbPool pool;
+        CountingResource counter(&pool);
+        ScopedMemoryResource scope(&counter);
+        {
+            ScopedMemoryResource inner(nullptr); // вложенная область возвращает ресурс по умолчанию
+            BinaryArithmetic outside = BinaryArithmetic("1" + std::string(100, '0'));
+            EXPECT_EQ(counter.allocations, 0u);
+        }
+        for (int i = 0; i < 10; ++i) {
+            BinaryArithmetic big = BinaryArithmetic("1" + std::string(100, '0')) * BinaryArithmetic("7" + std::string(100, '3'));
+            EXPECT_EQ(to_string(big % BinaryArithmetic(10)), "0");
+        }
+        EXPECT_GT(counter.allocations, 0u);
+        EXPECT_EQ(counter.live, 0u);
+    }
+
+    TEST(ParallelTest, MatchesSerialResults) {
+        const auto digits = [](size_t count, uint64_t seed) {
+            std::string text = random_digits(count, seed);
+            text[0] = '7';
+            return text;
+        };
+        const auto check = [&](auto tag) {
+            using T = decltype(tag);
+            const std::string sa = digits(6000, 1), sb = digits(4500, 2);
+            const T a(sa), b(sb);
+            const T product = a * b;
+            const T square = a * a;
+            const std::string text = to_string(product);
+
+            // Низкий порог, чтобы параллельные ветви заработали и на небольших числах
+            ThreadPool pool(4, 8);
+            EXPECT_EQ(pool.size(), 4u);
+            EXPECT_EQ(pool.threshold(), 8u);
+            ScopedParallelism scope(pool);
+            for (int i = 0; i < 3; ++i) {
+                EXPECT_EQ(a * b, product);
+                EXPECT_EQ(a * a, square);
+                EXPECT_EQ(to_string(product), text);
+                EXPECT_EQ(T(text), product);
+                EXPECT_EQ(to_string(T(sa)), sa);
+            }
+            // Несколько внешних потоков делят один пул
+            std::vector<std::thread> threads;
+            std::atomic<int> mismatches{ 0 };
+            for (int t = 0; t < 3; ++t) {
+                threads.emplace_back([&] {
+                    ScopedParallelism inner(pool);
+                    if (a * b != product || to_string(product) != text) ++mismatches;
+                });
+            }
+            for (std::thread& thread : threads) thread.join();
+            EXPECT_EQ(mismatches.load(), 0);
+            // Под ScopedMemoryResource работа остаётся последовательной и однопоточной
+            {
+                Arena arena;
+                ScopedMemoryResource resource(&arena);
+                EXPECT_EQ(a * b, product);
+            }
+        };
+        check(BinaryArithmetic{});
+        check(BasicBinaryArithmetic<uint32_t>{});
+        check(BasicBinaryArithmetic<uint16_t>{});
+    }
+
+    TEST(BinaryArithmeticBatchTest, MatchesWrappedScalarArithmetic) {
+        const BinaryArithmetic two(2);
+        for (size_t bits : { 64, 128, 192 }) {
+            const BinaryArithmetic modulus = pow(two, bits);
+            const BinaryArithmetic half = pow(two, bits - 1);
+            // Приведение к знаковому диапазону [-2^(bits-1), 2^(bits-1))
+            const auto wrap = [&](BinaryArithmetic v) {
+                v = v % modulus;
+                if (v < BinaryArithmetic(0)) v += modulus;
+                if (v >= half) v -= modulus;
+                return v;
+            };
+
+            // 150 элементов: больше одной полосы ядра и неполная последняя
+            const size_t count = 150;
+            std::vector<BinaryArithmetic> xs, ys;
+            uint64_t seed = bits;
+            const auto next = [&] { return next_random(seed); };
+            for (size_t i = 0; i < count; ++i) {
+                BinaryArithmetic x(0), y(0);
+                for (size_t j = 0; j < bits / 64; ++j) {
+                    x = x * pow(two, 64) + BinaryArithmetic(next());
+                    y = y * pow(two, 64) + BinaryArithmetic(next());
+                }
+                // Граничные значения вперемешку со случайными
+                if (i % 7 == 0) x = half - BinaryArithmetic(1);
+                if (i % 11 == 0) y = half - BinaryArithmetic(1);
+                if (i % 13 == 0) y = x;
+                xs.push_back(wrap(x));
+                ys.push_back(wrap(y));
+            }
+            xs[1] = -half;
+            ys[2] = BinaryArithmetic(0);
+
+            BinaryArithmeticBatch a(count, bits), b(count, bits);
+            EXPECT_EQ(a.size(), count);
+            EXPECT_EQ(a.bits(), bits);
+            for (size_t i = 0; i < count; ++i) {
+                a.set(i, xs[i]);
+                b.set(i, ys[i]);
+                EXPECT_EQ(a.get(i), xs[i]);
+            }
+
+            std::vector<int> order(count);
+            a.compare(b, order.data());
+            for (size_t i = 0; i < count; ++i) {
+                EXPECT_EQ(order[i], (xs[i] > ys[i]) - (xs[i] < ys[i])) << i;
+            }
+
+            BinaryArithmeticBatch sum = a, difference = a, product = a;
+            sum.add(b);
+            difference.sub(b);
+            product.mul_small(0xFEDCBA9876543210ULL);
+            for (size_t i = 0; i < count; ++i) {
+                EXPECT_EQ(sum.get(i), wrap(xs[i] + ys[i])) << i;
+                EXPECT_EQ(difference.get(i), wrap(xs[i] - ys[i])) << i;
+                EXPECT_EQ(product.get(i), wrap(xs[i] * BinaryArithmetic(0xFEDCBA9876543210ULL))) << i;
+            }
+        }
+    }
+
+    TEST(BinaryArithmeticBatchTest, RangeAndShapeChecks) {
+        const BinaryArithmetic two(2);
+        BinaryArithmeticBatch batch(3, 100);
+        EXPECT_EQ(batch.bits(), 128u);
+        EXPECT_EQ(BinaryArithmeticBatch(1, 0).bits(), 64u);
+
+        const BinaryArithmetic half = pow(two, 127);
+        EXPECT_NO_THROW(batch.set(0, half - BinaryArithmetic(1)));
+        EXPECT_NO_THROW(batch.set(1, -half));
+        EXPECT_THROW(batch.set(2, half), std::overflow_error);
+        EXPECT_THROW(batch.set(2, -half - BinaryArithmetic(1)), std::overflow_error);
+        EXPECT_THROW(batch.set(2, pow(two, 300)), std::overflow_error);
+        EXPECT_THROW(batch.set(3, BinaryArithmetic(1)), std::out_of_range);
+        EXPECT_EQ(batch.get(1), -half);
+        EXPECT_EQ(batch.get(2), BinaryArithmetic(0));
+        EXPECT_FALSE(batch.get(2).sign());
+
+        EXPECT_THROW(batch.add(BinaryArithmeticBatch(4, 128)), std::invalid_argument);
+        EXPECT_THROW(batch.sub(BinaryArithmeticBatch(3, 192)), std::invalid_argument);
+    }
+    TEST(FixedBinaryTest, ConstantEvaluation) {
+        using F = FixedBinary<128>;
+        static_assert(F(-7) * F(3) == F(-21));
+        static_assert(F(-7) / F(2) == F(-3) && F(-7) % F(2) == F(-1));
+        static_assert(F::max() + F(1) == F::min());
+        static_assert(F::min().bit_length() == 128 && F(255).bit_length() == 8);
+        static_assert(abs(F(-5)) == F(5) && -F(5) < F(4));
+        // Произведение переходит во второе слово и обратно делится без остатка
+        constexpr F big = F(0x123456789ABCDEFLL) * F(0x7EDCBA987654321LL);
+        static_assert(big / F(0x7EDCBA987654321LL) == F(0x123456789ABCDEFLL) && big % F(0x7EDCBA987654321LL) == F(0));
+        static_assert(static_cast<int64_t>(F(-1)) == -1 && static_cast<uint8_t>(F(0x1FF)) == 0xFF);
+
+        // Переносимое деление 128/64 совпадает с аппаратным
+        uint64_t seed = 7;
+        for (int i = 0; i < 1000; ++i) {
+            next_random(seed);
+            const uint64_t divisor = (seed >> (i % 64)) | 1;
+            const uint64_t high = seed % divisor;
+            const uint64_t low = seed * 0x9E3779B97F4A7C15ULL;
+            uint64_t expected_rem = 0, rem = 0;
+            const uint64_t expected = impl::OverflowAwareOps::divide(high, low, divisor, expected_rem);
+            EXPECT_EQ(impl::OverflowAwareOps::divide_halves(high, low, divisor, rem), expected);
+            EXPECT_EQ(rem, expected_rem);
+        }
+    }
+
+    TEST(FixedBinaryTest, MatchesWrappedDynamicArithmetic) {
+        const BinaryArithmetic two(2);
+        const auto check = [&](auto tag) {
+            using F = decltype(tag);
+            constexpr size_t bits = F::LIMBS * 64;
+            const BinaryArithmetic modulus = pow(two, bits);
+            const BinaryArithmetic half = pow(two, bits - 1);
+            const auto wrap = [&](BinaryArithmetic v) {
+                v = v % modulus;
+                if (v < BinaryArithmetic(0)) v += modulus;
+                if (v >= half) v -= modulus;
+                return v;
+            };
+
+            uint64_t seed = bits;
+            const auto random = [&](size_t limbs) {
+                BinaryArithmetic v(0);
+                for (size_t j = 0; j < limbs; ++j) {
+                    v = v * pow(two, 64) + BinaryArithmetic(next_random(seed));
+                }
+                return wrap(seed % 3 == 0 ? -v : v);
+            };
+            std::vector<BinaryArithmetic> values = { BinaryArithmetic(0), BinaryArithmetic(1), BinaryArithmetic(-1),
+                half - BinaryArithmetic(1), -half, BinaryArithmetic(0x7FFFFFFFFFFFFFFFLL) };
+            for (size_t limbs = 1; limbs <= F::LIMBS; ++limbs) {
+                for (int i = 0; i < 4; ++i) values.push_back(random(limbs));
+            }
+
+            for (const BinaryArithmetic& x : values) {
+                const F fx(x);
+                EXPECT_EQ(static_cast<BinaryArithmetic>(fx), x);
+                EXPECT_EQ(fx.bit_length(), x.bit_length());
+                EXPECT_EQ(static_cast<BinaryArithmetic>(fx * 1000003u), wrap(x * BinaryArithmetic(1000003)));
+                EXPECT_EQ(static_cast<BinaryArithmetic>(fx - 5), wrap(x - BinaryArithmetic(5)));
+                EXPECT_EQ(static_cast<BinaryArithmetic>(fx / -7), x / BinaryArithmetic(-7));
+                EXPECT_EQ(static_cast<BinaryArithmetic>(fx % 7), x % BinaryArithmetic(7));
+                EXPECT_EQ(to_string(fx), to_string(x));
+                if (!x.sign()) {
+                    EXPECT_EQ(static_cast<BinaryArithmetic>(sqrt(fx)), sqrt(x));
+                }
+                for (const BinaryArithmetic& y : values) {
+                    const F fy(y);
+                    EXPECT_EQ(fx.compare(fy), x.compare(y));
+                    EXPECT_EQ(static_cast<BinaryArithmetic>(fx + fy), wrap(x + y));
+                    EXPECT_EQ(static_cast<BinaryArithmetic>(fx - fy), wrap(x - y));
+                    EXPECT_EQ(static_cast<BinaryArithmetic>(fx * fy), wrap(x * y));
+                    if (y != BinaryArithmetic(0)) {
+                        // Единственное переполнение деления: min() / -1 == min()
+                        EXPECT_EQ(static_cast<BinaryArithmetic>(fx / fy), wrap(x / y));
+                        EXPECT_EQ(static_cast<BinaryArithmetic>(fx % fy), x % y);
+                    }
+                }
+            }
+
+            EXPECT_THROW(F{ half }, std::overflow_error);
+            EXPECT_THROW(F(-half - BinaryArithmetic(1)), std::overflow_error);
+            EXPECT_THROW(F{ modulus }, std::overflow_error);
+            EXPECT_THROW(F(1) / F(0), std::overflow_error);
+            EXPECT_EQ(static_cast<BinaryArithmetic>(pow(F(3), 40)), wrap(pow(BinaryArithmetic(3), 40)));
+        };
+        check(FixedBinary<64>{});
+        check(FixedBinary<128>{});
+        check(FixedBinary<256>{});
+    }
+
+    TEST(FixedFactorialTest, MatchesReducedDynamicArithmetic) {
+        // Модуль берётся по модулю (MaxIndex + 1)!, знак сохраняется
+        const auto check = [](auto tag) {
+            using F = decltype(tag);
+            const BinaryArithmetic modulus = [] {
+                BinaryArithmetic f(1);
+                for (size_t k = 2; k <= F::MAX_INDEX + 1; ++k) f *= BinaryArithmetic(k);
+                return f;
+            }();
+            const auto reduce = [&](const BinaryArithmetic& v) { return v % modulus; };
+            const auto to_fixed = [](const BinaryArithmetic& v) { return F(FactorialArithmetic(to_string(v))); };
+            const auto to_binary = [](const F& v) { return BinaryArithmetic(to_string(v)); };
+
+            uint64_t seed = F::MAX_INDEX;
+            std::vector<BinaryArithmetic> values = { BinaryArithmetic(0), BinaryArithmetic(1), BinaryArithmetic(-1),
+                modulus - BinaryArithmetic(1), -(modulus - BinaryArithmetic(1)) };
+            for (int i = 0; i < 12; ++i) {
+                BinaryArithmetic v(0);
+                for (int j = 0; j < 3; ++j) {
+                    v = v * BinaryArithmetic(1ULL << 32) + BinaryArithmetic(next_random(seed) >> 32);
+                }
+                values.push_back(reduce(i % 3 == 0 ? -v : v));
+            }
+
+            for (const BinaryArithmetic& x : values) {
+                const F fx = to_fixed(x);
+                EXPECT_EQ(to_binary(fx), x);
+                EXPECT_EQ(fx.bit_length(), x.bit_length());
+                EXPECT_EQ(to_binary(fx * 0xFEDCBA9876543210ULL), reduce(x * BinaryArithmetic(0xFEDCBA9876543210ULL)));
+                EXPECT_EQ(to_binary(fx + 12345), reduce(x + BinaryArithmetic(12345)));
+                EXPECT_EQ(to_binary(fx / -1000000007LL), x / BinaryArithmetic(-1000000007LL));
+                EXPECT_EQ(to_binary(fx % 1000000007), x % BinaryArithmetic(1000000007));
+                for (const BinaryArithmetic& y : values) {
+                    const F fy = to_fixed(y);
+                    EXPECT_EQ(fx.compare(fy), x.compare(y));
+                    EXPECT_EQ(to_binary(fx + fy), reduce(x + y));
+                    EXPECT_EQ(to_binary(fx - fy), reduce(x - y));
+                    EXPECT_EQ(to_binary(fx * fy), reduce(x * y));
+                    if (y != BinaryArithmetic(0)) {
+                        EXPECT_EQ(to_binary(fx / fy), x / y);
+                        EXPECT_EQ(to_binary(fx % fy), x % y);
+                    }
+                }
+            }
+            EXPECT_THROW(to_fixed(modulus), std::overflow_error);
+        };
+        check(FixedFactorial<20>{});
+        check(FixedFactorial<34>{});
+        check(FixedFactorial<300>{});
+
+        using F = FixedFactorial<5>;
+        static_assert(F(719) + F(1) == F(0) && F(-100) * F(-3) == F(300));
+        static_assert(F(100).digit(4) == 4 && F(100).digit(2) == 2 && F(100).digit(1) == 0);
+        static_assert(static_cast<int>(F(-123) / F(10)) == -12 && static_cast<int>(F(-123) % F(10)) == -3);
+        EXPECT_EQ(iroot(F(125), 3), F(5));
+        EXPECT_EQ(to_string(F(-719)), "-719");
+    }
+    TEST(FixedLiteralTest, CompileTimeConstants) {
+        using namespace numsystem::literals;
+        // Литерал разбирается при компиляции, тип — минимальной достаточной ширины
+        constexpr auto prime = 170141183460469231731687303715884105727_bi;   // 2^127 - 1
+        static_assert(std::is_same_v<std::decay_t<decltype(prime)>, FixedBinary<128>>);
+        static_assert(prime == FixedBinary<128>::max());
+        static_assert(std::is_same_v<std::decay_t<decltype(0_bi)>, FixedBinary<64>>);
+        static_assert(0xFFFF'FFFF'FFFF'FFFF_bi == FixedBinary<128>(1) * 0x10000 * 0x10000 * 0x10000 * 0x10000 - 1);
+        static_assert(0b1010_bi == 10_bi && 017_bi == 15_bi);
+        static_assert(-9223372036854775808_bi == FixedBinary<128>(INT64_MIN));
+
+        // Арифметика, корни и степени со скалярами тоже вычисляются при компиляции
+        constexpr FixedBinary<256> modulus = pow(FixedBinary<256>(2), 255) - 19;
+        static_assert(modulus % 1000000007u == FixedBinary<256>("57896044618658097711785492504343953926634992332820282019728792003956564819949") % 1000000007u);
+        static_assert(sqrt(FixedBinary<256>(prime) * prime) == prime);
+        static_assert(iroot(1000000000000000000000000000000_bi, 3) == 10000000000_bi);
+        static_assert(static_cast<int64_t>((FixedBinary<128>(-17) * 3 + 1) / 5) == -10);
+
+        // Факториальные литералы: 720 = 6! требует коэффициента при 6!
+        constexpr auto six = 720_fi;
+        static_assert(std::is_same_v<std::decay_t<decltype(six)>, FixedFactorial<6>>);
+        static_assert(std::is_same_v<std::decay_t<decltype(719_fi)>, FixedFactorial<5>>);
+        static_assert(six.digit(6) == 1 && FixedFactorial<10>(719_fi) + 1 == FixedFactorial<10>(six));
+        static_assert(FixedFactorial<20>("-2432902008176640000") == -FixedFactorial<20>(20) * 121645100408832000ULL);
+        static_assert(FixedFactorial<3>(FixedFactorial<10>(six + 5)) == FixedFactorial<3>(5));
+
+        // Преобразование в динамические типы копирует разряды без разбора строк
+        const BinaryArithmetic dynamic = prime;
+        EXPECT_EQ(dynamic, BinaryArithmetic("170141183460469231731687303715884105727"));
+        const FactorialArithmetic factorial = six;
+        EXPECT_EQ(factorial, FactorialArithmetic(720));
+        EXPECT_EQ(FixedBinary<64>(prime.limbs()[0] & 0x7F), FixedBinary<64>(0x7F));
+        EXPECT_EQ(FixedBinary<64>(FixedBinary<128>(prime)), FixedBinary<64>(-1));
+
+        EXPECT_THROW(FixedBinary<64>("9223372036854775808"), std::overflow_error);
+        EXPECT_THROW(FixedBinary<64>("12a"), std::invalid_argument);
+        EXPECT_THROW(FixedFactorial<4>("120"), std::overflow_error);
+        EXPECT_EQ(FixedBinary<64>("-9223372036854775808"), FixedBinary<64>::min());
+    }
+    TEST(BulkConstructionTest, LimbsRoundTrip) {
+        const BinaryArithmetic x("-123456789012345678901234567890123456789012345678901234567890");
+        const ConstSpan<uint64_t> limbs = x.limbs();
+        EXPECT_EQ(limbs.size(), 4u);
+        EXPECT_EQ(BinaryArithmetic::from_limbs(limbs, true), x);
+        EXPECT_EQ(BinaryArithmetic::from_limbs({ limbs.data(), limbs.size() }), abs(x));
+
+        // Ведущие нулевые слова отбрасываются, ноль не бывает отрицательным
+        const std::vector<uint64_t> padded = { 5, 0, 1, 0, 0 };
+        const BinaryArithmetic y = BinaryArithmetic::from_limbs(padded);
+        EXPECT_EQ(y, (BinaryArithmetic(1) << 128) + 5);
+        EXPECT_EQ(y.limbs().size(), 3u);
+        const uint64_t zeros[] = { 0, 0 };
+        EXPECT_EQ(BinaryArithmetic::from_limbs(zeros, true), BinaryArithmetic(0));
+        EXPECT_FALSE(BinaryArithmetic::from_limbs(zeros, true).sign());
+        EXPECT_TRUE(BinaryArithmetic::from_limbs({}).limbs().empty());
+        EXPECT_TRUE(BinaryArithmetic(0).limbs().empty());
+
+        const std::vector<uint8_t> bytes = { 0x01, 0x02 };
+        EXPECT_EQ(BasicBinaryArithmetic<uint8_t>::from_limbs(bytes), BasicBinaryArithmetic<uint8_t>(0x0201));
+    }
+
+    TEST(BulkConstructionTest, CoefficientsRoundTrip) {
+        // 4 = 2 * 2!, 23 = 3 * 3! + 2 * 2! + 1 * 1!
+        const std::vector<uint64_t> four = { 0, 0, 2 };
+        EXPECT_EQ(FactorialArithmetic::from_coefficients(four), FactorialArithmetic(4));
+        EXPECT_EQ(std::vector<uint64_t>(FactorialArithmetic(23).coefficients().begin(), FactorialArithmetic(23).coefficients().end()),
+            (std::vector<uint64_t>{ 0, 1, 2, 3 }));
+        EXPECT_TRUE(FactorialArithmetic(0).coefficients().empty());
+
+        // Большое число: коэффициенты через представление и обратно, с пересечением границ слов
+        const FactorialArithmetic x("-98765432109876543210987654321098765432109876543210987654321098765432109876543210");
+        const CoefficientView view = x.coefficients();
+        std::vector<uint64_t> digits;
+        for (uint64_t d : view) digits.push_back(d);
+        ASSERT_EQ(digits.size(), view.size());
+        for (size_t k = 0; k < digits.size(); ++k) {
+            EXPECT_LE(digits[k], k);
+            EXPECT_EQ(view[k], digits[k]);
+        }
+        EXPECT_EQ(FactorialArithmetic::from_coefficients(digits, true), x);
+        digits.resize(digits.size() + 70, 0);
+        EXPECT_EQ(FactorialArithmetic::from_coefficients(digits), abs(x));
+
+        // Максимальные коэффициенты: sum(k * k!) = n! - 1
+        std::vector<uint64_t> top(200);
+        for (size_t k = 0; k < top.size(); ++k) top[k] = k;
+        FactorialArithmetic factorial(1);
+        for (size_t i = 2; i <= top.size(); ++i) factorial *= i;
+        EXPECT_EQ(FactorialArithmetic::from_coefficients(top), factorial - 1);
+
+        EXPECT_EQ(FactorialArithmetic::from_coefficients({}), FactorialArithmetic(0));
+        EXPECT_THROW((void)FactorialArithmetic::from_coefficients(std::vector<uint64_t>{ 1 }), std::invalid_argument);
+        EXPECT_THROW((void)FactorialArithmetic::from_coefficients(std::vector<uint64_t>{ 0, 1, 3 }), std::invalid_argument);
+    }
+
+    TEST(RadixConversionTest, FactorialAndBinaryRoundTrip) {
+        // Десятичные строки разной длины: базовый случай и «разделяй и властвуй» по произведениям оснований
+        uint64_t state = 0x2545F4914F6CDD1DULL;
+        for (size_t length : { 1, 19, 20, 45, 700, 3000, 12000 }) {
+            std::string digits = random_digits(length, state);
+            if (digits.size() > 1 && digits.front() == '0') digits.front() = '7';
+            for (const std::string& text : { digits, "-" + digits }) {
+                const BinaryArithmetic binary(text);
+                const FactorialArithmetic factorial(text);
+                EXPECT_EQ(factorial.to_binary(), binary) << length;
+                EXPECT_EQ(FactorialArithmetic::from_binary(binary), factorial) << length;
+                EXPECT_EQ(to_string(factorial), to_string(binary)) << length;
+            }
+        }
+
+        // n! - 1 — все коэффициенты максимальны, n! — единственный коэффициент
+        BinaryArithmetic factorial(1);
+        for (uint64_t i = 2; i <= 1500; ++i) factorial *= i;
+        const FactorialArithmetic top = FactorialArithmetic::from_binary(factorial - 1);
+        EXPECT_EQ(top.coefficients().size(), 1500u);
+        EXPECT_EQ(top.coefficient(1499), 1499u);
+        EXPECT_EQ(top.coefficient(2), 2u);
+        EXPECT_EQ(top.to_binary(), factorial - 1);
+        const FactorialArithmetic exact = FactorialArithmetic::from_binary(factorial);
+        EXPECT_EQ(exact.coefficients().size(), 1501u);
+        EXPECT_EQ(exact.coefficient(1500), 1u);
+        EXPECT_EQ(exact.to_binary(), factorial);
+
+        EXPECT_EQ(FactorialArithmetic(0).to_binary(), BinaryArithmetic(0));
+        EXPECT_EQ(FactorialArithmetic::from_binary(BinaryArithmetic(0)), FactorialArithmetic(0));
+        EXPECT_FALSE(FactorialArithmetic::from_binary(-BinaryArithmetic(0)).sign());
+    }
+
+    TEST(TablesTest, FactorialMatchesProductLoop) {
+        BinaryArithmetic expected(1);
+        uint64_t done = 0;
+        for (uint64_t n : { 0, 1, 2, 20, 63, 64, 65, 128, 200, 1000, 4097 }) {
+            for (; done < n; ++done) expected *= done + 1;
+            EXPECT_EQ(numsystem::factorial(n), expected) << n;
+        }
+        // n! в факториальной системе — единственный коэффициент при n!
+        const FactorialArithmetic exact = FactorialArithmetic::from_binary(numsystem::factorial(4097));
+        EXPECT_EQ(exact.coefficients().size(), 4098u);
+        EXPECT_EQ(exact.coefficient(4097), 1u);
+    }
+
+    TEST(TablesTest, ConcurrentGrowthAndPreload) {
+        // Индексы и длины больше, чем в остальных тестах: таблицы растут одновременно из нескольких потоков
+        constexpr uint64_t N = 12000;
+        BinaryArithmetic expected(1);
+        for (uint64_t k = 2; k <= N; ++k) expected *= k;
+        const std::string text = to_string(expected);
+        const BinaryArithmetic value = expected - 1;
+
+        std::vector<std::thread> threads;
+        std::atomic<int> mismatches{ 0 };
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t] {
+                if (t % 2 == 0 && numsystem::factorial(N) != expected) ++mismatches;
+                const FactorialArithmetic converted = FactorialArithmetic::from_binary(value);
+                if (converted.coefficient(N - 1) != N - 1 || converted.to_binary() != value) ++mismatches;
+                if (to_string(expected) != text || BinaryArithmetic(text) != expected) ++mismatches;
+            });
+        }
+        for (std::thread& thread : threads) thread.join();
+        EXPECT_EQ(mismatches.load(), 0);
+
+        // Прогрев не меняет результатов и допускает повторный вызов
+        preload_factorial_tables(2 * N);
+        preload_decimal_tables(text.size());
+        preload_factorial_tables(0);
+        preload_decimal_tables(0);
+        EXPECT_EQ(numsystem::factorial(2 * N) / numsystem::factorial(N - 1), numsystem::factorial(2 * N) / expected * N);
+        EXPECT_EQ(to_string(expected), text);
+        EXPECT_EQ(FactorialArithmetic::from_binary(value).to_binary(), value);
+    }
+
+    TEST(DecimalStreamTest, WriterMatchesToString) {
+        // Приёмник собирает куски и запоминает последний отчёт о прогрессе
+        struct Collector : DecimalSink {
+            std::string text;
+            uint64_t reported = 0;
+            size_t pieces = 0;
+            void write(std::string_view digits) override { text.append(digits); ++pieces; }
+            void progress(uint64_t written) override { reported = written; }
+        };
+
+        // 10^k — длинные серии нулей в младших половинах, 10^k - 1 — одни девятки
+        BinaryArithmetic power(1);
+        for (int i = 0; i < 3000; ++i) power *= 10;
+        BinaryArithmetic mixed(1);
+        for (uint64_t k = 2; k <= 2500; ++k) mixed *= k;
+        for (const BinaryArithmetic& value : { BinaryArithmetic(0), BinaryArithmetic(-42), power, power - 1, -mixed, mixed + 1 }) {
+            Collector sink;
+            const uint64_t written = write_decimal(value, sink);
+            EXPECT_EQ(sink.text, to_string(value));
+            EXPECT_EQ(written, sink.text.size());
+            EXPECT_EQ(sink.reported, sink.text.size());
+            std::ostringstream out;
+            EXPECT_EQ(write_decimal(value, out), sink.text.size());
+            EXPECT_EQ(out.str(), sink.text);
+        }
+        Collector sink;
+        write_decimal(FactorialArithmetic::from_binary(mixed), sink);
+        EXPECT_EQ(sink.text, to_string(mixed));
+        EXPECT_GT(sink.pieces, 1u);
+    }
+
+    TEST(DecimalStreamTest, ParserAcceptsArbitraryPieces) {
+        // Больше двух блоков разбора: склейка кусков и неполный последний блок
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        const std::string digits = "8" + random_digits(3 * DecimalParser::BLOCK_DIGITS + 1233, state);
+        const BinaryArithmetic expected(digits);
+        for (size_t step : { size_t(1) << 20, size_t(4099), size_t(7) }) {
+            DecimalParser parser;
+            parser.feed("-");
+            for (size_t pos = 0; pos < digits.size(); pos += step) {
+                parser.feed(std::string_view(digits).substr(pos, step));
+                EXPECT_EQ(parser.digits(), std::min(digits.size(), pos + step));
+            }
+            EXPECT_EQ(parser.finish(), -expected) << step;
+            // После finish разбор начинается заново
+            parser.feed("0");
+            EXPECT_EQ(parser.finish(), BinaryArithmetic(0));
+        }
+
+        std::istringstream in("  " + digits + " 17");
+        EXPECT_EQ(read_decimal(in), expected);
+        EXPECT_EQ(read_decimal(in), BinaryArithmetic(17));
+        EXPECT_TRUE(in.eof());
+
+        DecimalParser parser;
+        EXPECT_THROW(parser.finish(), std::invalid_argument);
+        EXPECT_THROW(DecimalParser().feed("12a"), std::invalid_argument);
+        EXPECT_THROW(DecimalParser().feed("1-2"), std::invalid_argument);
+        EXPECT_THROW(DecimalParser().feed("007"), std::invalid_argument);
+        DecimalParser split;
+        split.feed("0");
+        EXPECT_THROW(split.feed("7"), std::invalid_argument);
+        std::istringstream empty("  x");
+        EXPECT_THROW((void)read_decimal(empty), std::invalid_argument);
+        EXPECT_TRUE(empty.fail());
+    }
+
+    TEST(PermutationTest, RankAndUnrankMatchLexicographicOrder) {
+        // Все перестановки 0..5 по порядку next_permutation имеют номера 0..719
+        std::vector<size_t> perm = { 0, 1, 2, 3, 4, 5 };
+        uint64_t expected = 0;
+        do {
+            const FactorialArithmetic rank = rank_permutation(perm);
+            EXPECT_EQ(static_cast<uint64_t>(rank), expected);
+            EXPECT_EQ(unrank_permutation(rank, perm.size()), perm);
+            ++expected;
+        } while (std::next_permutation(perm.begin(), perm.end()));
+        EXPECT_EQ(expected, 720u);
+
+        // Коэффициенты номера — код Лемера: [2, 0, 1] -> 2 * 2! + 0 * 1!
+        const FactorialArithmetic rank = rank_permutation({ 2, 0, 1 });
+        EXPECT_EQ(rank.coefficient(2), 2u);
+        EXPECT_EQ(rank.coefficient(1), 0u);
+        EXPECT_EQ(rank.coefficient(100), 0u);
+        EXPECT_EQ(rank, FactorialArithmetic(4));
+
+        // Большое n: обратная перестановка к 0..n-1 имеет номер n! - 1
+        const size_t n = 300;
+        std::vector<size_t> reversed(n);
+        for (size_t i = 0; i < n; ++i) reversed[i] = n - 1 - i;
+        FactorialArithmetic factorial(1);
+        for (size_t i = 2; i <= n; ++i) factorial *= i;
+        EXPECT_EQ(rank_permutation(reversed), factorial - 1);
+        EXPECT_EQ(unrank_permutation(factorial - 1, n), reversed);
+        const FactorialArithmetic middle = factorial / 3;
+        EXPECT_EQ(rank_permutation(unrank_permutation(middle, n)), middle);
+
+        EXPECT_EQ(rank_permutation(std::vector<size_t>{}), FactorialArithmetic(0));
+        EXPECT_TRUE(unrank_permutation(FactorialArithmetic(0), 0).empty());
+        EXPECT_THROW((void)rank_permutation({ 0, 2, 2 }), std::invalid_argument);
+        EXPECT_THROW((void)rank_permutation({ 0, 3, 1 }), std::invalid_argument);
+        EXPECT_THROW((void)unrank_permutation(FactorialArithmetic(6), 3), std::out_of_range);
+        EXPECT_THROW((void)unrank_permutation(FactorialArithmetic(-1), 3), std::out_of_range);
+    }
+
+    TEST(PermutationTest, EnumeratorIncrementsRankInPlace) {
+        PermutationEnumerator it(5);
+        std::vector<size_t> perm = { 0, 1, 2, 3, 4 };
+        uint64_t steps = 0;
+        do {
+            EXPECT_EQ(it.permutation(), perm);
+            EXPECT_EQ(static_cast<uint64_t>(it.rank()), steps);
+            EXPECT_EQ(it.rank(), rank_permutation(perm));
+            ++steps;
+            std::next_permutation(perm.begin(), perm.end());
+        } while (it.next());
+        EXPECT_EQ(steps, 120u);
+        EXPECT_FALSE(it.next());
+        EXPECT_EQ(it.rank(), FactorialArithmetic(119));
+
+        // Старт с произвольного номера и переход через перенос по нескольким коэффициентам
+        PermutationEnumerator from(7, FactorialArithmetic(5 * 720 + 719));
+        ASSERT_TRUE(from.next());
+        EXPECT_EQ(from.rank(), FactorialArithmetic(6 * 720));
+        EXPECT_EQ(from.permutation(), (std::vector<size_t>{ 6, 0, 1, 2, 3, 4, 5 }));
+        EXPECT_FALSE(PermutationEnumerator(1).next());
+        EXPECT_FALSE(PermutationEnumerator(0).next());
+    }
+
+    TEST(SerializationTest, RoundTripsBothRepresentations) {
+        const BinaryArithmetic two(2);
+        const std::vector<BinaryArithmetic> binaries = { BinaryArithmetic(0), BinaryArithmetic(-1), BinaryArithmetic("18446744073709551616"),
+            -pow(two, 1000) + BinaryArithmetic(12345), pow(BinaryArithmetic(3), 500) };
+        const std::vector<FactorialArithmetic> factorials = { FactorialArithmetic(0), FactorialArithmetic(-5),
+            FactorialArithmetic("-123456789012345678901234567890"), FactorialArithmetic(to_string(pow(BinaryArithmetic(7), 300)).c_str()) };
+
+        // Все записи подряд в одном буфере: каждая читается со смещения, которое вернула предыдущая
+        size_t total = 0;
+        for (const auto& value : binaries) total += serialized_size(value);
+        for (const auto& value : factorials) total += serialized_size(value);
+        std::vector<uint64_t> storage(total / sizeof(uint64_t));
+        std::byte* buffer = reinterpret_cast<std::byte*>(storage.data());
+
+        size_t offset = 0;
+        for (const auto& value : binaries) offset += serialize_to(value, buffer + offset, total - offset);
+        for (const auto& value : factorials) offset += serialize_to(value, buffer + offset, total - offset);
+        EXPECT_EQ(offset, total);
+
+        offset = 0;
+        for (const auto& value : binaries) {
+            size_t consumed = 0;
+            const BinaryArithmeticView view = BinaryArithmeticView::from_bytes(buffer + offset, total - offset, &consumed);
+            EXPECT_EQ(to_string(view), to_string(value));
+            EXPECT_EQ(view.bit_length(), value.bit_length());
+            BinaryArithmetic copy(7);
+            EXPECT_EQ(deserialize(buffer + offset, total - offset, copy), consumed);
+            EXPECT_EQ(copy, value);
+            EXPECT_EQ(copy.sign(), value.sign());
+            offset += consumed;
+        }
+        for (const auto& value : factorials) {
+            FactorialArithmetic copy(7);
+            offset += deserialize(buffer + offset, total - offset, copy);
+            EXPECT_EQ(copy, value);
+            EXPECT_EQ(to_string(copy), to_string(value));
+        }
+        EXPECT_EQ(offset, total);
+    }
+    TEST(SerializationTest, RejectsMalformedRecords) {
+        const BinaryArithmetic value = -pow(BinaryArithmetic(2), 70);
+        std::vector<uint64_t> storage(serialized_size(value) / sizeof(uint64_t));
+        std::byte* buffer = reinterpret_cast<std::byte*>(storage.data());
+        const size_t size = storage.size() * sizeof(uint64_t);
+        EXPECT_THROW(serialize_to(value, buffer, size - 1), std::length_error);
+        ASSERT_EQ(serialize_to(value, buffer, size), size);
+
+        BinaryArithmetic binary;
+        FactorialArithmetic factorial;
+        EXPECT_THROW(deserialize(buffer, size - 8, binary), std::invalid_argument);
+        EXPECT_THROW(deserialize(buffer, size, factorial), std::invalid_argument);
+        std::vector<uint64_t> corrupt = storage;
+        reinterpret_cast<std::byte*>(corrupt.data())[0] = std::byte{ 'X' };
+        EXPECT_THROW(deserialize(reinterpret_cast<std::byte*>(corrupt.data()), size, binary), std::invalid_argument);
+        corrupt = storage;
+        corrupt.back() = 0;     // ведущее нулевое слово
+        EXPECT_THROW(deserialize(reinterpret_cast<std::byte*>(corrupt.data()), size, binary), std::invalid_argument);
+        // Смещённая на байт запись читается копированием, но не просматривается на месте
+        std::vector<uint64_t> shifted(storage.size() + 1);
+        std::byte* unaligned = reinterpret_cast<std::byte*>(shifted.data()) + 1;
+        std::copy(buffer, buffer + size, unaligned);
+        EXPECT_EQ(deserialize(unaligned, size, binary), size);
+        EXPECT_EQ(binary, value);
+        EXPECT_THROW(BinaryArithmeticView::from_bytes(unaligned, size), std::invalid_argument);
+
+        // 4 = 2·2!: коэффициент при 2! занимает биты 1-2 и не может превышать 2
+        const FactorialArithmetic four(4);
+        std::vector<uint64_t> record(serialized_size(four) / sizeof(uint64_t));
+        std::byte* bytes = reinterpret_cast<std::byte*>(record.data());
+        const size_t record_size = record.size() * sizeof(uint64_t);
+        serialize_to(four, bytes, record_size);
+        EXPECT_EQ(deserialize(bytes, record_size, factorial), record_size);
+        EXPECT_EQ(factorial, four);
+        record.back() = 0b110;  // d_2 = 3
+        EXPECT_THROW(deserialize(bytes, record_size, factorial), std::invalid_argument);
+        record.back() = 0b1100; // d_3 = 1 при записанном старшем индексе 2
+        EXPECT_THROW(deserialize(bytes, record_size, factorial), std::invalid_argument);
+        EXPECT_EQ(factorial, four);
+    }
+    TEST(BinaryArithmeticViewTest, MatchesOwningArithmetic) {
+        const BinaryArithmetic two(2);
+        const std::vector<BinaryArithmetic> values = { BinaryArithmetic(0), BinaryArithmetic(5), BinaryArithmetic(-5),
+            pow(two, 64) - BinaryArithmetic(1), -pow(two, 200) + BinaryArithmetic(99), pow(BinaryArithmetic(3), 150) };
+        for (const BinaryArithmetic& a : values) {
+            const BinaryArithmeticView x(a);
+            EXPECT_EQ(static_cast<BinaryArithmetic>(x), a);
+            EXPECT_EQ(x.mod_small(1000003), (a < BinaryArithmetic(0) ? -a : a) % BinaryArithmetic(1000003));
+            for (const BinaryArithmetic& b : values) {
+                const BinaryArithmeticView y(b);
+                EXPECT_EQ(x < y, a < b);
+                EXPECT_EQ(x == y, a == b);
+                EXPECT_EQ(x + y, a + b);
+                EXPECT_EQ(x - y, a - b);
+                EXPECT_EQ(x * y, a * b);
+                if (b == BinaryArithmetic(0)) {
+                    EXPECT_THROW(x / y, std::overflow_error);
+                    continue;
+                }
+                EXPECT_EQ(x / y, a / b);
+                EXPECT_EQ(x % y, a % b);
+            }
+        }
+        // Представление над чужим массивом: ведущие нули отбрасываются, у нуля нет знака
+        const uint64_t words[] = { 7, 1, 0, 0 };
+        EXPECT_EQ(BinaryArithmeticView(words, 4, true).size(), 2u);
+        EXPECT_EQ(static_cast<BinaryArithmetic>(BinaryArithmeticView(words, 4, true)), -(pow(two, 64) + BinaryArithmetic(7)));
+        EXPECT_FALSE(BinaryArithmeticView(words + 2, 2, true).sign());
+    }
+    TEST(InstrumentationTest, CountsOperationsAndTiers) {
+        const BinaryArithmetic a = (BinaryArithmetic(1) << (64 * 100)) + BinaryArithmetic(12345);     // 101 слово
+        const BinaryArithmetic b = (BinaryArithmetic(1) << (64 * 90)) - BinaryArithmetic(1);
+        reset_instrumentation();
+        const BinaryArithmetic product = a * b;
+        const std::string digits = to_string(product);
+        const FactorialArithmetic f(digits);
+        EXPECT_EQ(to_string(f), digits);
+        const InstrumentationSnapshot snapshot = instrumentation_snapshot();
+
+        if (!instrumentation_enabled()) {
+            EXPECT_EQ(snapshot.total(Operation::Multiply), 0u);
+            EXPECT_EQ(snapshot.count(Algorithm::MulKaratsuba), 0u);
+            EXPECT_EQ(snapshot.reallocations, 0u);
+            return;
+        }
+        EXPECT_EQ(snapshot.total(Operation::Multiply), 1u);
+        EXPECT_EQ(snapshot.operations[static_cast<size_t>(Operation::Multiply)][impl::size_bucket(101)], 1u);
+        EXPECT_EQ(impl::size_bucket(101), 7u);
+        EXPECT_EQ(snapshot.total(Operation::Format), 2u);
+        EXPECT_EQ(snapshot.total(Operation::Parse), 1u);
+        EXPECT_EQ(snapshot.total(Operation::FactorialToBinary), 1u);
+        EXPECT_EQ(snapshot.total(Operation::BinaryToFactorial), 1u);
+        EXPECT_GT(snapshot.total(Operation::Trim), 0u);
+        // 90 слов: Карацуба на верхнем уровне, «столбик» в рекурсии; вывод и разбор — делением пополам
+        EXPECT_GE(snapshot.count(Algorithm::MulKaratsuba), 1u);
+        EXPECT_GE(snapshot.count(Algorithm::MulBasecase), 3u);
+        EXPECT_GE(snapshot.count(Algorithm::FormatDivideConquer), 1u);
+        EXPECT_GE(snapshot.count(Algorithm::ParseDivideConquer), 1u);
+        EXPECT_GT(snapshot.reallocations, 0u);
+        EXPECT_GE(snapshot.bytes_allocated, 191u * sizeof(uint64_t));
+
+        reset_instrumentation();
+        EXPECT_EQ(instrumentation_snapshot().total(Operation::Multiply), 0u);
+    }
+    TEST(InstrumentationTest, TraceHookReceivesOperations) {
+        struct Trace {
+            std::vector<std::pair<Operation, size_t>> calls;
+        } trace;
+        set_trace_hook([](void* context, Operation operation, size_t limbs, std::chrono::nanoseconds duration) {
+            EXPECT_GE(duration.count(), 0);
+            static_cast<Trace*>(context)->calls.emplace_back(operation, limbs);
+        }, &trace);
+        const BinaryArithmetic a = BinaryArithmetic(1) << 200;
+        const BinaryArithmetic q = a / BinaryArithmetic(3);
+        set_trace_hook(nullptr);
+        const BinaryArithmetic untraced = q * q;
+
+        if (!instrumentation_enabled()) {
+            EXPECT_TRUE(trace.calls.empty());
+            return;
+        }
+        const auto divide = std::find_if(trace.calls.begin(), trace.calls.end(),
+            [](const auto& call) { return call.first == Operation::Divide; });
+        ASSERT_NE(divide, trace.calls.end());
+        EXPECT_EQ(divide->second, 4u);
+        EXPECT_TRUE(std::none_of(trace.calls.begin(), trace.calls.end(),
+            [](const auto& call) { return call.first == Operation::Multiply; }));
+    }
+    TEST(CpuDispatchTest, KernelSetsMatchPortable) {
+        using LO = impl::LimbOperations;
+        const KernelSet initial = active_kernel_set();
+        ASSERT_TRUE(kernel_set_supported(initial));
+
+        // Каждое третье слово — все единицы, чтобы переносы шли цепочкой
+        uint64_t seed = 1;
+        const auto words = [&](size_t count) {
+            std::vector<uint64_t> v(count);
+            for (uint64_t& w : v) {
+                const uint64_t r = next_random(seed);
+                w = r % 3 == 0 ? ~uint64_t(0) : r;
+            }
+            return v;
+        };
+        struct Results {
+            std::vector<std::vector<uint64_t>> limbs;
+            std::vector<uint64_t> carries;
+            std::string product;
+            bool operator==(const Results& other) const { return limbs == other.limbs && carries == other.carries && product == other.product; }
+        };
+        const auto run = [&](KernelSet set) {
+            EXPECT_TRUE(select_kernel_set(set));
+            EXPECT_EQ(active_kernel_set(), set);
+            seed = 1;
+            Results out;
+            for (size_t n : { 1, 3, 4, 5, 7, 8, 9, 16, 33, 100 }) {
+                const std::vector<uint64_t> a = words(n), b = words(n), c = words(n);
+                const uint64_t m = words(1)[0];
+                std::vector<uint64_t> r(n);
+                out.carries.push_back(LO::add_n(r.data(), a.data(), b.data(), n));
+                out.limbs.push_back(r);
+                out.carries.push_back(LO::sub_n(r.data(), a.data(), b.data(), n));
+                out.limbs.push_back(r);
+                out.carries.push_back(LO::mul_1(r.data(), a.data(), n, m));
+                out.limbs.push_back(r);
+                r = c;
+                out.carries.push_back(LO::addmul_1(r.data(), a.data(), n, m));
+                out.limbs.push_back(r);
+                r = c;
+                out.carries.push_back(LO::submul_1(r.data(), a.data(), n, m));
+                out.limbs.push_back(r);
+                // Результат на месте входа
+                r = a;
+                out.carries.push_back(LO::add_n(r.data(), r.data(), b.data(), n));
+                out.limbs.push_back(r);
+            }
+            // Все уровни умножения и деления поверх ядер
+            const BinaryArithmetic x = BinaryArithmetic::from_limbs(words(1500)), y = BinaryArithmetic::from_limbs(words(600));
+            out.product = to_string(x * y - x / y + (x % y));
+            return out;
+        };
+
+        const Results portable = run(KernelSet::Portable);
+        for (size_t i = 0; i < size_t(KernelSet::Count); ++i) {
+            const KernelSet set = KernelSet(i);
+            if (set == KernelSet::Portable || !kernel_set_supported(set)) continue;
+            EXPECT_TRUE(run(set) == portable) << kernel_set_name(set);
+        }
+        EXPECT_TRUE(select_kernel_set(initial));
+    }
+
+    TEST(CpuDispatchTest, QueryAndSelection) {
+        const KernelSet initial = active_kernel_set();
+        EXPECT_TRUE(kernel_set_supported(KernelSet::Portable));
+        EXPECT_FALSE(kernel_set_supported(KernelSet::Count));
+        // Неподдерживаемый набор не меняет текущий
+        EXPECT_FALSE(select_kernel_set(KernelSet::Count));
+        EXPECT_EQ(active_kernel_set(), initial);
+        EXPECT_STREQ(kernel_set_name(KernelSet::Portable), "portable");
+        EXPECT_STRNE(kernel_set_name(KernelSet::Int128), kernel_set_name(KernelSet::X86Bmi2));
+
+        // Константное вычисление всегда идёт переносимыми циклами
+        constexpr auto sum = [] {
+            std::array<uint64_t, 6> a{ ~uint64_t(0), ~uint64_t(0), ~uint64_t(0), ~uint64_t(0), ~uint64_t(0), 0 }, one{ 1 }, r{};
+            impl::LimbOperations::add_n(r.data(), a.data(), one.data(), r.size());
+            return r;
+        }();
+        static_assert(sum[4] == 0 && sum[5] == 1, "carry must run through all limbs");
+    }
 }
@@ -1,4 +1,5 @@
 import os
+import sys
 import json
 import argparse
 import re
@@ -7,8 +8,11 @@ import matplotlib.pyplot as plt
 def parse_args():
     """
     Разбираем аргументы командной строки:
-      1) --input  : путь к rbenchmark.json
-      2) --output : путь к папке, куда сохранять графики
+      1) --input     : путь к rbenchmark.json
+      2) --output    : путь к папке, куда сохранять графики
+      3) --baseline  : (необязательно) rbenchmark.json базового прогона для сравнения
+      4) --threshold : относительный рост времени, начиная с которого замер считается регрессией
+      5) --fail-on-regression : завершаться с кодом 1, если найдены регрессии
     Если папки output нет – создаём её.
     """
     parser = argparse.ArgumentParser(
@@ -26,26 +30,42 @@ def parse_args():
         required=True,
         help="Путь к директории для сохранения графиков"
     )
+    parser.add_argument(
+        "--baseline",
+        "-b",
+        help="Путь к rbenchmark.json базового прогона (например, предыдущего коммита)"
+    )
+    parser.add_argument(
+        "--threshold",
+        "-t",
+        type=float,
+        default=0.10,
+        help="Допустимый относительный рост real_time (по умолчанию 0.10 = 10%%)"
+    )
+    parser.add_argument(
+        "--fail-on-regression",
+        action="store_true",
+        help="Вернуть код 1, если найдена хотя бы одна регрессия"
+    )
     args = parser.parse_args()
 
     # Проверка: существует ли входной JSON-файл
-    if not os.path.isfile(args.input):
-        print(f"[ERROR] File not found: {args.input}")
-        sys.exit(1)
+    for path in (args.input, args.baseline):
+        if path is not None and not os.path.isfile(path):
+            print(f"[ERROR] File not found: {path}")
+            sys.exit(1)
 
     # Если папки нет, создаём
     if not os.path.isdir(args.output):
         os.makedirs(args.output, exist_ok=True)
     return args
 
-def load_data(path):
+def load_report(path):
     """
-    Считываем JSON из файла и возвращаем список записей (benchmarks).
+    Считываем JSON из файла целиком (context и benchmarks).
     """
     with open(path, "r", encoding="utf-8") as f:
-        data = json.load(f)
-    # В формате Google Benchmark данные лежат в ключе "benchmarks"
-    return data.get("benchmarks", [])
+        return json.load(f)
 
 def extract_info(entry):
     """
@@ -148,9 +168,91 @@ def plot_operation(op_name, sys_data, output_dir):
     plt.savefig(out_path, dpi=300)
     plt.close()
 
+# Множители для приведения real_time к наносекундам
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+def index_iterations(benchmarks):
+    """
+    Словарь name -> запись только для run_type == "iteration" (без _BigO, _RMS и агрегатов).
+    """
+    return {
+        entry["name"]: entry
+        for entry in benchmarks
+        if entry.get("run_type") == "iteration" and "real_time" in entry
+    }
+
+def compare_with_baseline(current, baseline, threshold):
+    """
+    Сравниваем два прогона по одинаковым именам замеров.
+    Регрессия — рост real_time больше чем на threshold или рост числа выделений памяти на операцию.
+    Возвращаем список словарей, по одному на замер, присутствующий в обоих прогонах.
+    """
+    current_runs = index_iterations(current.get("benchmarks", []))
+    baseline_runs = index_iterations(baseline.get("benchmarks", []))
+    results = []
+    for name, entry in current_runs.items():
+        base = baseline_runs.get(name)
+        if base is None:
+            continue
+        current_time = entry["real_time"] * TIME_UNITS.get(entry.get("time_unit", "ns"), 1.0)
+        baseline_time = base["real_time"] * TIME_UNITS.get(base.get("time_unit", "ns"), 1.0)
+        ratio = current_time / baseline_time if baseline_time > 0 else float("inf")
+        current_allocs = entry.get("allocs_per_op")
+        baseline_allocs = base.get("allocs_per_op")
+
+        status = "unchanged"
+        if ratio > 1.0 + threshold:
+            status = "regression"
+        elif current_allocs is not None and baseline_allocs is not None and current_allocs > baseline_allocs:
+            status = "regression"
+        elif ratio < 1.0 - threshold:
+            status = "improvement"
+
+        results.append({
+            "name": name,
+            "baseline_time_ns": baseline_time,
+            "current_time_ns": current_time,
+            "ratio": ratio,
+            "baseline_allocs_per_op": baseline_allocs,
+            "current_allocs_per_op": current_allocs,
+            "status": status,
+        })
+    return results
+
+def write_comparison(args, current, baseline, results):
+    """
+    Сохраняем результат сравнения в f"{output_dir}/comparison.json" и печатаем регрессии.
+    Возвращаем число регрессий.
+    """
+    current_seed = current.get("context", {}).get("numsys_seed")
+    baseline_seed = baseline.get("context", {}).get("numsys_seed")
+    if current_seed != baseline_seed:
+        print(f"[WARNING] Benchmark seeds differ: baseline {baseline_seed}, current {current_seed}")
+
+    regressions = [r for r in results if r["status"] == "regression"]
+    report = {
+        "baseline": os.path.abspath(args.baseline),
+        "current": os.path.abspath(args.input),
+        "threshold": args.threshold,
+        "seed": current_seed,
+        "seed_matches": current_seed == baseline_seed,
+        "regressions": len(regressions),
+        "benchmarks": results,
+    }
+    out_path = os.path.join(args.output, "comparison.json")
+    with open(out_path, "w", encoding="utf-8") as f:
+        json.dump(report, f, indent=2, ensure_ascii=False)
+
+    for r in regressions:
+        print(f"[REGRESSION] {r['name']}: {r['baseline_time_ns']:.1f} ns -> {r['current_time_ns']:.1f} ns "
+              f"(x{r['ratio']:.2f}), allocs/op {r['baseline_allocs_per_op']} -> {r['current_allocs_per_op']}")
+    print(f"Comparison with the baseline has been saved to: {out_path} ({len(regressions)} regressions)")
+    return len(regressions)
+
 def main():
     args = parse_args()
-    benchmarks = load_data(args.input)
+    current = load_report(args.input)
+    benchmarks = current.get("benchmarks", [])
     data = collect_data(benchmarks)
 
     # Для каждой операции строим отдельный график
@@ -162,5 +264,11 @@ def main():
 
     print("Graphs have been successfully saved in the directory:", args.output)
 
+    if args.baseline is not None:
+        baseline = load_report(args.baseline)
+        regressions = write_comparison(args, current, baseline, compare_with_baseline(current, baseline, args.threshold))
+        if regressions and args.fail_on_regression:
+            sys.exit(1)
+
 if __name__ == "__main__":
     main()